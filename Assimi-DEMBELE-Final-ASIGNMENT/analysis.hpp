@@ -0,0 +1,146 @@
+/*
+ * Schedulability analysis of a periodic task set, run before any search.
+ *
+ *   utilization        U = sum(C / T)
+ *   Liu & Layland      U <= n (2^(1/n) - 1)        sufficient for RM, D = T
+ *   hyperbolic bound   prod(C / T + 1) <= 2         sufficient for RM, D = T
+ *   response times     exact fixed-priority RTA in rate-monotonic order:
+ *                      R = C_i + sum_{j higher} ceil(R / T_j) C_j
+ *   processor demand   EDF test: sum of C of the jobs with release and
+ *                      deadline in [0, t] must not exceed t, checked at
+ *                      every absolute deadline up to the usual bound L
+ *
+ * All of these are preemptive tests. A task set that fails the EDF demand
+ * test has no feasible schedule at all, preemptive or not, so the job-order
+ * search can be skipped; only the total-waiting optimisation needs it.
+ * Everything here is O(n log n) per point checked and runs in microseconds
+ * for task sets of the size used in scheduling.py.
+ */
+
+#ifndef ANALYSIS_HPP
+#define ANALYSIS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "task_set.hpp"
+
+struct Analysis {
+    double utilization = 0.0;
+    double liu_layland_bound = 0.0;
+    bool liu_layland = false;       // sufficient RM test passed
+    bool hyperbolic = false;        // sufficient RM test passed
+    std::vector<long> response;     // RM worst-case response time per task, -1 if above D
+    bool rm_feasible = false;
+    bool edf_feasible = false;
+};
+
+namespace analysis_detail {
+
+/* Exact response time of task i under the given priority order, -1 if it exceeds D. */
+inline long response_time(const std::vector<Task>& tasks, const std::vector<int>& order, std::size_t rank)
+{
+    const Task& ti = tasks[order[rank]];
+    long r = ti.C;
+    while (true) {
+        long next = ti.C;
+        for (std::size_t h = 0; h < rank; h++) {
+            const Task& tj = tasks[order[h]];
+            next += (r + tj.T - 1) / tj.T * tj.C;
+        }
+        if (next > ti.D) return -1;
+        if (next == r) return r;
+        r = next;
+    }
+}
+
+/* Processor-demand criterion, deadlines visited in increasing order with a min-heap. */
+inline bool edf_demand_ok(const std::vector<Task>& tasks, double u)
+{
+    bool implicit = true;
+    long d_max = 0;
+    double slack = 0.0;
+    for (const Task& t : tasks) {
+        implicit = implicit && t.D == t.T;
+        d_max = std::max<long>(d_max, t.D);
+        slack += (t.T - t.D) * static_cast<double>(t.C) / t.T;
+    }
+    if (u > 1.0 + 1e-12) return false;
+    if (implicit) return true;      // D = T: U <= 1 is necessary and sufficient
+
+    // Demand only needs checking up to L (or one hyperperiod when U = 1).
+    long limit;
+    if (u < 1.0 - 1e-12) {
+        limit = std::max<long>(d_max, static_cast<long>(std::ceil(slack / (1.0 - u))));
+    } else {
+        limit = hyperperiod(tasks) + d_max;
+    }
+
+    using Deadline = std::pair<long, int>;     // (absolute deadline, task)
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> heap;
+    for (int i = 0; i < static_cast<int>(tasks.size()); i++) {
+        heap.push({tasks[i].D, i});
+    }
+    long demand = 0;
+    while (!heap.empty() && heap.top().first <= limit) {
+        const long d = heap.top().first;
+        // Every job with this absolute deadline adds its C before the check.
+        while (!heap.empty() && heap.top().first == d) {
+            const int i = heap.top().second;
+            heap.pop();
+            demand += tasks[i].C;
+            heap.push({d + tasks[i].T, i});
+        }
+        if (demand > d) return false;
+    }
+    return true;
+}
+
+}  // namespace analysis_detail
+
+/* Analyse the task set, ignoring task `skip` (-1 to keep every task). */
+inline Analysis analyse(const std::vector<Task>& all_tasks, int skip = -1)
+{
+    std::vector<Task> tasks;
+    for (int i = 0; i < static_cast<int>(all_tasks.size()); i++) {
+        if (i != skip) tasks.push_back(all_tasks[i]);
+    }
+
+    Analysis a;
+    const std::size_t n = tasks.size();
+    double product = 1.0;
+    for (const Task& t : tasks) {
+        const double ui = static_cast<double>(t.C) / t.T;
+        a.utilization += ui;
+        product *= ui + 1.0;
+    }
+    a.liu_layland_bound = n == 0 ? 1.0 : n * (std::pow(2.0, 1.0 / n) - 1.0);
+
+    bool implicit = true;
+    for (const Task& t : tasks) implicit = implicit && t.D == t.T;
+    a.liu_layland = implicit && a.utilization <= a.liu_layland_bound;
+    a.hyperbolic = implicit && product <= 2.0;
+
+    // Rate-monotonic order: shorter period first, ties kept in table order.
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return tasks[x].T < tasks[y].T; });
+
+    a.response.assign(all_tasks.size(), -1);
+    a.rm_feasible = true;
+    for (std::size_t rank = 0; rank < n; rank++) {
+        const long r = analysis_detail::response_time(tasks, order, rank);
+        const int original = order[rank] + (skip >= 0 && order[rank] >= skip ? 1 : 0);
+        a.response[original] = r;
+        a.rm_feasible = a.rm_feasible && r >= 0;
+    }
+    a.edf_feasible = analysis_detail::edf_demand_ok(tasks, a.utilization);
+    return a;
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Fixed priority (Rate-Monotonic) against EDF, the two dispatch modes of
+ * periodic_task.c, simulated preemptively on the host.
+ *
+ *   1) the T1..T7 set of scheduling.py (U = 0.8375) plus an extra task of
+ *      period 30 whose C grows up to U = 1: deadline misses of each policy
+ *      over one hyperperiod;
+ *   2) random task sets (UUniFast utilizations, periods dividing 200),
+ *      grouped by utilization: share of the sets each policy schedules.
+ *
+ * Compilation : g++ -O2 -std=c++17 bench_policies.cpp -o bench_policies
+ * Utilisation : ./bench_policies [sets per utilization bin, default 2000]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "simulate.hpp"
+#include "task_set.hpp"
+
+namespace {
+
+unsigned rng_state = 2463534242u;
+
+unsigned xorshift32()
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+double uniform() { return (xorshift32() >> 8) * (1.0 / 16777216.0); }
+
+bool schedulable(const std::vector<Task>& tasks, Policy policy)
+{
+    const SimulationResult r = simulate_preemptive(tasks, hyperperiod(tasks), policy);
+    return std::accumulate(r.misses.begin(), r.misses.end(), 0L) == 0;
+}
+
+double utilization(const std::vector<Task>& tasks)
+{
+    double u = 0.0;
+    for (const Task& t : tasks) u += static_cast<double>(t.C) / t.T;
+    return u;
+}
+
+/* n tasks of total utilization close to u (UUniFast), C rounded to ticks. */
+std::vector<Task> random_task_set(int n, double u)
+{
+    static const int periods[] = {10, 20, 25, 40, 50, 100, 200};
+    std::vector<Task> tasks;
+    double remaining = u;
+    for (int i = 0; i < n; i++) {
+        const double next = i + 1 < n ? remaining * std::pow(uniform(), 1.0 / (n - i - 1)) : 0.0;
+        const int T = periods[xorshift32() % (sizeof(periods) / sizeof(periods[0]))];
+        const int C = std::max(1, static_cast<int>((remaining - next) * T + 0.5));
+        tasks.push_back({"R" + std::to_string(i + 1), C, T, T});
+        remaining = next;
+    }
+    return tasks;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const int sets = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Task> tasks = {
+        {"T1", 2, 10, 10}, {"T2", 3, 10, 10}, {"T3", 2, 20, 20}, {"T4", 2, 20, 20},
+        {"T5", 2, 40, 40}, {"T6", 2, 40, 40}, {"T7", 3, 80, 80},
+    };
+    std::printf("T1..T7 + T8 (C, T = 30)\n");
+    std::printf("%6s %8s %12s %12s\n", "C(T8)", "U", "RM misses", "EDF misses");
+    tasks.push_back({"T8", 1, 30, 30});
+    for (int c = 1; utilization(tasks) <= 1.0 + 1e-9; tasks.back().C = ++c) {
+        long misses[2] = {0, 0};
+        const Policy policies[2] = {Policy::kFixedPriority, Policy::kEdf};
+        for (int p = 0; p < 2; p++) {
+            const SimulationResult r = simulate_preemptive(tasks, hyperperiod(tasks), policies[p]);
+            misses[p] = std::accumulate(r.misses.begin(), r.misses.end(), 0L);
+        }
+        std::printf("%6d %8.4f %12ld %12ld\n", c, utilization(tasks), misses[0], misses[1]);
+    }
+
+    std::printf("\nrandom sets of 5 tasks, %d per bin\n", sets);
+    std::printf("%12s %10s %10s\n", "U", "RM ok", "EDF ok");
+    const int bins = 6;
+    for (int b = 0; b < bins; b++) {
+        const double lo = 0.70 + 0.05 * b, hi = lo + 0.05;
+        int done = 0, rm = 0, edf = 0;
+        while (done < sets) {
+            const std::vector<Task> set = random_task_set(5, lo + (hi - lo) * uniform());
+            const double u = utilization(set);
+            if (u < lo || u >= hi) continue;   // rounding of C moved it out of the bin
+            done++;
+            rm += schedulable(set, Policy::kFixedPriority);
+            edf += schedulable(set, Policy::kEdf);
+        }
+        std::printf("[%.2f, %.2f) %9.1f%% %9.1f%%\n", lo, hi, 100.0 * rm / sets, 100.0 * edf / sets);
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("\n%.2f s\n", seconds);
+    return 0;
+}
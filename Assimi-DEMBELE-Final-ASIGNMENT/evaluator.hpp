@@ -0,0 +1,95 @@
+/*
+ * Incremental evaluation of a job sequence, as check_schedule_feasibility()
+ * in scheduling.py, for both scenarios at once.
+ *
+ * Instead of replaying a whole candidate order from time 0, the search
+ * extends the current prefix by one job (push) and takes it back (pop).
+ * Each scenario is a lane holding the current time and total waiting of
+ * the prefix; push updates both lanes in O(1) and pop restores them from a
+ * preallocated history, so nothing is allocated while searching.
+ *
+ *   kStrict       every job must meet its deadline (allow_t5_miss=False)
+ *   kSkipAllowed  a skippable job that would miss is dropped without
+ *                 advancing time or waiting (allow_t5_miss=True)
+ *
+ * A lane that becomes infeasible, or that the search decides to prune,
+ * is marked dead until the job that killed it is popped.
+ */
+
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "job_table.hpp"
+
+enum Scenario { kStrict = 0, kSkipAllowed = 1, kScenarios = 2 };
+
+struct Lane {
+    int time;
+    long waiting;
+    bool alive;
+};
+
+class IncrementalEvaluator {
+public:
+    explicit IncrementalEvaluator(const JobTable& jobs) : jobs_(jobs)
+    {
+        history_.reserve(jobs.size() + 1);
+        sequence_.reserve(jobs.size());
+        reset();
+    }
+
+    void reset()
+    {
+        history_.clear();
+        sequence_.clear();
+        lanes_.fill(Lane{0, 0, true});
+    }
+
+    /* True if job j may be dropped instead of run in this scenario. */
+    bool skippable(int s, int j) const { return s == kSkipAllowed && jobs_.skippable[j]; }
+
+    /* Append job j to the sequence. */
+    void push(int j)
+    {
+        history_.push_back(lanes_);
+        sequence_.push_back(j);
+        for (int s = 0; s < kScenarios; s++) {
+            Lane& lane = lanes_[s];
+            if (!lane.alive) continue;
+            const int start = std::max(lane.time, jobs_.arrival[j]);
+            const int finish = start + jobs_.C[j];
+            if (finish > jobs_.deadline[j]) {
+                lane.alive = skippable(s, j);
+            } else {
+                lane.waiting += start - jobs_.arrival[j];
+                lane.time = finish;
+            }
+        }
+    }
+
+    /* Remove the last job, restoring both lanes as they were before it. */
+    void pop()
+    {
+        lanes_ = history_.back();
+        history_.pop_back();
+        sequence_.pop_back();
+    }
+
+    void kill(int s) { lanes_[s].alive = false; }
+
+    const Lane& lane(int s) const { return lanes_[s]; }
+    bool any_alive() const { return lanes_[kStrict].alive || lanes_[kSkipAllowed].alive; }
+    const std::vector<int>& sequence() const { return sequence_; }
+
+private:
+    const JobTable& jobs_;
+    std::array<Lane, kScenarios> lanes_;
+    std::vector<std::array<Lane, kScenarios>> history_;
+    std::vector<int> sequence_;
+};
+
+#endif
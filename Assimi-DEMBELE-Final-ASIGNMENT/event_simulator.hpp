@@ -0,0 +1,659 @@
+/*
+ * Discrete-event simulation of a FreeRTOS application on one core.
+ *
+ * The model is the one of main_blinky.c: tasks of fixed priority looping
+ * over a list of steps (run for some time, take or give a mutex, send to or
+ * receive from a queue, drain a queue, delay), released periodically
+ * (vTaskDelayUntil) or by what they receive, and interrupt sources pushing
+ * items into a queue.  The kernel rules are those of FreeRTOS with
+ * configUSE_PREEMPTION and configUSE_TIME_SLICING set to 1:
+ *   - the highest priority ready task runs, and a release preempts at once;
+ *   - ready tasks of the same priority take turns at each tick, through the
+ *     kernel's circular ready lists: the running task stays in its list and
+ *     each selection moves the list index on to the next task, so a task
+ *     preempted by a higher priority one resumes after its peers, not before
+ *     (listGET_OWNER_OF_NEXT_ENTRY), and a task made ready is inserted just
+ *     before the index (listINSERT_END);
+ *   - delays and periodic releases fall on tick boundaries, and a periodic
+ *     task that overran its period starts its next job at once;
+ *   - a send never blocks (block time 0, as every send of main_blinky.c) and
+ *     drops the item on a full queue; a receive blocks until an item is
+ *     there, the highest priority waiter being woken first;
+ *   - a mutex owner inherits the priority of a higher priority task blocked
+ *     on it, until it gives back the last mutex it holds.
+ *
+ * Time goes from event to event (release, interrupt, end of a computation,
+ * time slice) through one priority queue, so the cost is per job and not
+ * per tick: hours of simulated time take milliseconds.  Times are in
+ * microseconds.
+ */
+
+#ifndef EVENT_SIMULATOR_HPP
+#define EVENT_SIMULATOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+
+using Time = long long;     // microseconds
+
+enum class StepKind { kRun, kLock, kUnlock, kSend, kReceive, kDrain, kDelay };
+
+struct Step {
+    StepKind kind;
+    Time min = 0;           // run: execution time drawn in [min, max]; drain: per item; delay
+    Time max = 0;
+    int object = -1;        // queue or mutex index
+};
+
+struct ModelTask {
+    std::string name;
+    int priority = 0;
+    Time period = 0;        // 0: loops back at once, released by what it receives
+    Time offset = 0;        // first periodic release
+    Time deadline = 0;      // relative to the release, 0 for none
+    std::vector<Step> steps;
+};
+
+struct ModelQueue {
+    std::string name;
+    int length = 1;
+};
+
+/* An interrupt pushing one item into a queue, every min_gap to max_gap. */
+struct ModelSource {
+    std::string name;
+    int queue = -1;
+    Time min_gap = 0;
+    Time max_gap = 0;
+    Time offset = 0;
+};
+
+struct Model {
+    Time tick = 1000;
+    std::vector<ModelTask> tasks;
+    std::vector<ModelQueue> queues;
+    std::vector<std::string> mutexes;
+    std::vector<ModelSource> sources;
+};
+
+/*
+ * Log-linear histogram of non-negative values: exact below 64, then 32
+ * buckets per power of two, so a percentile is off by less than 1/32.
+ */
+class Histogram {
+public:
+    void add(Time v)
+    {
+        const std::size_t i = index(v);
+        if (i >= buckets_.size()) buckets_.resize(i + 1, 0);
+        buckets_[i]++;
+        count_++;
+        sum_ += v;
+        min_ = count_ == 1 ? v : std::min(min_, v);
+        max_ = std::max(max_, v);
+    }
+
+    long count() const { return count_; }
+    Time min() const { return min_; }
+    Time max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    /* Smallest bucket bound with at least p of the values at or below it. */
+    Time percentile(double p) const
+    {
+        const long rank = std::max(1L, static_cast<long>(p * count_ + 0.999999));
+        long seen = 0;
+        for (std::size_t i = 0; i < buckets_.size(); i++) {
+            seen += buckets_[i];
+            if (seen >= rank) return std::min(upper(i), max_);
+        }
+        return max_;
+    }
+
+private:
+    static std::size_t index(Time v)
+    {
+        if (v < 64) return static_cast<std::size_t>(std::max<Time>(v, 0));
+        const int e = 63 - __builtin_clzll(static_cast<unsigned long long>(v));
+        return 64 + static_cast<std::size_t>(e - 6) * 32 + static_cast<std::size_t>((v >> (e - 5)) - 32);
+    }
+
+    static Time upper(std::size_t i)
+    {
+        if (i < 64) return static_cast<Time>(i);
+        const int e = static_cast<int>((i - 64) / 32) + 6;
+        const Time m = static_cast<Time>((i - 64) % 32) + 32;
+        return ((m + 1) << (e - 5)) - 1;
+    }
+
+    std::vector<long> buckets_;
+    long count_ = 0;
+    Time sum_ = 0;
+    Time min_ = 0;
+    Time max_ = 0;
+};
+
+struct TaskStats {
+    long jobs = 0;
+    long misses = 0;            // jobs that finished after their deadline
+    Histogram response;         // release to end of the job
+    Histogram blocked;          // per job: time spent waiting for a mutex
+    Time busy = 0;              // CPU time
+};
+
+struct QueueStats {
+    long sends = 0;
+    long drops = 0;             // sends to a full queue
+    long receives = 0;
+    int max_fill = 0;
+    std::vector<Time> time_at_fill;     // time spent with exactly i items
+    Histogram wait;             // item enqueued to taken out
+};
+
+struct MutexStats {
+    long takes = 0;
+    long contended = 0;         // takes that had to wait
+    Histogram wait;
+};
+
+/* Scaling applied to a model without editing it. */
+struct Load {
+    double compute = 1.0;       // multiplies every run and drain time
+    double rate = 1.0;          // multiplies the frequency of every source
+};
+
+class EventSimulator {
+public:
+    EventSimulator(const Model& model, Load load, unsigned seed)
+        : model_(model), load_(load), rng_state_(seed ? seed : 2463534242u)
+    {
+        int top = 0;
+        for (const ModelTask& t : model.tasks) top = std::max(top, t.priority);
+        ready_.resize(static_cast<std::size_t>(top) + 1);
+        for (ReadyList& list : ready_) {
+            list.items.push_back(-1);           // the list end marker of the kernel
+            list.index = list.items.begin();
+        }
+        tasks_.resize(model.tasks.size());
+        task_stats_.resize(model.tasks.size());
+        queues_.resize(model.queues.size());
+        queue_stats_.resize(model.queues.size());
+        for (std::size_t q = 0; q < model.queues.size(); q++) {
+            queue_stats_[q].time_at_fill.assign(static_cast<std::size_t>(model.queues[q].length) + 1, 0);
+        }
+        mutexes_.resize(model.mutexes.size());
+        mutex_stats_.resize(model.mutexes.size());
+    }
+
+    void run(Time horizon)
+    {
+        for (std::size_t k = 0; k < model_.tasks.size(); k++) {
+            const ModelTask& t = model_.tasks[k];
+            TaskState& s = tasks_[k];
+            s.priority = t.priority;
+            if (t.period > 0) {
+                s.next_release = t.offset;
+                s.state = State::kBlocked;
+                schedule(t.offset, EventKind::kRelease, static_cast<int>(k));
+            } else {
+                make_ready(static_cast<int>(k));
+            }
+        }
+        for (std::size_t i = 0; i < model_.sources.size(); i++) {
+            schedule(model_.sources[i].offset, EventKind::kSource, static_cast<int>(i));
+        }
+
+        dispatch();
+        while (!events_.empty() && events_.top().time < horizon) {
+            const Event e = events_.top();
+            events_.pop();
+            now_ = e.time;
+            handled_++;
+            handle(e);
+            dispatch();
+        }
+
+        now_ = horizon;
+        if (running_ >= 0 && tasks_[running_].computing) {
+            task_stats_[running_].busy += now_ - tasks_[running_].started;
+        }
+        for (std::size_t q = 0; q < queues_.size(); q++) {
+            track_fill(static_cast<int>(q));
+        }
+    }
+
+    const std::vector<TaskStats>& task_stats() const { return task_stats_; }
+    const std::vector<QueueStats>& queue_stats() const { return queue_stats_; }
+    const std::vector<MutexStats>& mutex_stats() const { return mutex_stats_; }
+    long events() const { return handled_; }
+
+private:
+    enum class State { kReady, kRunning, kBlocked };
+    enum class EventKind { kRelease, kWake, kSource, kDone, kSlice };
+
+    struct Event {
+        Time time;
+        long seq;               // same time: in scheduling order
+        EventKind kind;
+        int who;
+        unsigned version;       // kDone / kSlice: stale if it no longer matches
+
+        bool operator>(const Event& o) const { return time != o.time ? time > o.time : seq > o.seq; }
+    };
+
+    struct TaskState {
+        State state = State::kBlocked;
+        int priority = 0;       // current, inherited priority included
+        std::size_t step = 0;
+        bool computing = false; // in a run or drain step, until its kDone event
+        Time remaining = 0;     // of the computation, when preempted
+        Time started = 0;       // last time it got the CPU while computing
+        Time release = 0;       // of the current job
+        Time next_release = 0;  // periodic tasks
+        Time blocked_since = 0;
+        Time job_blocked = 0;
+        int held = 0;           // mutexes held
+        unsigned version = 0;
+        std::list<int>::iterator where; // in its ready list, ready or running
+    };
+
+    /* pxReadyTasksLists[p]: circular, the end marker first, and the index at
+     * the task selected last. */
+    struct ReadyList {
+        std::list<int> items;
+        std::list<int>::iterator index;
+        int count = 0;
+    };
+
+    struct QueueState {
+        std::deque<Time> items; // enqueue times
+        std::vector<int> waiters;
+        Time last_change = 0;
+    };
+
+    struct MutexState {
+        int owner = -1;
+        std::vector<int> waiters;
+    };
+
+    unsigned xorshift32()
+    {
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 17;
+        rng_state_ ^= rng_state_ << 5;
+        return rng_state_;
+    }
+
+    Time draw(Time lo, Time hi)
+    {
+        if (hi <= lo) return lo;
+        const auto span = static_cast<std::uint64_t>(hi - lo) + 1;
+        return lo + static_cast<Time>((static_cast<std::uint64_t>(xorshift32()) * span) >> 32);
+    }
+
+    Time scaled(Time t) const { return static_cast<Time>(t * load_.compute + 0.5); }
+
+    void schedule(Time time, EventKind kind, int who, unsigned version = 0)
+    {
+        events_.push(Event{time, seq_++, kind, who, version});
+    }
+
+    Time next_tick() const { return (now_ / model_.tick + 1) * model_.tick; }
+
+    /* Highest priority with a ready or running task. */
+    int highest_ready() const
+    {
+        for (int p = static_cast<int>(ready_.size()) - 1; p >= 0; p--) {
+            if (ready_[p].count > 0) return p;
+        }
+        return -1;
+    }
+
+    /* listINSERT_END: just before the index, so visited last. */
+    void insert_ready(int k)
+    {
+        ReadyList& list = ready_[tasks_[k].priority];
+        const auto before = list.index == list.items.begin() ? list.items.end() : list.index;
+        tasks_[k].where = list.items.insert(before, k);
+        list.count++;
+    }
+
+    /* uxListRemove: an index on the task steps back to the previous item. */
+    void remove_ready(int k)
+    {
+        ReadyList& list = ready_[tasks_[k].priority];
+        if (list.index == tasks_[k].where) list.index = std::prev(list.index);
+        list.items.erase(tasks_[k].where);
+        list.count--;
+    }
+
+    /* listGET_OWNER_OF_NEXT_ENTRY: move the index on, past the end marker. */
+    int select(int priority)
+    {
+        ReadyList& list = ready_[priority];
+        if (++list.index == list.items.end()) list.index = list.items.begin();
+        if (*list.index < 0) ++list.index;
+        return *list.index;
+    }
+
+    void make_ready(int k)
+    {
+        TaskState& s = tasks_[k];
+        s.state = State::kReady;
+        insert_ready(k);
+        if (running_ >= 0 && tasks_[running_].priority == s.priority) arm_slice();
+    }
+
+    void set_priority(int k, int priority)
+    {
+        TaskState& s = tasks_[k];
+        if (s.priority == priority) return;
+        const bool listed = s.state != State::kBlocked;
+        if (listed) remove_ready(k);
+        s.priority = priority;
+        if (listed) insert_ready(k);
+    }
+
+    /* Take the CPU from the running task, which keeps its place in its ready
+     * list: the next selection at its priority moves on to its peer. */
+    void preempt()
+    {
+        TaskState& s = tasks_[running_];
+        if (s.computing) {
+            task_stats_[running_].busy += now_ - s.started;
+            s.remaining -= now_ - s.started;
+            s.version++;
+        }
+        s.state = State::kReady;
+        running_ = -1;
+    }
+
+    void arm_slice()
+    {
+        if (slice_armed_) return;
+        slice_armed_ = true;
+        schedule(next_tick(), EventKind::kSlice, running_, dispatches_);
+    }
+
+    void start(int k)
+    {
+        TaskState& s = tasks_[k];
+        running_ = k;
+        s.state = State::kRunning;
+        dispatches_++;
+        slice_armed_ = false;
+        if (ready_[s.priority].count > 1) arm_slice();
+        if (s.computing) {
+            s.started = now_;
+            schedule(now_ + s.remaining, EventKind::kDone, k, s.version);
+        } else {
+            advance(k);
+        }
+    }
+
+    void dispatch()
+    {
+        for (;;) {
+            const int best = highest_ready();
+            if (running_ >= 0) {
+                if (best <= tasks_[running_].priority) return;
+                preempt();
+            }
+            if (best < 0) return;
+            start(select(best));
+        }
+    }
+
+    void block(int k)
+    {
+        remove_ready(k);
+        tasks_[k].state = State::kBlocked;
+        tasks_[k].blocked_since = now_;
+        running_ = -1;
+    }
+
+    void track_fill(int q)
+    {
+        QueueState& qs = queues_[q];
+        queue_stats_[q].time_at_fill[qs.items.size()] += now_ - qs.last_change;
+        qs.last_change = now_;
+    }
+
+    /* Index of the highest priority task of a wait list, the oldest first. */
+    int take_waiter(std::vector<int>& waiters)
+    {
+        auto best = waiters.begin();
+        for (auto it = waiters.begin(); it != waiters.end(); ++it) {
+            if (tasks_[*it].priority > tasks_[*best].priority) best = it;
+        }
+        const int k = *best;
+        waiters.erase(best);
+        return k;
+    }
+
+    void push_item(int q)
+    {
+        QueueState& qs = queues_[q];
+        QueueStats& st = queue_stats_[q];
+        st.sends++;
+        if (static_cast<int>(qs.items.size()) == model_.queues[q].length) {
+            st.drops++;
+            return;
+        }
+        track_fill(q);
+        qs.items.push_back(now_);
+        st.max_fill = std::max(st.max_fill, static_cast<int>(qs.items.size()));
+        // The woken task takes the item when it runs, as xQueueReceive() does.
+        if (!qs.waiters.empty()) make_ready(take_waiter(qs.waiters));
+    }
+
+    Time pop_item(int q)
+    {
+        QueueState& qs = queues_[q];
+        track_fill(q);
+        const Time enqueued = qs.items.front();
+        qs.items.pop_front();
+        queue_stats_[q].receives++;
+        queue_stats_[q].wait.add(now_ - enqueued);
+        return enqueued;
+    }
+
+    void give_mutex(int k, int m)
+    {
+        MutexState& ms = mutexes_[m];
+        TaskState& s = tasks_[k];
+        ms.owner = -1;
+        if (--s.held == 0) set_priority(k, model_.tasks[k].priority);
+        if (ms.waiters.empty()) return;
+
+        // Hand the mutex over: the woken task's take step is done.
+        const int w = take_waiter(ms.waiters);
+        TaskState& ws = tasks_[w];
+        ms.owner = w;
+        ws.held++;
+        ws.step++;
+        ws.job_blocked += now_ - ws.blocked_since;
+        mutex_stats_[m].wait.add(now_ - ws.blocked_since);
+        for (int other : ms.waiters) {
+            set_priority(w, std::max(ws.priority, tasks_[other].priority));
+        }
+        make_ready(w);
+    }
+
+    void end_job(int k)
+    {
+        const ModelTask& t = model_.tasks[k];
+        TaskState& s = tasks_[k];
+        TaskStats& st = task_stats_[k];
+        const Time response = now_ - s.release;
+        st.jobs++;
+        st.response.add(response);
+        st.blocked.add(s.job_blocked);
+        if (t.deadline > 0 && response > t.deadline) st.misses++;
+        s.job_blocked = 0;
+        s.step = 0;
+
+        if (t.period == 0) {
+            s.release = now_;
+            return;
+        }
+        s.next_release += t.period;
+        if (s.next_release > now_) {
+            block(k);
+            schedule(s.next_release, EventKind::kRelease, k);
+        } else {
+            s.release = s.next_release;     // overrun: vTaskDelayUntil() returns at once
+        }
+    }
+
+    /* Execute the steps of the running task k that take no time. */
+    void advance(int k)
+    {
+        const ModelTask& t = model_.tasks[k];
+        TaskState& s = tasks_[k];
+        while (running_ == k && !s.computing) {
+            if (s.step == t.steps.size()) {
+                end_job(k);
+                continue;
+            }
+            const Step& step = t.steps[s.step];
+            bool may_preempt = false;
+            switch (step.kind) {
+            case StepKind::kRun:
+            case StepKind::kDrain: {
+                Time duration;
+                if (step.kind == StepKind::kRun) {
+                    duration = scaled(draw(step.min, step.max));
+                } else {
+                    Time items = 0;
+                    for (; !queues_[step.object].items.empty(); items++) pop_item(step.object);
+                    duration = scaled(items * step.min);
+                }
+                s.step++;
+                if (duration > 0) {
+                    s.computing = true;
+                    s.remaining = duration;
+                    s.started = now_;
+                    schedule(now_ + duration, EventKind::kDone, k, s.version);
+                }
+                break;
+            }
+            case StepKind::kLock: {
+                MutexState& ms = mutexes_[step.object];
+                mutex_stats_[step.object].takes++;
+                if (ms.owner < 0) {
+                    ms.owner = k;
+                    s.held++;
+                    s.step++;
+                    mutex_stats_[step.object].wait.add(0);
+                } else {
+                    mutex_stats_[step.object].contended++;
+                    ms.waiters.push_back(k);
+                    set_priority(ms.owner, std::max(tasks_[ms.owner].priority, s.priority));
+                    block(k);
+                }
+                break;
+            }
+            case StepKind::kUnlock:
+                s.step++;
+                give_mutex(k, step.object);
+                may_preempt = true;
+                break;
+            case StepKind::kSend:
+                s.step++;
+                push_item(step.object);
+                may_preempt = true;
+                break;
+            case StepKind::kReceive:
+                if (queues_[step.object].items.empty()) {
+                    queues_[step.object].waiters.push_back(k);
+                    block(k);
+                } else {
+                    const Time enqueued = pop_item(step.object);
+                    // An event-driven job starts when its item arrived.
+                    if (t.period == 0 && s.step == 0) s.release = enqueued;
+                    s.step++;
+                }
+                break;
+            case StepKind::kDelay: {
+                // vTaskDelay(n): wakes n ticks after the current tick, 0 only yields.
+                const Time ticks = step.min / model_.tick;
+                s.step++;
+                if (ticks > 0) {
+                    block(k);
+                    schedule((now_ / model_.tick + ticks) * model_.tick, EventKind::kWake, k);
+                } else if (ready_[s.priority].count > 1) {
+                    preempt();
+                }
+                break;
+            }
+            }
+            if (may_preempt && highest_ready() > s.priority) preempt();
+        }
+    }
+
+    void handle(const Event& e)
+    {
+        switch (e.kind) {
+        case EventKind::kRelease:
+            tasks_[e.who].release = e.time;
+            make_ready(e.who);
+            break;
+        case EventKind::kWake:
+            make_ready(e.who);
+            break;
+        case EventKind::kSource: {
+            const ModelSource& src = model_.sources[e.who];
+            push_item(src.queue);
+            const Time gap = static_cast<Time>(draw(src.min_gap, src.max_gap) / load_.rate + 0.5);
+            schedule(now_ + std::max<Time>(gap, 1), EventKind::kSource, e.who);
+            break;
+        }
+        case EventKind::kDone: {
+            TaskState& s = tasks_[e.who];
+            if (e.version != s.version || running_ != e.who) return;
+            task_stats_[e.who].busy += now_ - s.started;
+            s.computing = false;
+            s.remaining = 0;
+            advance(e.who);
+            break;
+        }
+        case EventKind::kSlice:
+            if (e.version != dispatches_ || running_ < 0) return;
+            slice_armed_ = false;
+            if (ready_[tasks_[running_].priority].count > 1) preempt();
+            break;
+        }
+    }
+
+    const Model& model_;
+    Load load_;
+    unsigned rng_state_;
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+    long seq_ = 0;
+    long handled_ = 0;
+    Time now_ = 0;
+
+    std::vector<TaskState> tasks_;
+    std::vector<ReadyList> ready_;          // by priority
+    int running_ = -1;
+    unsigned dispatches_ = 0;
+    bool slice_armed_ = false;
+
+    std::vector<QueueState> queues_;
+    std::vector<MutexState> mutexes_;
+
+    std::vector<TaskStats> task_stats_;
+    std::vector<QueueStats> queue_stats_;
+    std::vector<MutexStats> mutex_stats_;
+};
+
+#endif
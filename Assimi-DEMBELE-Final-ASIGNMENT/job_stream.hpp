@@ -0,0 +1,63 @@
+/*
+ * Lazy stream of the jobs of a periodic task set, in arrival order.
+ *
+ * A min-heap holds the next release of every task, so the stream needs
+ * O(#tasks) memory whatever the horizon: a hyperperiod of millions of ticks
+ * (co-prime periods) costs time proportional to the jobs actually consumed,
+ * never a materialized job list. Jobs released at the same time come out in
+ * task-table order, like the job list of scheduling.py.
+ */
+
+#ifndef JOB_STREAM_HPP
+#define JOB_STREAM_HPP
+
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include "task_set.hpp"
+
+struct StreamJob {
+    int task;           // index into the task set
+    long instance;      // 1 for the first job of the task
+    int C;
+    long arrival;
+    long deadline;
+};
+
+class JobStream {
+public:
+    /* Jobs released in [0, horizon). */
+    JobStream(const std::vector<Task>& tasks, long horizon) : tasks_(tasks), horizon_(horizon)
+    {
+        for (int k = 0; k < static_cast<int>(tasks.size()); k++) {
+            if (horizon > 0) heap_.push({0, k, 1});
+        }
+    }
+
+    bool empty() const { return heap_.empty(); }
+
+    /* Arrival time of the next job; only valid if !empty(). */
+    long next_arrival() const { return std::get<0>(heap_.top()); }
+
+    bool next(StreamJob& job)
+    {
+        if (heap_.empty()) return false;
+        const auto [arrival, k, instance] = heap_.top();
+        heap_.pop();
+        const Task& t = tasks_[k];
+        job = StreamJob{k, instance, t.C, arrival, arrival + t.D};
+        if (arrival + t.T < horizon_) heap_.push({arrival + t.T, k, instance + 1});
+        return true;
+    }
+
+private:
+    using Release = std::tuple<long, int, long>;    // (arrival, task, instance)
+
+    const std::vector<Task>& tasks_;
+    long horizon_;
+    std::priority_queue<Release, std::vector<Release>, std::greater<Release>> heap_;
+};
+
+#endif
@@ -0,0 +1,53 @@
+/*
+ * Hyperperiod job table used by the schedule search.
+ *
+ * The job table is stored as a structure of arrays: the search only ever
+ * touches C, arrival and deadline, so they are kept in flat int arrays and
+ * the job names are looked up only when a result is printed.
+ */
+
+#ifndef JOB_TABLE_HPP
+#define JOB_TABLE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "job_stream.hpp"
+#include "task_set.hpp"
+
+struct JobTable {
+    std::vector<int> C;
+    std::vector<int> arrival;
+    std::vector<int> deadline;
+    std::vector<std::uint8_t> skippable;    // job of the task that may miss its deadline
+    std::vector<int> task;                  // index into the task set
+    std::vector<int> instance;              // 1 for the first job of a task, 2 for the second...
+
+    int size() const { return static_cast<int>(C.size()); }
+};
+
+/* Jobs of [0, hyper) in arrival order, as produced by JobStream. */
+inline JobTable build_job_table(const std::vector<Task>& tasks, long hyper, const std::string& skippable_task)
+{
+    JobTable jobs;
+    JobStream stream(tasks, hyper);
+    StreamJob job;
+    while (stream.next(job)) {
+        jobs.C.push_back(job.C);
+        jobs.arrival.push_back(static_cast<int>(job.arrival));
+        jobs.deadline.push_back(static_cast<int>(job.deadline));
+        jobs.skippable.push_back(tasks[job.task].name == skippable_task);
+        jobs.task.push_back(job.task);
+        jobs.instance.push_back(static_cast<int>(job.instance));
+    }
+    return jobs;
+}
+
+/* "T1_3": same naming as the job_id field of scheduling.py. */
+inline std::string job_id(const JobTable& jobs, const std::vector<Task>& tasks, int j)
+{
+    return tasks[jobs.task[j]].name + "_" + std::to_string(jobs.instance[j]);
+}
+
+#endif
@@ -80,21 +80,306 @@
  * may crash the port.
  */
 
+#include <limits.h>
 #include <stdio.h>
-#include <pthread.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <unistd.h>
 
 /* Kernel includes. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
 #include "semphr.h"
+#include "stream_buffer.h"
 
 /* Local includes. */
 #include "console.h"
 
+/* Search library from the repository root (add it to the include path). */
+#include "recherche_binaire.h"
+
+/* Wide multiplication library from the repository root. */
+#include "grand_nombre.h"
+
+/* Fixed-point temperature conversion from the repository root. */
+#include "temperature.h"
+
+/* Sorted tables stored as ready-to-search images (repository root). */
+#include "table_triee.h"
+
+/* Task4's sorted list 0, 2, ..., 98 as a constant table image, placed in
+ * flash with the code: nothing to build at start-up or in a job.
+ * Regenerate with:  seq 0 2 98 | creer_table --c ullTask4Table - task4_table.h */
+#include "task4_table.h"
+
+/* Bump allocator from the repository root, for the jobs' working buffers. */
+#include "arene.h"
+
+/* Periodic task framework of this directory. */
+#include "periodic_task.h"
+
+#if ( mainTASK_TRACE == 1 )
+    #include "task_trace.h"
+#endif
+
+/* SMP build for dual-core targets (RP2040, ESP32 class), with mainSMP set to
+ * 1.  The tasks are partitioned over the two cores by core affinity:
+ *
+ *   mainIO_CORE       Task1 (status), Task5 (console input), the logger,
+ *                     the trace dump and the load report
+ *   mainCOMPUTE_CORE  Task2 to Task4 and the queue send / receive pair
+ *
+ * Everything that crosses from one core to the other goes through a
+ * lock-free single-producer/single-consumer ring: the log records of Task2
+ * to Task4 (deferred log) and the values of the send task and of the timer
+ * callback (SPSC ring transport, the default under SMP), so neither side
+ * ever waits on a lock the other core holds.  Put the timer service task and
+ * the console RX interrupt on the I/O core as well
+ * (configTIMER_SERVICE_TASK_CORE_AFFINITY, the interrupt controller of the
+ * target).  The load of each core is printed every mainLOAD_REPORT_PERIOD_MS
+ * from the run time of its idle task.  FreeRTOSConfig.h must set
+ * configNUMBER_OF_CORES to 2 or more, and configUSE_CORE_AFFINITY,
+ * configRUN_MULTIPLE_PRIORITIES, configGENERATE_RUN_TIME_STATS and
+ * INCLUDE_xTaskGetIdleTaskHandle to 1. */
+#ifndef mainSMP
+    #define mainSMP                        0
+#endif
+
+#define mainIO_CORE                        ( 0 )
+#define mainCOMPUTE_CORE                   ( 1 )
+
+#define mainLOAD_REPORT_PERIOD_MS          pdMS_TO_TICKS( 10000UL )
+
+/* Transport used between the queue send task / software timer and the queue
+ * receive task, selected at build time with -DmainTRANSPORT=...
+ *
+ * mainTRANSPORT_COPY: the original demo.  Each uint32_t value is copied into
+ * xQueue by the sender and copied out again by the receiver.
+ *
+ * mainTRANSPORT_ZERO_COPY: messages live in a static pool of
+ * mainMESSAGE_POOL_LENGTH buffers of mainMESSAGE_SIZE payload bytes.  Only
+ * the pointer to a buffer goes through xQueue, and free buffers are kept in a
+ * second queue of pointers, so the payload itself is never copied whatever
+ * its size.
+ *
+ * mainTRANSPORT_SPSC_RING: no queue and no critical section at all.  Each
+ * producer (the send task and the timer callback) owns a lock-free
+ * single-producer/single-consumer ring of mainRING_LENGTH values.  A push is
+ * wait-free, so it may also be done from an ISR, and the receive task is
+ * woken with a direct-to-task notification only when a ring goes from empty
+ * to non-empty. */
+#define mainTRANSPORT_COPY                 0
+#define mainTRANSPORT_ZERO_COPY            1
+#define mainTRANSPORT_SPSC_RING            2
+
+#ifndef mainTRANSPORT
+    #if ( mainSMP == 1 )
+        #define mainTRANSPORT              mainTRANSPORT_SPSC_RING
+    #else
+        #define mainTRANSPORT              mainTRANSPORT_COPY
+    #endif
+#endif
+
+/* Payload bytes of one pooled message (zero copy transport). */
+#ifndef mainMESSAGE_SIZE
+    #define mainMESSAGE_SIZE               ( 32 )
+#endif
+
+/* Number of pooled messages, which is also the queue length with the zero
+ * copy transport: every buffer can be in flight at once. */
+#ifndef mainMESSAGE_POOL_LENGTH
+    #define mainMESSAGE_POOL_LENGTH        ( 8 )
+#endif
+
+/* Capacity of each ring (SPSC ring transport), must be a power of two. */
+#ifndef mainRING_LENGTH
+    #define mainRING_LENGTH                ( 16 )
+#endif
+
+/* When set to 1 the receive task empties the queue each time it wakes up
+ * instead of handling a single message.  It then runs at the priority of the
+ * send task: a send no longer preempts the sender with a context switch, the
+ * messages accumulate and are drained in one go once the sender blocks. */
+#ifndef mainBATCHED_DRAIN
+    #define mainBATCHED_DRAIN              0
+#endif
+
+/* Deferred logging, used by Task1 to Task5 instead of printf().  A log call
+ * copies the address of its format string and its arguments into a fixed
+ * size record of the caller's lock-free ring, in a bounded number of cycles
+ * whatever the length of the message; the logger task, at the lowest
+ * priority, formats the records and does the slow console output.  Records
+ * are dropped (and counted) when a ring is full.  Set mainDEFERRED_LOG to 0
+ * to print directly, as the original code did. */
+#ifndef mainDEFERRED_LOG
+    #define mainDEFERRED_LOG               1
+#endif
+
+/* Records per log ring, must be a power of two. */
+#ifndef mainLOG_RING_LENGTH
+    #define mainLOG_RING_LENGTH            ( 8 )
+#endif
+
+/* Most arguments one log call can take. */
+#define mainLOG_MAX_ARGS                   ( 3 )
+
+/* Bytes of string arguments one log record can hold, terminators included:
+ * they are copied into the record, so a task may log from a buffer it then
+ * rewrites.  Longer strings are truncated. */
+#define mainLOG_TEXT_SIZE                  ( 48 )
+
+/* One log ring per producing task, so that each ring has a single producer. */
+#define mainLOG_CHANNEL_TASK1              ( 0 )
+#define mainLOG_CHANNEL_TASK2              ( 1 )
+#define mainLOG_CHANNEL_TASK3              ( 2 )
+#define mainLOG_CHANNEL_TASK4              ( 3 )
+#define mainLOG_CHANNEL_TASK5              ( 4 )
+#define mainLOG_CHANNELS                   ( 5 )
+
+/* How often the logger task drains the rings. */
+#define mainLOG_DRAIN_PERIOD_MS            pdMS_TO_TICKS( 50UL )
+
+/* Console input of Task5.  Received characters are written into a stream
+ * buffer of mainINPUT_BUFFER_SIZE bytes by vConsoleInputFromISR(), the
+ * receive path of the console (the UART RX interrupt on a target), and
+ * Task5 is only notified when a line is complete.  Lines longer than
+ * mainINPUT_LINE_LENGTH - 1 characters are rejected. */
+#define mainINPUT_BUFFER_SIZE              ( 64 )
+#define mainINPUT_LINE_LENGTH              ( 32 )
+
+/* On the Linux port there is no RX interrupt: the Stdin task polls stdin
+ * every mainINPUT_POLL_PERIOD_MS and hands the characters to Task5 from task
+ * context.  A thread outside the scheduler cannot do it through
+ * vConsoleInputFromISR(): on the POSIX port the ...FromISR() functions mask
+ * nothing against the task threads.  The stream buffer has a single writer,
+ * so a target build that feeds it from its RX interrupt sets this to 0. */
+#ifndef mainINPUT_STDIN_TASK
+    #define mainINPUT_STDIN_TASK           1
+#endif
+
+#define mainINPUT_POLL_PERIOD_MS           pdMS_TO_TICKS( 50UL )
+
+/* Static allocation build: every task, queue, mutex, stream buffer and
+ * timer is created with its ...Static() constructor from one arena,
+ * xTaskArena, placed by the linker in its own .bss.task_arena section (see
+ * task_arena.ld), so startup does no heap allocation and the RAM footprint
+ * is fixed at link time.  Needs configSUPPORT_STATIC_ALLOCATION set to 1. */
+#ifndef mainSTATIC_ALLOCATION
+    #define mainSTATIC_ALLOCATION          0
+#endif
+
+/* Stack depth of each task in words.  The defaults are the demo's
+ * configMINIMAL_STACK_SIZE; build once with -DmainTASK_TRACE=1, read the
+ * words each task used at its worst in the dump, and set these to that
+ * figure plus mainSTACK_MARGIN_WORDS. */
+#define mainSTACK_MARGIN_WORDS             ( 32 )
+
+#ifndef mainPERIODIC_STACK_WORDS
+    #define mainPERIODIC_STACK_WORDS       configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainTASK5_STACK_WORDS
+    #define mainTASK5_STACK_WORDS          configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainQUEUE_TASK_STACK_WORDS
+    #define mainQUEUE_TASK_STACK_WORDS     configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainLOG_STACK_WORDS
+    #define mainLOG_STACK_WORDS            configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainTRACE_STACK_WORDS
+    #define mainTRACE_STACK_WORDS          configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainLOAD_STACK_WORDS
+    #define mainLOAD_STACK_WORDS           configMINIMAL_STACK_SIZE
+#endif
+#ifndef mainSTDIN_STACK_WORDS
+    #define mainSTDIN_STACK_WORDS          configMINIMAL_STACK_SIZE
+#endif
+
+/* Working buffers of the periodic jobs come from a per-task scratch arena
+ * (arene.h), emptied at the start of every job, rather than from the task's
+ * stack or the FreeRTOS heap.  Task4 looks its mainTASK4_TARGETS keys up in
+ * the constant table in one batched search; mainTASK4_SCRATCH_BYTES holds
+ * the results plus the worst alignment padding. */
+#define mainTASK4_TARGETS                  ( 1 )
+#define mainTASK4_SCRATCH_BYTES            ( mainTASK4_TARGETS * sizeof( long ) + ARENE_ALIGNEMENT_SIMD )
+
+/* Optional RAM budget of the arena in bytes, checked at compile time here
+ * and at link time by task_arena.ld (-Wl,--defsym=TASK_ARENA_BUDGET=...). */
+/* #define mainTASK_ARENA_BUDGET           ( 16 * 1024 ) */
+
+/* Per-job instrumentation of Task1 to Task5 (execution time, start jitter,
+ * deadline misses), see task_trace.h: FreeRTOSConfig.h must also include
+ * task_trace.h.  The statistics are printed every mainTRACE_DUMP_PERIOD_MS. */
+#ifndef mainTASK_TRACE
+    #define mainTASK_TRACE                 0
+#endif
+
+#define mainTRACE_DUMP_PERIOD_MS           pdMS_TO_TICKS( 10000UL )
+
 /* Priorities at which the tasks are created. */
-#define mainQUEUE_RECEIVE_TASK_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#if ( mainBATCHED_DRAIN == 1 )
+    #define mainQUEUE_RECEIVE_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#else
+    #define mainQUEUE_RECEIVE_TASK_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#endif
 #define mainQUEUE_SEND_TASK_PRIORITY       ( tskIDLE_PRIORITY + 1 )
+#define mainTASK5_PRIORITY                 ( tskIDLE_PRIORITY + 2 )
+#define mainSTDIN_TASK_PRIORITY            ( tskIDLE_PRIORITY + 2 )
+#define mainLOG_TASK_PRIORITY              ( tskIDLE_PRIORITY )
+#define mainTRACE_DUMP_TASK_PRIORITY       ( tskIDLE_PRIORITY )
+#define mainLOAD_REPORT_TASK_PRIORITY      ( tskIDLE_PRIORITY )
+
+/* Task1 to Task4 are scheduled by fixed Rate-Monotonic priority, or with
+ * mainSCHEDULING_EDF set to 1 by Earliest Deadline First with admission
+ * control (see periodic_task.h). */
+#ifndef mainSCHEDULING_EDF
+    #define mainSCHEDULING_EDF             0
+#endif
+
+/* Under Rate-Monotonic, Task1 to Task4 get priorities from this one upwards:
+ * Task4 (4000 ms) runs at idle + 1 and Task1 (1000 ms) at idle + 4.  Under
+ * EDF they use this priority and the two above it, a band that must not
+ * hold any other task (see periodic_task.h): it starts above Task5, Rx and TX. */
+#if ( mainSCHEDULING_EDF == 1 )
+    #define mainPERIODIC_LOWEST_PRIORITY   ( tskIDLE_PRIORITY + 3 )
+#else
+    #define mainPERIODIC_LOWEST_PRIORITY   ( tskIDLE_PRIORITY + 1 )
+#endif
+#define mainPERIODIC_TASKS                 ( sizeof( xPeriodicTasks ) / sizeof( xPeriodicTasks[ 0 ] ) )
+
+#if ( mainSMP == 1 )
+    #if ( !defined( configNUMBER_OF_CORES ) || ( configNUMBER_OF_CORES < 2 ) )
+        #error mainSMP needs configNUMBER_OF_CORES set to 2 or more
+    #endif
+    #if ( configUSE_CORE_AFFINITY != 1 ) || ( configRUN_MULTIPLE_PRIORITIES != 1 )
+        #error mainSMP needs configUSE_CORE_AFFINITY and configRUN_MULTIPLE_PRIORITIES set to 1
+    #endif
+    #if ( configGENERATE_RUN_TIME_STATS != 1 ) || ( INCLUDE_xTaskGetIdleTaskHandle != 1 )
+        #error mainSMP needs configGENERATE_RUN_TIME_STATS and INCLUDE_xTaskGetIdleTaskHandle set to 1
+    #endif
+    #if ( mainTRANSPORT != mainTRANSPORT_SPSC_RING ) || ( mainDEFERRED_LOG != 1 )
+        #error mainSMP crosses cores through the SPSC ring transport and the deferred log only
+    #endif
+    #if ( mainSCHEDULING_EDF == 1 )
+        #error the EDF dispatcher of periodic_task.c assumes a single core, use Rate-Monotonic with mainSMP
+    #endif
+    #if ( mainTASK_TRACE == 1 )
+        #error task_trace.c keeps global slots updated unlocked from the trace hooks, build mainTASK_TRACE single core
+    #endif
+#endif
+
+#if ( mainSCHEDULING_EDF == 1 )
+    _Static_assert( ( mainPERIODIC_LOWEST_PRIORITY > mainTASK5_PRIORITY ) &&
+                    ( mainPERIODIC_LOWEST_PRIORITY > mainQUEUE_RECEIVE_TASK_PRIORITY ) &&
+                    ( mainPERIODIC_LOWEST_PRIORITY > mainQUEUE_SEND_TASK_PRIORITY ) &&
+                    ( mainPERIODIC_LOWEST_PRIORITY > mainSTDIN_TASK_PRIORITY ),
+                    "the EDF band overlaps Task5, Rx, TX or Stdin" );
+    _Static_assert( mainPERIODIC_LOWEST_PRIORITY + 2 < configMAX_PRIORITIES,
+                    "the EDF band needs mainPERIODIC_LOWEST_PRIORITY + 2 below configMAX_PRIORITIES" );
+#endif
 
 /* The rate at which data is sent to the queue.  The times are converted from
  * milliseconds to ticks using the pdMS_TO_TICKS() macro. */
@@ -102,7 +387,11 @@
 #define mainTIMER_SEND_FREQUENCY_MS        pdMS_TO_TICKS( 2000UL )
 
 /* The number of items the queue can hold at once. */
-#define mainQUEUE_LENGTH                   ( 2 )
+#if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+    #define mainQUEUE_LENGTH               mainMESSAGE_POOL_LENGTH
+#else
+    #define mainQUEUE_LENGTH               ( 2 )
+#endif
 
 /* The values sent to the queue receive task from the queue send task and the
  * queue send software timer respectively. */
@@ -111,17 +400,237 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+
+/* A pooled message.  The queues only ever hold pointers to these. */
+    typedef struct xMESSAGE
+    {
+        uint32_t ulValue;                      /* mainVALUE_SENT_FROM_TASK or mainVALUE_SENT_FROM_TIMER. */
+        uint32_t ulLength;                     /* Number of bytes used in ucPayload. */
+        uint8_t ucPayload[ mainMESSAGE_SIZE ]; /* The sender's name, printed in place by the receiver. */
+    } Message_t;
+
+    _Static_assert( mainMESSAGE_SIZE >= sizeof( "software timer" ) - 1,
+                    "mainMESSAGE_SIZE too small for the sender names" );
+
+    typedef Message_t * QueueItem_t;
+#else
+    typedef uint32_t QueueItem_t;
+#endif
+
+#if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+
+    #if ( ( mainRING_LENGTH & ( mainRING_LENGTH - 1 ) ) != 0 )
+        #error mainRING_LENGTH must be a power of two
+    #endif
+
+/* Single-producer/single-consumer ring.  ulHead is only written by the
+ * producer and ulTail only by the consumer; both run freely and are reduced
+ * modulo mainRING_LENGTH when indexing, so head - tail is the fill level. */
+    typedef struct xSPSC_RING
+    {
+        atomic_uint ulHead;
+        atomic_uint ulTail;
+        QueueItem_t xItems[ mainRING_LENGTH ];
+    } SpscRing_t;
+
+/*
+ * Wait-free push, safe from a task, a timer callback or an ISR.  Returns
+ * pdFAIL if the ring is full.  *pxWasEmpty is set to pdTRUE when the consumer
+ * had drained the ring before this push, i.e. when it must be notified.
+ */
+    static BaseType_t prvRingPush( SpscRing_t * pxRing,
+                                   QueueItem_t xItem,
+                                   BaseType_t * pxWasEmpty );
+
+/*
+ * Take the oldest item of the ring.  Returns pdFAIL if the ring is empty.
+ */
+    static BaseType_t prvRingPop( SpscRing_t * pxRing,
+                                  QueueItem_t * pxItem );
+#endif
+
+#if ( mainDEFERRED_LOG == 1 )
+
+    #if ( ( mainLOG_RING_LENGTH & ( mainLOG_RING_LENGTH - 1 ) ) != 0 )
+        #error mainLOG_RING_LENGTH must be a power of two
+    #endif
+
+/* A log argument.  Which member is valid is given by the matching
+ * conversion of the format string, read only when the record is printed. */
+    typedef union xLOG_ARG
+    {
+        long long llValue;                     /* d i u x X c, whatever the length modifier. */
+        double dValue;                         /* f e E g G */
+        const void * pvValue;                  /* s p, a string into the record's cText. */
+    } LogArg_t;
+
+/* A log record: nothing is formatted until the logger task prints it, so the
+ * format must be a string literal; string arguments are copied to cText. */
+    typedef struct xLOG_RECORD
+    {
+        const char * pcFormat;
+        LogArg_t xArgs[ mainLOG_MAX_ARGS ];
+        char cText[ mainLOG_TEXT_SIZE ];
+    } LogRecord_t;
+
+/* Single-producer/single-consumer ring of records, indexed as SpscRing_t. */
+    typedef struct xLOG_RING
+    {
+        atomic_uint ulHead;
+        atomic_uint ulTail;
+        atomic_uint ulDropped;                 /* Records lost because the ring was full. */
+        LogRecord_t xRecords[ mainLOG_RING_LENGTH ];
+    } LogRing_t;
+
+/* Store an argument in the LogArg_t member matching its type. */
+    #define mainLOG_ARG( x )                                          \
+    _Generic( ( x ),                                                  \
+              float: prvLogArgDouble,                                 \
+              double: prvLogArgDouble,                                \
+              char *: prvLogArgPointer,                               \
+              const char *: prvLogArgPointer,                         \
+              default: prvLogArgInteger ) ( x )
+
+/* Bit n set: argument n is a string, to be copied into the record. */
+    #define mainLOG_TEXT( x, n ) \
+    ( _Generic( ( x ), char *: 1U, const char *: 1U, default: 0U ) << ( n ) )
+
+    #define mainLOG0( xChannel, pcFormat ) \
+    prvLogWrite( ( xChannel ), ( pcFormat ), NULL, 0, 0U )
+    #define mainLOG1( xChannel, pcFormat, a )                                    \
+    prvLogWrite( ( xChannel ), ( pcFormat ), ( const LogArg_t[] ) { mainLOG_ARG( a ) }, 1, \
+                 mainLOG_TEXT( a, 0 ) )
+    #define mainLOG2( xChannel, pcFormat, a, b )                                                 \
+    prvLogWrite( ( xChannel ), ( pcFormat ), ( const LogArg_t[] ) { mainLOG_ARG( a ), mainLOG_ARG( b ) }, 2, \
+                 mainLOG_TEXT( a, 0 ) | mainLOG_TEXT( b, 1 ) )
+    #define mainLOG3( xChannel, pcFormat, a, b, c )                                                                \
+    prvLogWrite( ( xChannel ), ( pcFormat ), ( const LogArg_t[] ) { mainLOG_ARG( a ), mainLOG_ARG( b ), mainLOG_ARG( c ) }, 3, \
+                 mainLOG_TEXT( a, 0 ) | mainLOG_TEXT( b, 1 ) | mainLOG_TEXT( c, 2 ) )
+
+    static inline LogArg_t prvLogArgInteger( long long llValue )
+    {
+        return ( LogArg_t ) { .llValue = llValue };
+    }
+
+    static inline LogArg_t prvLogArgDouble( double dValue )
+    {
+        return ( LogArg_t ) { .dValue = dValue };
+    }
+
+    static inline LogArg_t prvLogArgPointer( const char * pcValue )
+    {
+        return ( LogArg_t ) { .pvValue = pcValue };
+    }
+
+/*
+ * Append a record to the ring of xChannel, copying the arguments whose bit
+ * is set in uxTexts as strings.  Wait-free, no kernel call.
+ */
+    static void prvLogWrite( UBaseType_t xChannel,
+                             const char * pcFormat,
+                             const LogArg_t * pxArgs,
+                             size_t uxArgs,
+                             unsigned uxTexts );
+
+/*
+ * The logger task: drains every ring and prints the records.
+ */
+    static void prvLogTask( void * pvParameters );
+
+#else /* if ( mainDEFERRED_LOG == 1 ) */
+
+    #define mainLOG0( xChannel, pcFormat )             printf( pcFormat )
+    #define mainLOG1( xChannel, pcFormat, a )          printf( pcFormat, a )
+    #define mainLOG2( xChannel, pcFormat, a, b )       printf( pcFormat, a, b )
+    #define mainLOG3( xChannel, pcFormat, a, b, c )    printf( pcFormat, a, b, c )
+
+#endif /* if ( mainDEFERRED_LOG == 1 ) */
+
+/*-----------------------------------------------------------*/
+
 /*
  * The tasks as described in the comments at the top of this file.
  */
 static void prvQueueReceiveTask( void * pvParameters );
 static void prvQueueSendTask( void * pvParameters );
 
+/*
+ * Send ulValue to the queue receive task without blocking, using the
+ * transport selected by mainTRANSPORT.
+ */
+static void prvSendValue( uint32_t ulValue );
+
+/*
+ * Handle one item taken from the queue, then give its buffer back to the
+ * pool when the zero copy transport is used.
+ */
+static void prvHandleItem( QueueItem_t xItem );
+
+#if ( mainTASK_TRACE == 1 )
+
+/*
+ * Print the task_trace statistics every mainTRACE_DUMP_PERIOD_MS.
+ */
+    static void prvTraceDumpTask( void * pvParameters );
+#endif
+
+#if ( mainSMP == 1 )
+
+/*
+ * Print the share of time each core spent outside its idle task every
+ * mainLOAD_REPORT_PERIOD_MS.
+ */
+    static void prvLoadReportTask( void * pvParameters );
+#endif
+
+/*
+ * Create a task, from the arena in the static allocation build, and record
+ * it for the stack usage report.  In the SMP build the task only ever runs
+ * on core xCore (mainIO_CORE or mainCOMPUTE_CORE); xCore is ignored
+ * otherwise.
+ */
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                 const char * pcName,
+                                 uint32_t ulStackDepth,
+                                 UBaseType_t uxPriority,
+                                 BaseType_t xCore,
+                                 TaskHandle_t * pxCreatedTask );
+
+#if ( mainTASK_TRACE == 1 )
+
+/*
+ * Print the stack words each created task used at its worst, after each
+ * trace dump.
+ */
+    static void prvReportStackUsage( void );
+#endif
+
 /*
  * The callback function executed when the software timer expires.
  */
 static void prvQueueSendTimerCallback( TimerHandle_t xTimerHandle );
 
+/*
+ * Receive path of the console: store uxLength characters for Task5 and wake
+ * it if they complete a line.  Callable from an ISR; pxHigherPriorityTaskWoken
+ * is used as by the FreeRTOS ...FromISR() functions and may be NULL.
+ */
+void vConsoleInputFromISR( const char * pcChars,
+                           size_t uxLength,
+                           BaseType_t * pxHigherPriorityTaskWoken );
+
+#if ( mainINPUT_STDIN_TASK == 1 )
+
+/*
+ * The task feeding stdin to Task5 on the Linux port, and its task-context
+ * counterpart of vConsoleInputFromISR().
+ */
+    static void prvStdinTask( void * pvParameters );
+    static void prvConsoleInput( const char * pcChars,
+                                 size_t uxLength );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* The queue used by both tasks. */
@@ -130,7 +639,101 @@ static QueueHandle_t xQueue = NULL;
 /* A software timer that is started from the tick hook. */
 static TimerHandle_t xTimer = NULL;
 
-static SemaphoreHandle_t xMutex = NULL; // Mutex pour synchronisation
+/* Tasks created so far, for prvReportStackUsage(): the periodic tasks, Task5,
+ * Rx, TX and the optional logger, trace dump, load report and stdin tasks. */
+#define mainMAX_TASKS                      ( 4 + 3 + mainDEFERRED_LOG + mainTASK_TRACE + mainSMP + mainINPUT_STDIN_TASK )
+
+typedef struct xCREATED_TASK
+{
+    const char * pcName;
+    TaskHandle_t xHandle;
+    uint32_t ulStackDepth;
+} CreatedTask_t;
+
+static CreatedTask_t xCreatedTasks[ mainMAX_TASKS ];
+static UBaseType_t uxCreatedTasks = 0;
+
+#if ( mainSTATIC_ALLOCATION == 1 )
+
+    #if ( configSUPPORT_STATIC_ALLOCATION != 1 )
+        #error mainSTATIC_ALLOCATION needs configSUPPORT_STATIC_ALLOCATION set to 1
+    #endif
+
+    #define mainARENA_STACK_WORDS                                                 \
+    ( 4 * mainPERIODIC_STACK_WORDS + mainTASK5_STACK_WORDS                        \
+      + 2 * mainQUEUE_TASK_STACK_WORDS + mainDEFERRED_LOG * mainLOG_STACK_WORDS \
+      + mainTASK_TRACE * mainTRACE_STACK_WORDS + mainSMP * mainLOAD_STACK_WORDS  \
+      + mainINPUT_STDIN_TASK * mainSTDIN_STACK_WORDS )
+
+/* Every object of the demo.  The task stacks are one pool carved in
+ * creation order, the TCBs one array. */
+    typedef struct xTASK_ARENA
+    {
+        StackType_t xStacks[ mainARENA_STACK_WORDS ];
+        StaticTask_t xTCBs[ mainMAX_TASKS ];
+        StaticQueue_t xQueue;
+        uint8_t ucQueueStorage[ mainQUEUE_LENGTH * sizeof( QueueItem_t ) ];
+        #if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+            StaticQueue_t xFreeMessages;
+            uint8_t ucFreeMessagesStorage[ mainMESSAGE_POOL_LENGTH * sizeof( Message_t * ) ];
+        #endif
+        StaticStreamBuffer_t xInputBuffer;
+        uint8_t ucInputStorage[ mainINPUT_BUFFER_SIZE + 1 ];       /* The kernel wants the size + 1 bytes. */
+        StaticTimer_t xTimer;
+        uint8_t ucTask4Scratch[ mainTASK4_SCRATCH_BYTES ];
+    } TaskArena_t;
+
+    static TaskArena_t xTaskArena __attribute__( ( section( ".bss.task_arena" ), aligned( 8 ) ) );
+    static uint32_t ulArenaStackUsed = 0;
+    static UBaseType_t uxArenaTCBsUsed = 0;
+
+    #ifdef mainTASK_ARENA_BUDGET
+        _Static_assert( sizeof( TaskArena_t ) <= mainTASK_ARENA_BUDGET, "task arena exceeds mainTASK_ARENA_BUDGET" );
+    #endif
+
+/*
+ * Take the stack and TCB of the next task from the arena.
+ */
+    static void prvArenaTake( uint32_t ulStackDepth,
+                              StackType_t ** ppxStack,
+                              StaticTask_t ** ppxTCB );
+#endif /* if ( mainSTATIC_ALLOCATION == 1 ) */
+
+/* Task4's table, a view on ullTask4Table set up by main_blinky(). */
+static TableTriee xTask4Table;
+
+/* Scratch arena of Task4, set up by main_blinky() on its memory. */
+static Arene xTask4Scratch;
+
+#if ( mainSTATIC_ALLOCATION == 1 )
+    #define mainTASK4_SCRATCH_MEMORY       ( xTaskArena.ucTask4Scratch )
+#else
+    static uint8_t ucTask4Scratch[ mainTASK4_SCRATCH_BYTES ];
+    #define mainTASK4_SCRATCH_MEMORY       ( ucTask4Scratch )
+#endif
+
+/* Characters received for Task5, and Task5 itself to notify on a new line. */
+static StreamBufferHandle_t xInputBuffer = NULL;
+static TaskHandle_t xInputTask = NULL;
+
+#if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+    /* The message buffers, and the queue holding pointers to the free ones. */
+    static Message_t xMessagePool[ mainMESSAGE_POOL_LENGTH ];
+    static QueueHandle_t xFreeMessages = NULL;
+#endif
+
+#if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+    /* One ring per producer, so each ring has a single producer. */
+    static SpscRing_t xTaskRing;
+    static SpscRing_t xTimerRing;
+
+    /* The task notified when a ring becomes non-empty. */
+    static TaskHandle_t xReceiveTask = NULL;
+#endif
+
+#if ( mainDEFERRED_LOG == 1 )
+    static LogRing_t xLogRings[ mainLOG_CHANNELS ];
+#endif
 
 /*-----------------------------------------------------------*/
 /*-----------------------------------------------------------*/
@@ -138,93 +741,159 @@ static SemaphoreHandle_t xMutex = NULL; // Mutex pour synchronisation
 /*-----------------------------------------------------------*/
 /*-----------------------------------------------------------*/
 
-void Task1_PrintStatus(void* pvParameters) {
-    while (1) {
-        printf("Working\n");
-        vTaskDelay(pdMS_TO_TICKS(1000)); // Excute toutes les 1000 ms
-    }
+// Les tâches 1 à 4 sont périodiques : chaque fonction est un seul job,
+// appelé à chaque période par periodic_task.c (voir xPeriodicTasks plus bas).
+
+void Task1_PrintStatus(void) {
+    mainLOG0(mainLOG_CHANNEL_TASK1, "Working\n");
 }
 
-void Task2_ConvertTemperature(void* pvParameters) {
-    const float fahrenheit = 100.0;
-    while (1) {
-        float celsius = (fahrenheit - 32) * 5.0 / 9.0;
-        printf("Fahrenheit: %.2f -> Celsius: %.2f\n", fahrenheit, celsius);
-        vTaskDelay(pdMS_TO_TICKS(2000)); // Excute toutes les 2000 ms
-    }
+// Conversion en virgule fixe Q16.16 : ni flottant ni routine double logicielle
+// sur les MCU sans FPU, et le même nombre de cycles à chaque job.
+// Le journal différé copie les textes dans son enregistrement.
+void Task2_ConvertTemperature(void) {
+    char fahrenheitText[16], celsiusText[16];
+    const int32_t fahrenheit = temperatureDepuisEntier(100);
+    int32_t celsius = celsiusDepuisFahrenheitQ16(fahrenheit);
+    temperatureVersTexte(fahrenheit, fahrenheitText, sizeof(fahrenheitText));
+    temperatureVersTexte(celsius, celsiusText, sizeof(celsiusText));
+    mainLOG2(mainLOG_CHANNEL_TASK2, "Fahrenheit: %s -> Celsius: %s\n", fahrenheitText, celsiusText);
 }
 
-void Task3_MultiplyLargeNumbers(void* pvParameters) {
-    const long int num1 = 123456789, num2 = 987654321;
-    while (1) {
-        long long result = (long long)num1 * num2;
-        printf("Multiplication Result: %lld\n", result);
-        vTaskDelay(pdMS_TO_TICKS(3000)); // Excute toutes les 3000 ms
-    }
+// Produit 64 x 64 -> 128 bits : le résultat ne déborde plus un long long.
+// Le journal différé copie le texte dans son enregistrement.
+void Task3_MultiplyLargeNumbers(void) {
+    char text[mainLOG_TEXT_SIZE];
+    const int64_t num1 = 123456789, num2 = 987654321;
+    Produit128 result = multiplier64Signe(num1, num2);
+    produit128VersTexte(result, 1, text, sizeof(text));
+    mainLOG1(mainLOG_CHANNEL_TASK3, "Multiplication Result: %s\n", text);
 }
 
-void Task4_BinarySearch(void* pvParameters) {
-    int sortedList[50];
-    for (int i = 0; i < 50; i++) sortedList[i] = i * 2;
-    const int target = 25;
+void Task4_BinarySearch(void) {
+    static const int targets[mainTASK4_TARGETS] = { 25 };
 
-    while (1) {
-        int low = 0, high = 49, mid, index = -1;
-        while (low <= high) {
-            mid = (low + high) / 2;
-            if (sortedList[mid] == target) {
-                index = mid;
-                break;
-            }
-            else if (sortedList[mid] < target) {
-                low = mid + 1;
-            }
-            else {
-                high = mid - 1;
-            }
+    // La liste triée est une image constante : rien à reconstruire à chaque job.
+    // Les résultats de la recherche par lot viennent de l'arène de la tâche,
+    // vidée au début de chaque job
+    areneVider(&xTask4Scratch);
+    long* index = areneTableau(&xTask4Scratch, long, mainTASK4_TARGETS);
+    configASSERT(index != NULL);
+    tableRechercheLot(&xTask4Table, targets, mainTASK4_TARGETS, index);
+
+    for (size_t i = 0; i < mainTASK4_TARGETS; i++) {
+        if (index[i] != -1) {
+            mainLOG2(mainLOG_CHANNEL_TASK4, "Element %d found at index %ld\n", targets[i], index[i]);
         }
+        else {
+            mainLOG1(mainLOG_CHANNEL_TASK4, "Element %d not found\n", targets[i]);
+        }
+    }
+}
+
+// Table des tâches périodiques : (nom, job, période, échéance, budget C).
+// Les priorités sont attribuées en Rate-Monotonic par xPeriodicTasksCreate(),
+// ou dynamiquement en EDF. Le budget C sert au contrôle d'admission EDF :
+// à remplacer par les C mesurés avec task_trace (mainTASK_TRACE).
+static PeriodicTask_t xPeriodicTasks[] = {
+    { "Task1", Task1_PrintStatus,          pdMS_TO_TICKS(1000), pdMS_TO_TICKS(1000), pdMS_TO_TICKS(10) },
+    { "Task2", Task2_ConvertTemperature,   pdMS_TO_TICKS(2000), pdMS_TO_TICKS(2000), pdMS_TO_TICKS(10) },
+    { "Task3", Task3_MultiplyLargeNumbers, pdMS_TO_TICKS(3000), pdMS_TO_TICKS(3000), pdMS_TO_TICKS(10) },
+    { "Task4", Task4_BinarySearch,         pdMS_TO_TICKS(4000), pdMS_TO_TICKS(4000), pdMS_TO_TICKS(10) },
+};
+
+#if ( mainSMP == 1 )
+// Coeur de chaque tâche périodique en SMP : Task1 ne fait qu'écrire dans le
+// journal, elle reste avec les entrées/sorties ; Task2 à Task4 calculent.
+static const BaseType_t xPeriodicTaskCores[] = { mainIO_CORE, mainCOMPUTE_CORE, mainCOMPUTE_CORE, mainCOMPUTE_CORE };
+
+_Static_assert(sizeof(xPeriodicTaskCores) / sizeof(xPeriodicTaskCores[0]) == mainPERIODIC_TASKS,
+               "one core per periodic task");
+#endif
+
+// Analyse d'une ligne sans scanf : espaces, signe, chiffres, espaces.
+// Retourne 1 et la valeur si la ligne est un entier, 0 sinon.
+// Le cumul est non signé et borné avant chaque multiplication : aucun
+// débordement, y compris avec un long de 32 bits (RP2040, Cortex-M, ESP32).
+static int prvParseInteger(const char* line, int* value) {
+    unsigned long result = 0, limit = INT_MAX;
+    int negative = 0, digits = 0;
+
+    while (*line == ' ' || *line == '\t') line++;
+    if (*line == '-' || *line == '+') negative = (*line++ == '-');
+    if (negative) limit = (unsigned long)INT_MAX + 1; // |INT_MIN|
+    while (*line >= '0' && *line <= '9') {
+        const unsigned long digit = (unsigned long)(*line++ - '0');
+        if (result > (limit - digit) / 10) return 0; // dépassement d'un int
+        result = result * 10 + digit;
+        digits++;
+    }
+    while (*line == ' ' || *line == '\t' || *line == '\r') line++;
+    if (digits == 0 || *line != '\0') return 0;
+
+    // -(result - 1) - 1 : INT_MIN sans passer par +2147483648 en int
+    *value = negative ? (result == 0 ? 0 : -(int)(result - 1) - 1) : (int)result;
+    return 1;
+}
+
+static void prvHandleResetLine(const char* line) {
+    int input;
 
-        if (index != -1) {
-            printf("Element %d found at index %d\n", target, index);
+    if (prvParseInteger(line, &input)) {
+        if (input == 1) {
+            mainLOG1(mainLOG_CHANNEL_TASK5, "Reset received: %d\n", input);
         }
         else {
-            printf("Element %d not found\n", target);
+            mainLOG1(mainLOG_CHANNEL_TASK5, "Reset value: %d\n", input);
         }
-        vTaskDelay(pdMS_TO_TICKS(4000)); // Excute toutes les 4000 ms
+    }
+    else {
+        mainLOG0(mainLOG_CHANNEL_TASK5, "Invalid input. Please enter a valid number.\n");
     }
 }
 
+// La tâche 5 ne fait plus de scanf ni d'attente active : elle dort jusqu'à ce
+// que la réception console (vConsoleInputFromISR(), ou la tâche Stdin sous
+// Linux) lui signale une ligne complète, puis lit les caractères reçus dans
+// le stream buffer. Aucun mutex n'est pris pendant les entrées/sorties, les
+// autres tâches ne sont donc jamais bloquées par l'opérateur.
 void Task5_ResetHandler(void* pvParameters) {
-    int input;
+    char line[mainINPUT_LINE_LENGTH];
+    size_t length = 0;
+    int overflow = 0;
+    char received[16];
+    size_t count;
+
+    (void)pvParameters;
+    mainLOG0(mainLOG_CHANNEL_TASK5, "Enter '1' to RESET, or '0' to continue: ");
+
     while (1) {
-        // Attendre le mutex avant de demander une entre
-        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
-            printf("Enter '1' to RESET, or '0' to continue: ");
-            if (scanf("%d", &input) == 1) {
-                if (input == 1) {
-                    printf("Reset received: %d\n", input);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while ((count = xStreamBufferReceive(xInputBuffer, received, sizeof(received), 0)) > 0) {
+            for (size_t i = 0; i < count; i++) {
+                if (received[i] != '\n') {
+                    // Une ligne trop longue est rejetée en entier
+                    if (length + 1 < sizeof(line)) line[length++] = received[i];
+                    else overflow = 1;
+                    continue;
+                }
+
+                line[length] = '\0';
+                if (overflow) {
+                    mainLOG0(mainLOG_CHANNEL_TASK5, "Invalid input. Please enter a valid number.\n");
                 }
                 else {
-                    printf("Reset value: %d\n", input);
+                    prvHandleResetLine(line);
                 }
+                mainLOG0(mainLOG_CHANNEL_TASK5, "Enter '1' to RESET, or '0' to continue: ");
+                length = 0;
+                overflow = 0;
             }
-            else {
-                printf("Invalid input. Please enter a valid number.\n");
-                while (getchar() != '\n'); // Clear input buffer
-            }
-
-            // Relcher le mutex pour permettre aux autres tches de s'excuter
-            xSemaphoreGive(xMutex);
         }
-
-        vTaskDelay(pdMS_TO_TICKS(200)); // Attendre avant la prochaine excution
     }
 }
 
-
-
-
-
 /*-----------------------------------------------------------*/
 /*-----------------------------------------------------------*/
 
@@ -234,66 +903,164 @@ void Task5_ResetHandler(void* pvParameters) {
 /*** SEE THE COMMENTS AT THE TOP OF THIS FILE ***/
 void main_blinky(void)
 {
-    /* Dclaration des variables ncessaires pour les tches et le timer. */
+    /* Déclaration des variables nécessaires pour les tâches et le timer. */
     const TickType_t xTimerPeriod = mainTIMER_SEND_FREQUENCY_MS;
+    TaskHandle_t xTask5Handle = NULL;
 
-    /* Initialisation de la queue, dj utilise dans le code de base. */
-    xQueue = xQueueCreate(mainQUEUE_LENGTH, sizeof(uint32_t));
-    
-    /* Crer le mutex */
-    xMutex = xSemaphoreCreateMutex();
+    /* Initialisation de la queue, déjà utilisée dans le code de base. */
+#if ( mainSTATIC_ALLOCATION == 1 )
+    xQueue = xQueueCreateStatic(mainQUEUE_LENGTH, sizeof(QueueItem_t), xTaskArena.ucQueueStorage, &xTaskArena.xQueue);
+#else
+    xQueue = xQueueCreate(mainQUEUE_LENGTH, sizeof(QueueItem_t));
+#endif
 
-    /* Vrifier que le mutex a t cr avec succs */
-    if (xMutex == NULL)
+#if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+    /* Toutes les cases du pool sont libres au départ. */
+#if ( mainSTATIC_ALLOCATION == 1 )
+    xFreeMessages = xQueueCreateStatic(mainMESSAGE_POOL_LENGTH, sizeof(Message_t*),
+                                       xTaskArena.ucFreeMessagesStorage, &xTaskArena.xFreeMessages);
+#else
+    xFreeMessages = xQueueCreate(mainMESSAGE_POOL_LENGTH, sizeof(Message_t*));
+#endif
+    configASSERT(xFreeMessages != NULL);
+    for (UBaseType_t x = 0; x < mainMESSAGE_POOL_LENGTH; x++)
     {
-        printf("Failed to create mutex!\n");
-        for (; ; ); // Bloque ici si le mutex ne peut tre cr
+        Message_t* pxMessage = &xMessagePool[x];
+        xQueueSend(xFreeMessages, &pxMessage, 0U);
     }
+#endif
+
+    /* Entrée console de la tâche 5 : réveil sur chaque caractère reçu, la
+       tâche n'étant notifiée qu'en fin de ligne. */
+#if ( mainSTATIC_ALLOCATION == 1 )
+    xInputBuffer = xStreamBufferCreateStatic(mainINPUT_BUFFER_SIZE, 1,
+                                             xTaskArena.ucInputStorage, &xTaskArena.xInputBuffer);
+#else
+    xInputBuffer = xStreamBufferCreate(mainINPUT_BUFFER_SIZE, 1);
+#endif
+    configASSERT(xInputBuffer != NULL);
 
+    /* Table de la tâche 4 : vérifie l'en-tête de l'image, sans copie */
+    int iTableStatus = tableDepuisMemoire(&xTask4Table, ullTask4Table, sizeof(ullTask4Table));
+    configASSERT(iTableStatus == 0);
+    ( void ) iTableStatus;
+
+    /* Mémoire de travail de la tâche 4 */
+    areneInit(&xTask4Scratch, mainTASK4_SCRATCH_MEMORY, sizeof(mainTASK4_SCRATCH_MEMORY));
 
     if (xQueue != NULL)
     {
-        /* Ajout des tches spcifiques au TP */
+        /* Ajout des tâches spécifiques au TP */
+
+        // Tâches 1 à 4 : statut, température, multiplication, recherche binaire
+        for (size_t x = 0; x < mainPERIODIC_TASKS; x++)
+        {
+            xPeriodicTasks[x].ulStackDepth = mainPERIODIC_STACK_WORDS;
+#if ( mainSTATIC_ALLOCATION == 1 )
+            prvArenaTake(mainPERIODIC_STACK_WORDS, &xPeriodicTasks[x].pxStackBuffer, &xPeriodicTasks[x].pxTaskBuffer);
+#endif
+        }
+#if ( mainSCHEDULING_EDF == 1 )
+        // En EDF, une tâche refusée par le contrôle d'admission n'est pas créée
+        if (xPeriodicTasksCreateEdf(xPeriodicTasks, mainPERIODIC_TASKS, mainPERIODIC_LOWEST_PRIORITY) != pdPASS)
+        {
+            for (size_t x = 0; x < mainPERIODIC_TASKS; x++)
+            {
+                if (xPeriodicTasks[x].xHandle == NULL && xPeriodicTasks[x].xAdmitted == pdFALSE)
+                {
+                    printf("%s refused: utilization would exceed 1\n", xPeriodicTasks[x].pcName);
+                }
+                else if (xPeriodicTasks[x].xHandle == NULL)
+                {
+                    printf("%s admitted but its task could not be created\n", xPeriodicTasks[x].pcName);
+                }
+            }
+        }
+#else
+        if (xPeriodicTasksCreate(xPeriodicTasks, mainPERIODIC_TASKS, mainPERIODIC_LOWEST_PRIORITY) != pdPASS)
+        {
+            printf("Failed to create the periodic tasks!\n");
+            for (; ; );
+        }
+#endif
 
-        // Tche 1 : Imprime un statut priodique
-        xTaskCreate(Task1_PrintStatus,          // Fonction de la tche
-            "Task1",                    // Nom de la tche
-            configMINIMAL_STACK_SIZE,   // Taille de la pile
-            NULL,                       // Pas de paramtre
-            1,                          // Priorit de la tche
-            NULL);                      // Pas de handle ncessaire
+#if ( mainSMP == 1 )
+        // Chaque tâche périodique sur son coeur, avant le démarrage de l'ordonnanceur
+        for (size_t x = 0; x < mainPERIODIC_TASKS; x++)
+        {
+            vTaskCoreAffinitySet(xPeriodicTasks[x].xHandle, (UBaseType_t)1U << xPeriodicTaskCores[x]);
+        }
+#endif
+
+        // Tâche 5 : Gestion d'un "RESET" avec saisie utilisateur
+        prvCreateTask(Task5_ResetHandler, "Task5", mainTASK5_STACK_WORDS, mainTASK5_PRIORITY, mainIO_CORE, &xTask5Handle);
+        xInputTask = xTask5Handle;
+
+#if ( mainINPUT_STDIN_TASK == 1 )
+        prvCreateTask(prvStdinTask, "Stdin", mainSTDIN_STACK_WORDS, mainSTDIN_TASK_PRIORITY, mainIO_CORE, NULL);
+#endif
 
-        // Tche 2 : Convertit une temprature en Celsius
-        xTaskCreate(Task2_ConvertTemperature, "Task2", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+        /* Fin de l'ajout des tâches spécifiques */
+
+        for (size_t x = 0; x < mainPERIODIC_TASKS; x++)
+        {
+            if (xPeriodicTasks[x].xHandle == NULL) continue;
+            xCreatedTasks[uxCreatedTasks++] = (CreatedTask_t) { xPeriodicTasks[x].pcName, xPeriodicTasks[x].xHandle,
+                                                                xPeriodicTasks[x].ulStackDepth };
+        }
 
-        // Tche 3 : Multiplie deux grands entiers et affiche le rsultat
-        xTaskCreate(Task3_MultiplyLargeNumbers, "Task3", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+#if ( mainTASK_TRACE == 1 )
+        /* Instrumentation des tâches 1 à 5 : période et échéance en ms. */
+        for (size_t x = 0; x < mainPERIODIC_TASKS; x++)
+        {
+            if (xPeriodicTasks[x].xHandle == NULL) continue;
+            xTraceRegisterTask(xPeriodicTasks[x].xHandle, xPeriodicTasks[x].pcName,
+                               xPeriodicTasks[x].xPeriod * portTICK_PERIOD_MS,
+                               xPeriodicTasks[x].xDeadline * portTICK_PERIOD_MS);
+        }
+        xTraceRegisterTask(xTask5Handle, "Task5", 200, 200);
+        prvCreateTask(prvTraceDumpTask, "Trace", mainTRACE_STACK_WORDS, mainTRACE_DUMP_TASK_PRIORITY, mainIO_CORE, NULL);
+#endif
 
-        // Tche 4 : Recherche binaire dans une liste fixe
-        xTaskCreate(Task4_BinarySearch, "Task4", configMINIMAL_STACK_SIZE, NULL, 1, NULL);
+#if ( mainDEFERRED_LOG == 1 )
+        /* Tâche d'affichage des messages des tâches 1 à 5, à la priorité la plus basse. */
+        prvCreateTask(prvLogTask, "Log", mainLOG_STACK_WORDS, mainLOG_TASK_PRIORITY, mainIO_CORE, NULL);
+#endif
 
-        // Tche 5 : Gestion d'un "RESET" avec saisie utilisateur
-        xTaskCreate(Task5_ResetHandler, "Task5", configMINIMAL_STACK_SIZE, NULL, 2, NULL);
+#if ( mainSMP == 1 )
+        /* Charge de chaque coeur, pour vérifier que le second sert. */
+        prvCreateTask(prvLoadReportTask, "Load", mainLOAD_STACK_WORDS, mainLOAD_REPORT_TASK_PRIORITY, mainIO_CORE, NULL);
+#endif
 
-        /* Fin de l'ajout des tches spcifiques */
+        /* Tâches de la démo de base : envoi et réception sur la queue. */
+#if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+        prvCreateTask(prvQueueReceiveTask, "Rx", mainQUEUE_TASK_STACK_WORDS, mainQUEUE_RECEIVE_TASK_PRIORITY, mainCOMPUTE_CORE, &xReceiveTask);
+#else
+        prvCreateTask(prvQueueReceiveTask, "Rx", mainQUEUE_TASK_STACK_WORDS, mainQUEUE_RECEIVE_TASK_PRIORITY, mainCOMPUTE_CORE, NULL);
+#endif
+        prvCreateTask(prvQueueSendTask, "TX", mainQUEUE_TASK_STACK_WORDS, mainQUEUE_SEND_TASK_PRIORITY, mainCOMPUTE_CORE, NULL);
 
-        /* Cration et dmarrage du timer logiciel, dj existant dans le code. */
+        /* Création et démarrage du timer logiciel, déjà existant dans le code. */
+#if ( mainSTATIC_ALLOCATION == 1 )
+        xTimer = xTimerCreateStatic("Timer", xTimerPeriod, pdTRUE, NULL, prvQueueSendTimerCallback, &xTaskArena.xTimer);
+#else
         xTimer = xTimerCreate("Timer",                     //  Timer
             xTimerPeriod,                // Timer period 
             pdTRUE,                      // Auto-reload activated 
             NULL,                        // No specific ID 
             prvQueueSendTimerCallback); // Callback Function
+#endif
 
         if (xTimer != NULL)
         {
             xTimerStart(xTimer, 0); // start timer
         }
 
-        /* Start Scheduler (Demarrage de l'ordonnanceur pour excuter les tches.) */
+        /* Start Scheduler (Demarrage de l'ordonnanceur pour exécuter les tâches.) */
         vTaskStartScheduler();
     }
 
-    /* Cette section sera atteinte uniquement en cas d'chec. */
+    /* Cette section sera atteinte uniquement en cas d'échec. */
     for (; ; )
     {
     }
@@ -325,7 +1092,7 @@ static void prvQueueSendTask( void * pvParameters )
          * write to the console.  0 is used as the block time so the send operation
          * will not block - it shouldn't need to block as the queue should always
          * have at least one space at this point in the code. */
-        xQueueSend( xQueue, &ulValueToSend, 0U );
+        prvSendValue( ulValueToSend );
     }
 }
 /*-----------------------------------------------------------*/
@@ -345,36 +1112,191 @@ static void prvQueueSendTimerCallback( TimerHandle_t xTimerHandle )
     /* Send to the queue - causing the queue receive task to unblock and
      * write out a message.  This function is called from the timer/daemon task, so
      * must not block.  Hence the block time is set to 0. */
-    xQueueSend( xQueue, &ulValueToSend, 0U );
+    prvSendValue( ulValueToSend );
 }
 /*-----------------------------------------------------------*/
 
+static void prvSendValue( uint32_t ulValue )
+{
+    #if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
+    {
+        Message_t * pxMessage;
+
+        /* Take a free buffer and fill it in place.  If the pool is empty the
+         * receiver is behind by mainMESSAGE_POOL_LENGTH messages and this one
+         * is dropped rather than blocking the sender. */
+        if( xQueueReceive( xFreeMessages, &pxMessage, 0U ) == pdPASS )
+        {
+            const char * const pcSender = ( ulValue == mainVALUE_SENT_FROM_TIMER ) ? "software timer" : "task";
+
+            pxMessage->ulValue = ulValue;
+            pxMessage->ulLength = ( uint32_t ) strlen( pcSender );
+            memcpy( pxMessage->ucPayload, pcSender, pxMessage->ulLength );
+
+            /* Only the pointer is copied into the queue. */
+            if( xQueueSend( xQueue, &pxMessage, 0U ) != pdPASS )
+            {
+                xQueueSend( xFreeMessages, &pxMessage, 0U );
+            }
+        }
+    }
+    #elif ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+    {
+        /* The value tells which producer is calling, and so which ring it
+         * owns.  A full ring drops the value, as a full queue does. */
+        SpscRing_t * pxRing = ( ulValue == mainVALUE_SENT_FROM_TIMER ) ? &xTimerRing : &xTaskRing;
+        BaseType_t xWasEmpty;
+
+        if( ( prvRingPush( pxRing, ulValue, &xWasEmpty ) == pdPASS ) && ( xWasEmpty == pdTRUE ) )
+        {
+            /* From an ISR this would be vTaskNotifyGiveFromISR() followed by
+             * portYIELD_FROM_ISR(). */
+            xTaskNotifyGive( xReceiveTask );
+        }
+    }
+    #else /* if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY ) */
+    {
+        xQueueSend( xQueue, &ulValue, 0U );
+    }
+    #endif /* if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY ) */
+}
+/*-----------------------------------------------------------*/
+
+#if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+
+    static BaseType_t prvRingPush( SpscRing_t * pxRing,
+                                   QueueItem_t xItem,
+                                   BaseType_t * pxWasEmpty )
+    {
+        const unsigned ulHead = atomic_load_explicit( &pxRing->ulHead, memory_order_relaxed );
+
+        if( ulHead - atomic_load_explicit( &pxRing->ulTail, memory_order_acquire ) == mainRING_LENGTH )
+        {
+            return pdFAIL;
+        }
+
+        pxRing->xItems[ ulHead & ( mainRING_LENGTH - 1 ) ] = xItem;
+
+        /* Publish the item, then look at the consumer.  Both accesses are
+         * sequentially consistent, as is the consumer's store of ulTail and
+         * its reload of ulHead, so either the consumer sees this item before
+         * it blocks or this push sees the ring it drained and notifies it: a
+         * wake-up can be spurious but never lost. */
+        atomic_store_explicit( &pxRing->ulHead, ulHead + 1U, memory_order_seq_cst );
+        *pxWasEmpty = ( atomic_load_explicit( &pxRing->ulTail, memory_order_seq_cst ) == ulHead ) ? pdTRUE : pdFALSE;
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRingPop( SpscRing_t * pxRing,
+                                  QueueItem_t * pxItem )
+    {
+        const unsigned ulTail = atomic_load_explicit( &pxRing->ulTail, memory_order_relaxed );
+
+        if( atomic_load_explicit( &pxRing->ulHead, memory_order_seq_cst ) == ulTail )
+        {
+            return pdFAIL;
+        }
+
+        *pxItem = pxRing->xItems[ ulTail & ( mainRING_LENGTH - 1 ) ];
+        atomic_store_explicit( &pxRing->ulTail, ulTail + 1U, memory_order_seq_cst );
+
+        return pdPASS;
+    }
+
+#endif /* if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING ) */
+/*-----------------------------------------------------------*/
+
 static void prvQueueReceiveTask( void * pvParameters )
 {
-    uint32_t ulReceivedValue;
+    QueueItem_t xReceivedItem;
 
     /* Prevent the compiler warning about the unused parameter. */
     ( void ) pvParameters;
 
-    for( ; ; )
+    #if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING )
+        for( ; ; )
+        {
+            SpscRing_t * const pxRings[] = { &xTaskRing, &xTimerRing };
+            BaseType_t xReceived = pdFALSE;
+
+            /* Take one value from each ring, or everything they hold with
+             * mainBATCHED_DRAIN set. */
+            for( size_t x = 0; x < sizeof( pxRings ) / sizeof( pxRings[ 0 ] ); x++ )
+            {
+                while( prvRingPop( pxRings[ x ], &xReceivedItem ) == pdPASS )
+                {
+                    prvHandleItem( xReceivedItem );
+                    xReceived = pdTRUE;
+
+                    if( mainBATCHED_DRAIN == 0 )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            /* Block only once both rings were seen empty.  A producer that
+             * pushed meanwhile has left a pending notification, so the take
+             * returns at once. */
+            if( xReceived == pdFALSE )
+            {
+                ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            }
+        }
+    #else /* if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING ) */
+        for( ; ; )
+        {
+            /* Wait until something arrives in the queue - this task will block
+             * indefinitely provided INCLUDE_vTaskSuspend is set to 1 in
+             * FreeRTOSConfig.h.  It will not use any CPU time while it is in the
+             * Blocked state. */
+            xQueueReceive( xQueue, &xReceivedItem, portMAX_DELAY );
+
+            /* With mainBATCHED_DRAIN set, everything that accumulated in the queue
+             * is handled before blocking again, so one wake-up serves many
+             * messages. */
+            do
+            {
+                prvHandleItem( xReceivedItem );
+            } while( ( mainBATCHED_DRAIN == 1 ) && ( xQueueReceive( xQueue, &xReceivedItem, 0U ) == pdPASS ) );
+        }
+    #endif /* if ( mainTRANSPORT == mainTRANSPORT_SPSC_RING ) */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHandleItem( QueueItem_t xItem )
+{
+    /* To get here something must have been received from the queue, but
+     * is it an expected value?  Normally calling printf() from a task is not
+     * a good idea.  Here there is lots of stack space and only one task is
+     * using console IO so it is ok.  However, note the comments at the top of
+     * this file about the risks of making Linux system calls (such as
+     * console output) from a FreeRTOS task. */
+    #if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY )
     {
-        /* Wait until something arrives in the queue - this task will block
-         * indefinitely provided INCLUDE_vTaskSuspend is set to 1 in
-         * FreeRTOSConfig.h.  It will not use any CPU time while it is in the
-         * Blocked state. */
-        xQueueReceive( xQueue, &ulReceivedValue, portMAX_DELAY );
-
-        /* To get here something must have been received from the queue, but
-         * is it an expected value?  Normally calling printf() from a task is not
-         * a good idea.  Here there is lots of stack space and only one task is
-         * using console IO so it is ok.  However, note the comments at the top of
-         * this file about the risks of making Linux system calls (such as
-         * console output) from a FreeRTOS task. */
-        if( ulReceivedValue == mainVALUE_SENT_FROM_TASK )
+        /* The sender's name is read from the pooled buffer, where the sender
+         * wrote it: the payload is never copied. */
+        if( ( xItem->ulValue == mainVALUE_SENT_FROM_TASK ) || ( xItem->ulValue == mainVALUE_SENT_FROM_TIMER ) )
+        {
+            console_print( "Message received from %.*s\n", ( int ) xItem->ulLength, ( const char * ) xItem->ucPayload );
+        }
+        else
+        {
+            console_print( "Unexpected message\n" );
+        }
+
+        /* The buffer is not needed anymore, give it back to the pool. */
+        xQueueSend( xFreeMessages, &xItem, 0U );
+    }
+    #else /* if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY ) */
+    {
+        if( xItem == mainVALUE_SENT_FROM_TASK )
         {
             console_print( "Message received from task\n" );
         }
-        else if( ulReceivedValue == mainVALUE_SENT_FROM_TIMER )
+        else if( xItem == mainVALUE_SENT_FROM_TIMER )
         {
             console_print( "Message received from software timer\n" );
         }
@@ -383,5 +1305,433 @@ static void prvQueueReceiveTask( void * pvParameters )
             console_print( "Unexpected message\n" );
         }
     }
+    #endif /* if ( mainTRANSPORT == mainTRANSPORT_ZERO_COPY ) */
+}
+/*-----------------------------------------------------------*/
+/*-----------------------------------------------------------*/
+
+#if ( mainSTATIC_ALLOCATION == 1 )
+
+    static void prvArenaTake( uint32_t ulStackDepth,
+                              StackType_t ** ppxStack,
+                              StaticTask_t ** ppxTCB )
+    {
+        /* The arena is sized for exactly the tasks of this file. */
+        configASSERT( ulArenaStackUsed + ulStackDepth <= mainARENA_STACK_WORDS );
+        configASSERT( uxArenaTCBsUsed < mainMAX_TASKS );
+
+        *ppxStack = &xTaskArena.xStacks[ ulArenaStackUsed ];
+        *ppxTCB = &xTaskArena.xTCBs[ uxArenaTCBsUsed++ ];
+        ulArenaStackUsed += ulStackDepth;
+    }
+
+#endif /* if ( mainSTATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                 const char * pcName,
+                                 uint32_t ulStackDepth,
+                                 UBaseType_t uxPriority,
+                                 BaseType_t xCore,
+                                 TaskHandle_t * pxCreatedTask )
+{
+    TaskHandle_t xHandle = NULL;
+
+    #if ( mainSMP == 1 )
+        const UBaseType_t uxCoreMask = ( UBaseType_t ) 1U << xCore;
+    #else
+        ( void ) xCore;
+    #endif
+
+    #if ( mainSTATIC_ALLOCATION == 1 )
+    {
+        StackType_t * pxStack;
+        StaticTask_t * pxTCB;
+
+        prvArenaTake( ulStackDepth, &pxStack, &pxTCB );
+        #if ( mainSMP == 1 )
+            xHandle = xTaskCreateStaticAffinitySet( pxTaskCode, pcName, ulStackDepth, NULL, uxPriority, pxStack, pxTCB, uxCoreMask );
+        #else
+            xHandle = xTaskCreateStatic( pxTaskCode, pcName, ulStackDepth, NULL, uxPriority, pxStack, pxTCB );
+        #endif
+    }
+    #elif ( mainSMP == 1 )
+    {
+        if( xTaskCreateAffinitySet( pxTaskCode, pcName, ulStackDepth, NULL, uxPriority, uxCoreMask, &xHandle ) != pdPASS )
+        {
+            xHandle = NULL;
+        }
+    }
+    #else
+    {
+        if( xTaskCreate( pxTaskCode, pcName, ulStackDepth, NULL, uxPriority, &xHandle ) != pdPASS )
+        {
+            xHandle = NULL;
+        }
+    }
+    #endif
+
+    if( pxCreatedTask != NULL )
+    {
+        *pxCreatedTask = xHandle;
+    }
+
+    if( ( xHandle == NULL ) || ( uxCreatedTasks == mainMAX_TASKS ) )
+    {
+        return ( xHandle == NULL ) ? pdFAIL : pdPASS;
+    }
+
+    xCreatedTasks[ uxCreatedTasks++ ] = ( CreatedTask_t ) { pcName, xHandle, ulStackDepth };
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+#if ( mainTASK_TRACE == 1 )
+
+    static void prvReportStackUsage( void )
+    {
+        printf( "task   stack used/size (words)\n" );
+
+        for( UBaseType_t x = 0; x < uxCreatedTasks; x++ )
+        {
+            /* The high-water mark is the smallest free space ever seen. */
+            const uint32_t ulFree = ( uint32_t ) uxTaskGetStackHighWaterMark( xCreatedTasks[ x ].xHandle );
+
+            printf( "%-6s %6lu/%lu\n", xCreatedTasks[ x ].pcName,
+                    ( unsigned long ) ( xCreatedTasks[ x ].ulStackDepth - ulFree ),
+                    ( unsigned long ) xCreatedTasks[ x ].ulStackDepth );
+        }
+
+        #if ( mainSTATIC_ALLOCATION == 1 )
+            printf( "task arena: %lu bytes\n", ( unsigned long ) sizeof( TaskArena_t ) );
+        #endif
+
+        fflush( stdout );
+    }
+
+#endif /* if ( mainTASK_TRACE == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vConsoleInputFromISR( const char * pcChars,
+                           size_t uxLength,
+                           BaseType_t * pxHigherPriorityTaskWoken )
+{
+    /* Characters that do not fit are lost, as on an overrun UART. */
+    ( void ) xStreamBufferSendFromISR( xInputBuffer, pcChars, uxLength, pxHigherPriorityTaskWoken );
+
+    if( ( xInputTask != NULL ) && ( memchr( pcChars, '\n', uxLength ) != NULL ) )
+    {
+        vTaskNotifyGiveFromISR( xInputTask, pxHigherPriorityTaskWoken );
+    }
 }
 /*-----------------------------------------------------------*/
+
+#if ( mainINPUT_STDIN_TASK == 1 )
+
+    static void prvConsoleInput( const char * pcChars,
+                                 size_t uxLength )
+    {
+        ( void ) xStreamBufferSend( xInputBuffer, pcChars, uxLength, 0 );
+
+        if( ( xInputTask != NULL ) && ( memchr( pcChars, '\n', uxLength ) != NULL ) )
+        {
+            xTaskNotifyGive( xInputTask );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStdinTask( void * pvParameters )
+    {
+        struct pollfd xStdin = { STDIN_FILENO, POLLIN, 0 };
+        TickType_t xNextPoll = xTaskGetTickCount();
+        char cBuffer[ 16 ];
+        ssize_t xReceived = 1;
+
+        ( void ) pvParameters;
+
+        while( xReceived != 0 )
+        {
+            /* poll() without a timeout, so that read() only runs when it
+             * returns at once: the task never blocks outside the kernel. */
+            while( ( poll( &xStdin, 1, 0 ) > 0 ) && ( ( xStdin.revents & ( POLLIN | POLLHUP ) ) != 0 ) )
+            {
+                xReceived = read( STDIN_FILENO, cBuffer, sizeof( cBuffer ) );
+
+                if( xReceived <= 0 )
+                {
+                    break;
+                }
+
+                prvConsoleInput( cBuffer, ( size_t ) xReceived );
+            }
+
+            vTaskDelayUntil( &xNextPoll, mainINPUT_POLL_PERIOD_MS );
+        }
+
+        /* End of file: nothing more will come.  Stay blocked rather than
+         * deleted, so that prvReportStackUsage() keeps a valid handle. */
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+    }
+
+#endif /* if ( mainINPUT_STDIN_TASK == 1 ) */
+
+#if ( mainDEFERRED_LOG == 1 )
+
+    static void prvLogWrite( UBaseType_t xChannel,
+                             const char * pcFormat,
+                             const LogArg_t * pxArgs,
+                             size_t uxArgs,
+                             unsigned uxTexts )
+    {
+        LogRing_t * const pxRing = &xLogRings[ xChannel ];
+        const unsigned ulHead = atomic_load_explicit( &pxRing->ulHead, memory_order_relaxed );
+        LogRecord_t * pxRecord;
+        size_t uxUsed = 0;
+
+        if( ulHead - atomic_load_explicit( &pxRing->ulTail, memory_order_acquire ) == mainLOG_RING_LENGTH )
+        {
+            atomic_fetch_add_explicit( &pxRing->ulDropped, 1U, memory_order_relaxed );
+            return;
+        }
+
+        /* A fixed size copy, plus at most mainLOG_TEXT_SIZE bytes of strings:
+         * the cost is bounded whatever the message. */
+        pxRecord = &pxRing->xRecords[ ulHead & ( mainLOG_RING_LENGTH - 1 ) ];
+        pxRecord->pcFormat = pcFormat;
+
+        for( size_t x = 0; x < uxArgs && x < mainLOG_MAX_ARGS; x++ )
+        {
+            pxRecord->xArgs[ x ] = pxArgs[ x ];
+
+            if( ( uxTexts & ( 1U << x ) ) != 0U )
+            {
+                const char * const pcText = pxArgs[ x ].pvValue;
+                size_t uxLength = 0;
+
+                if( uxUsed == mainLOG_TEXT_SIZE )
+                {
+                    pxRecord->xArgs[ x ].pvValue = "";
+                    continue;
+                }
+
+                while( ( uxUsed + uxLength + 1 < mainLOG_TEXT_SIZE ) && ( pcText[ uxLength ] != '\0' ) )
+                {
+                    pxRecord->cText[ uxUsed + uxLength ] = pcText[ uxLength ];
+                    uxLength++;
+                }
+
+                pxRecord->cText[ uxUsed + uxLength ] = '\0';
+                pxRecord->xArgs[ x ].pvValue = &pxRecord->cText[ uxUsed ];
+                uxUsed += uxLength + 1;
+            }
+        }
+
+        atomic_store_explicit( &pxRing->ulHead, ulHead + 1U, memory_order_release );
+    }
+/*-----------------------------------------------------------*/
+
+/* Print a record, one conversion at a time so that each argument is given
+ * to printf() with the type its conversion expects. */
+    static void prvLogPrint( const LogRecord_t * pxRecord )
+    {
+        const char * pcNext = pxRecord->pcFormat;
+        size_t uxArg = 0;
+        char cSpec[ 16 ];
+
+        while( *pcNext != '\0' )
+        {
+            const size_t uxLiteral = strcspn( pcNext, "%" );
+            size_t uxLength;
+            LogArg_t xArg = { 0 };
+            int iLongs = 0;
+
+            fwrite( pcNext, 1, uxLiteral, stdout );
+            pcNext += uxLiteral;
+
+            if( *pcNext == '\0' )
+            {
+                break;
+            }
+
+            if( pcNext[ 1 ] == '%' )
+            {
+                putchar( '%' );
+                pcNext += 2;
+                continue;
+            }
+
+            /* The conversion runs up to and including its conversion character. */
+            uxLength = 1 + strcspn( pcNext + 1, "diuxXcfeEgGsp" );
+
+            if( ( pcNext[ uxLength ] == '\0' ) || ( uxLength + 1 >= sizeof( cSpec ) ) )
+            {
+                fputs( pcNext, stdout );
+                break;
+            }
+
+            memcpy( cSpec, pcNext, uxLength + 1 );
+            cSpec[ uxLength + 1 ] = '\0';
+            pcNext += uxLength + 1;
+
+            if( uxArg < mainLOG_MAX_ARGS )
+            {
+                xArg = pxRecord->xArgs[ uxArg++ ];
+            }
+
+            for( size_t x = 1; x < uxLength; x++ )
+            {
+                iLongs += ( cSpec[ x ] == 'l' );
+            }
+
+            switch( cSpec[ uxLength ] )
+            {
+                case 'f':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                    printf( cSpec, xArg.dValue );
+                    break;
+
+                case 's':
+                    printf( cSpec, ( const char * ) xArg.pvValue );
+                    break;
+
+                case 'p':
+                    printf( cSpec, xArg.pvValue );
+                    break;
+
+                default:
+
+                    if( iLongs >= 2 )
+                    {
+                        printf( cSpec, xArg.llValue );
+                    }
+                    else if( iLongs == 1 )
+                    {
+                        printf( cSpec, ( long ) xArg.llValue );
+                    }
+                    else
+                    {
+                        printf( cSpec, ( int ) xArg.llValue );
+                    }
+
+                    break;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLogTask( void * pvParameters )
+    {
+        unsigned ulReported[ mainLOG_CHANNELS ] = { 0 };
+
+        /* Prevent the compiler warning about the unused parameter. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            for( UBaseType_t xChannel = 0; xChannel < mainLOG_CHANNELS; xChannel++ )
+            {
+                LogRing_t * const pxRing = &xLogRings[ xChannel ];
+                const unsigned ulHead = atomic_load_explicit( &pxRing->ulHead, memory_order_acquire );
+                unsigned ulTail = atomic_load_explicit( &pxRing->ulTail, memory_order_relaxed );
+                const unsigned ulDropped = atomic_load_explicit( &pxRing->ulDropped, memory_order_relaxed );
+
+                for( ; ulTail != ulHead; ulTail++ )
+                {
+                    prvLogPrint( &pxRing->xRecords[ ulTail & ( mainLOG_RING_LENGTH - 1 ) ] );
+
+                    /* Free the slot as soon as it is printed. */
+                    atomic_store_explicit( &pxRing->ulTail, ulTail + 1U, memory_order_release );
+                }
+
+                if( ulDropped != ulReported[ xChannel ] )
+                {
+                    printf( "[log] %u record(s) dropped on channel %lu\n",
+                            ulDropped - ulReported[ xChannel ], ( unsigned long ) xChannel );
+                    ulReported[ xChannel ] = ulDropped;
+                }
+            }
+
+            fflush( stdout );
+            vTaskDelay( mainLOG_DRAIN_PERIOD_MS );
+        }
+    }
+
+#endif /* if ( mainDEFERRED_LOG == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( mainTASK_TRACE == 1 )
+
+    static void prvTraceDumpTask( void * pvParameters )
+    {
+        TickType_t xNextDump = xTaskGetTickCount();
+
+        /* Prevent the compiler warning about the unused parameter. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* Not registered itself, so its own delays are not traced. */
+            vTaskDelayUntil( &xNextDump, mainTRACE_DUMP_PERIOD_MS );
+            vTraceDump();
+            prvReportStackUsage();
+        }
+    }
+
+#endif /* if ( mainTASK_TRACE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( mainSMP == 1 )
+
+    static void prvLoadReportTask( void * pvParameters )
+    {
+        TickType_t xNextReport = xTaskGetTickCount();
+        configRUN_TIME_COUNTER_TYPE ulLastIdle[ configNUMBER_OF_CORES ];
+        configRUN_TIME_COUNTER_TYPE ulLastTotal = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* Prevent the compiler warning about the unused parameter. */
+        ( void ) pvParameters;
+
+        for( BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++ )
+        {
+            ulLastIdle[ xCore ] = ulTaskGetRunTimeCounter( xTaskGetIdleTaskHandleForCore( xCore ) );
+        }
+
+        for( ; ; )
+        {
+            configRUN_TIME_COUNTER_TYPE ulTotal;
+            configRUN_TIME_COUNTER_TYPE ulElapsed;
+
+            vTaskDelayUntil( &xNextReport, mainLOAD_REPORT_PERIOD_MS );
+
+            /* Each core runs for the whole interval, so whatever its idle
+             * task did not use went to the tasks pinned to it.  Unsigned
+             * differences stay right across one wrap of the counter. */
+            ulTotal = portGET_RUN_TIME_COUNTER_VALUE();
+            ulElapsed = ulTotal - ulLastTotal;
+            ulLastTotal = ulTotal;
+
+            for( BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++ )
+            {
+                const configRUN_TIME_COUNTER_TYPE ulIdle = ulTaskGetRunTimeCounter( xTaskGetIdleTaskHandleForCore( xCore ) );
+                const configRUN_TIME_COUNTER_TYPE ulIdleElapsed = ulIdle - ulLastIdle[ xCore ];
+                const unsigned long ulPermille = ( ulElapsed == 0U || ulIdleElapsed >= ulElapsed ) ? 0UL :
+                                                 ( unsigned long ) ( 1000ULL * ( ulElapsed - ulIdleElapsed ) / ulElapsed );
+
+                ulLastIdle[ xCore ] = ulIdle;
+                printf( "[load] core %ld%s: %lu.%lu%% busy\n", ( long ) xCore,
+                        ( xCore == mainIO_CORE ) ? " (io)" : ( xCore == mainCOMPUTE_CORE ) ? " (compute)" : "",
+                        ulPermille / 10UL, ulPermille % 10UL );
+            }
+
+            fflush( stdout );
+        }
+    }
+
+#endif /* if ( mainSMP == 1 ) */
@@ -0,0 +1,248 @@
+/*
+ * Table-driven periodic tasks, see periodic_task.h.
+ */
+
+#include "periodic_task.h"
+
+/* First release of every periodic task: all the tasks start together, as
+ * assumed by the schedulability analysis. */
+static TickType_t xPeriodicStart;
+
+/* The table run under EDF, NULL when running by fixed priority. */
+static PeriodicTask_t * pxEdfTasks = NULL;
+static size_t uxEdfCount = 0;
+static UBaseType_t uxEdfWaitPriority;
+
+#define periodicEDF_WAIT_PRIORITY       ( uxEdfWaitPriority )
+#define periodicEDF_RUN_PRIORITY        ( uxEdfWaitPriority + 1 )
+#define periodicEDF_RELEASE_PRIORITY    ( uxEdfWaitPriority + 2 )
+
+/* Admission control works in millionths of the CPU. */
+#define periodicFULL_UTILIZATION        ( 1000000ULL )
+
+/*-----------------------------------------------------------*/
+
+/* Give the run priority to the active job with the earliest absolute
+ * deadline and the wait priority to the other active jobs.  Called with
+ * the scheduler suspended, so the switches it causes happen on resume. */
+static void prvEdfDispatch( void )
+{
+    /* Deadlines are compared relative to half a tick range behind now, so
+     * both overdue and future deadlines order correctly across a wrap. */
+    const TickType_t xOrigin = xTaskGetTickCount() - ( portMAX_DELAY / 2U );
+    PeriodicTask_t * pxEarliest = NULL;
+
+    for( size_t x = 0; x < uxEdfCount; x++ )
+    {
+        PeriodicTask_t * const pxTask = &pxEdfTasks[ x ];
+
+        if( ( pxTask->xActive == pdTRUE ) &&
+            ( ( pxEarliest == NULL ) ||
+              ( ( TickType_t ) ( pxTask->xAbsoluteDeadline - xOrigin ) < ( TickType_t ) ( pxEarliest->xAbsoluteDeadline - xOrigin ) ) ) )
+        {
+            pxEarliest = pxTask;
+        }
+    }
+
+    for( size_t x = 0; x < uxEdfCount; x++ )
+    {
+        PeriodicTask_t * const pxTask = &pxEdfTasks[ x ];
+        const UBaseType_t uxPriority = ( pxTask == pxEarliest ) ? periodicEDF_RUN_PRIORITY : periodicEDF_WAIT_PRIORITY;
+
+        if( ( pxTask->xActive == pdTRUE ) && ( pxTask->uxPriority != uxPriority ) )
+        {
+            pxTask->uxPriority = uxPriority;
+            vTaskPrioritySet( pxTask->xHandle, uxPriority );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvEdfRelease( PeriodicTask_t * pxTask,
+                           TickType_t xRelease,
+                           TickType_t xDeadline )
+{
+    vTaskSuspendAll();
+    {
+        pxTask->xAbsoluteDeadline = xRelease + xDeadline;
+        pxTask->xActive = pdTRUE;
+        prvEdfDispatch();
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvEdfComplete( PeriodicTask_t * pxTask )
+{
+    vTaskSuspendAll();
+    {
+        /* Block at the release priority, so the next release is registered
+         * at once whatever job is running then. */
+        pxTask->xActive = pdFALSE;
+        pxTask->uxPriority = periodicEDF_RELEASE_PRIORITY;
+        vTaskPrioritySet( NULL, periodicEDF_RELEASE_PRIORITY );
+        prvEdfDispatch();
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void * pvParameters )
+{
+    PeriodicTask_t * const pxTask = ( PeriodicTask_t * ) pvParameters;
+    const TickType_t xDeadline = ( pxTask->xDeadline != 0 ) ? pxTask->xDeadline : pxTask->xPeriod;
+    TickType_t xRelease = xPeriodicStart;
+
+    for( ; ; )
+    {
+        if( pxEdfTasks != NULL )
+        {
+            prvEdfRelease( pxTask, xRelease, xDeadline );
+        }
+
+        pxTask->pvJob();
+
+        if( pxEdfTasks != NULL )
+        {
+            prvEdfComplete( pxTask );
+        }
+
+        /* Tick resolution check only; task_trace.h measures it precisely. */
+        if( ( TickType_t ) ( xTaskGetTickCount() - xRelease ) > xDeadline )
+        {
+            pxTask->uxOverruns++;
+        }
+
+        /* Advances xRelease by exactly one period.  If the job overran the
+         * next release, the call returns at once and that job starts late
+         * instead of being skipped. */
+        vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreate( PeriodicTask_t * pxTask )
+{
+    const uint32_t ulStackDepth = ( pxTask->ulStackDepth != 0 ) ? pxTask->ulStackDepth : configMINIMAL_STACK_SIZE;
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        if( pxTask->pxStackBuffer != NULL )
+        {
+            pxTask->xHandle = xTaskCreateStatic( prvPeriodicTask, pxTask->pcName, ulStackDepth, pxTask,
+                                                 pxTask->uxPriority, pxTask->pxStackBuffer, pxTask->pxTaskBuffer );
+
+            return ( pxTask->xHandle != NULL ) ? pdPASS : pdFAIL;
+        }
+    #endif
+
+    return xTaskCreate( prvPeriodicTask, pxTask->pcName, ulStackDepth,
+                        pxTask, pxTask->uxPriority, &pxTask->xHandle );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPeriodicTasksCreate( PeriodicTask_t * pxTasks,
+                                 size_t uxCount,
+                                 UBaseType_t uxLowestPriority )
+{
+    BaseType_t xResult = pdPASS;
+
+    /* Rate-Monotonic: the priority of a task is the lowest priority plus the
+     * number of distinct periods longer than its own. */
+    for( size_t x = 0; x < uxCount; x++ )
+    {
+        UBaseType_t uxLonger = 0;
+
+        for( size_t y = 0; y < uxCount; y++ )
+        {
+            size_t z = 0;
+
+            if( pxTasks[ y ].xPeriod <= pxTasks[ x ].xPeriod )
+            {
+                continue;
+            }
+
+            /* Count each distinct period once: only its first occurrence. */
+            while( pxTasks[ z ].xPeriod != pxTasks[ y ].xPeriod )
+            {
+                z++;
+            }
+
+            uxLonger += ( z == y );
+        }
+
+        pxTasks[ x ].uxPriority = uxLowestPriority + uxLonger;
+
+        if( pxTasks[ x ].uxPriority >= configMAX_PRIORITIES )
+        {
+            return pdFAIL;
+        }
+    }
+
+    xPeriodicStart = xTaskGetTickCount();
+
+    for( size_t x = 0; x < uxCount; x++ )
+    {
+        pxTasks[ x ].uxOverruns = 0;
+
+        if( prvCreate( &pxTasks[ x ] ) != pdPASS )
+        {
+            xResult = pdFAIL;
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPeriodicTasksCreateEdf( PeriodicTask_t * pxTasks,
+                                    size_t uxCount,
+                                    UBaseType_t uxWaitPriority )
+{
+    BaseType_t xResult = pdPASS;
+    unsigned long long ullUtilization = 0;
+
+    if( ( pxEdfTasks != NULL ) || ( uxWaitPriority + 2 >= configMAX_PRIORITIES ) )
+    {
+        return pdFAIL;
+    }
+
+    pxEdfTasks = pxTasks;
+    uxEdfCount = uxCount;
+    uxEdfWaitPriority = uxWaitPriority;
+    xPeriodicStart = xTaskGetTickCount();
+
+    for( size_t x = 0; x < uxCount; x++ )
+    {
+        PeriodicTask_t * const pxTask = &pxTasks[ x ];
+
+        /* C / T rounded up, so rounding never admits an overload. */
+        const unsigned long long ullTaskUtilization =
+            ( ( unsigned long long ) pxTask->xWcet * periodicFULL_UTILIZATION + pxTask->xPeriod - 1 ) / pxTask->xPeriod;
+
+        pxTask->xHandle = NULL;
+        pxTask->xActive = pdFALSE;
+        pxTask->uxOverruns = 0;
+        pxTask->uxPriority = periodicEDF_RELEASE_PRIORITY;
+        pxTask->xAdmitted = ( ullUtilization + ullTaskUtilization <= periodicFULL_UTILIZATION ) ? pdTRUE : pdFALSE;
+
+        if( pxTask->xAdmitted == pdFALSE )
+        {
+            xResult = pdFAIL;
+            continue;
+        }
+
+        ullUtilization += ullTaskUtilization;
+
+        /* Created at the release priority: the first job registers itself
+         * as soon as the scheduler starts. */
+        if( prvCreate( pxTask ) != pdPASS )
+        {
+            pxTask->xHandle = NULL;
+            ullUtilization -= ullTaskUtilization;
+            xResult = pdFAIL;
+        }
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
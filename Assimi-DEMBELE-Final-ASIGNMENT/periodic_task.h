@@ -0,0 +1,101 @@
+/*
+ * Table-driven periodic tasks.
+ *
+ * Each entry of the table describes one periodic task by its job function,
+ * period and relative deadline.  xPeriodicTasksCreate() gives the tasks
+ * Rate-Monotonic priorities (shorter period, higher priority) and creates
+ * one FreeRTOS task per entry that runs the job once per period.
+ *
+ * Releases are computed with vTaskDelayUntil() from a common start tick, so
+ * job k of a task is released at start + k * period whatever the execution
+ * time of the previous jobs: the period does not drift as it does with
+ * vTaskDelay().  Between releases every task is in the Blocked state on a
+ * kernel delay, with nothing polling and no timer of its own, so with
+ * configUSE_TICKLESS_IDLE set to 1 the idle task can stop the tick and sleep
+ * until the next release.
+ *
+ * xPeriodicTasksCreateEdf() runs the same table under Earliest Deadline
+ * First instead.  FreeRTOS only schedules by fixed priority, so EDF is laid
+ * over three priority levels:
+ *
+ *   wait + 2  release  a task blocked until its next release wakes here,
+ *                      registers the absolute deadline of its job and
+ *                      calls the dispatcher
+ *   wait + 1  run      the one active job with the earliest absolute deadline
+ *   wait      wait     every other active job
+ *
+ * The dispatcher runs with the scheduler suspended at each release and each
+ * job completion, the only instants where the earliest deadline can change,
+ * so a job is preempted as soon as a job with an earlier deadline is
+ * released.  Admission control refuses any entry whose C / T would bring
+ * the total utilization above 1, the EDF bound for D = T (with D < T it is
+ * only necessary: check the set with scheduler --analyse first).
+ *
+ * No other task may use the three EDF levels: a task of the same priority as
+ * the run level would be time sliced with the earliest-deadline job, and one
+ * at the wait level with the jobs EDF holds back.  Place the band strictly
+ * above or below every other application task.
+ */
+
+#ifndef PERIODIC_TASK_H
+#define PERIODIC_TASK_H
+
+#include <stddef.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef struct xPERIODIC_TASK
+{
+    const char * pcName;
+    void ( * pvJob )( void );                  /* One job, called once per period. */
+    TickType_t xPeriod;
+    TickType_t xDeadline;                      /* Relative deadline, 0 for the period. */
+    TickType_t xWcet;                          /* Execution time budget, used by EDF admission control. */
+
+    /* Filled in by xPeriodicTasksCreate(). */
+    UBaseType_t uxPriority;
+    TaskHandle_t xHandle;
+    UBaseType_t uxOverruns;                    /* Jobs that finished after their deadline. */
+    TickType_t xAbsoluteDeadline;              /* EDF: deadline of the current job. */
+    BaseType_t xActive;                        /* EDF: pdTRUE between release and completion. */
+    BaseType_t xAdmitted;                      /* EDF: pdFALSE if refused by admission control. */
+
+    /* Stack depth of the task in words, 0 for configMINIMAL_STACK_SIZE. */
+    uint32_t ulStackDepth;
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        /* Set by the caller to create the task with xTaskCreateStatic()
+         * instead of xTaskCreate(); left NULL, the kernel heap is used.
+         * pxStackBuffer holds ulStackDepth words, which must not be 0. */
+        StackType_t * pxStackBuffer;
+        StaticTask_t * pxTaskBuffer;
+    #endif
+} PeriodicTask_t;
+
+/*
+ * Assign Rate-Monotonic priorities to the uxCount entries of pxTasks and
+ * create their tasks.  The task with the longest period gets uxLowestPriority,
+ * each shorter period the next priority up; tasks with the same period share
+ * a priority.  pxTasks must stay valid while the tasks run (a static table).
+ * Returns pdFAIL, creating nothing, if the priorities would reach
+ * configMAX_PRIORITIES, and pdFAIL as well if a task cannot be created.
+ */
+BaseType_t xPeriodicTasksCreate( PeriodicTask_t * pxTasks,
+                                 size_t uxCount,
+                                 UBaseType_t uxLowestPriority );
+
+/*
+ * Create the uxCount tasks of pxTasks under EDF, on the priorities
+ * uxWaitPriority to uxWaitPriority + 2 (see above).  Entries refused by
+ * admission control are skipped, with a NULL xHandle and xAdmitted set to
+ * pdFALSE; an admitted entry whose task cannot be created also keeps a NULL
+ * xHandle, with xAdmitted pdTRUE, and its utilization is given back.  In both
+ * cases the function returns pdFAIL.  Only one table can be run under EDF.
+ */
+BaseType_t xPeriodicTasksCreateEdf( PeriodicTask_t * pxTasks,
+                                    size_t uxCount,
+                                    UBaseType_t uxWaitPriority );
+
+#endif /* PERIODIC_TASK_H */
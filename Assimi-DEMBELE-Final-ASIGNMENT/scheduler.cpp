@@ -0,0 +1,544 @@
+/*
+ * Native branch-and-bound solver for scheduling.py.
+ *
+ * Reads the task table on stdin, one task per line:
+ *     <name> <C> <T> [<D>]          (D defaults to T)
+ * expands it into the jobs of one hyperperiod exactly like scheduling.py
+ * (job i of task X is "X_i", arrival (i-1)*T, deadline (i-1)*T + D) and
+ * searches for the job order with minimum total waiting time:
+ *
+ *   best_strict      every job must meet its deadline
+ *   best_t5_allowed  jobs of the --skippable task (T5 by default) are skipped
+ *                    when they would miss, as check_schedule_feasibility()
+ *                    does with allow_t5_miss=True
+ *
+ * The result is printed as JSON on stdout.
+ *
+ * The task set first goes through the schedulability tests of analysis.hpp.
+ * A scenario whose task set fails the EDF processor-demand test has no
+ * feasible order and is answered without searching. With --analyse only
+ * the tests are run, on every task set of the input (task sets separated by
+ * blank lines), printing one JSON line per set: this is the fast path for
+ * screening many candidate task sets.
+ *
+ * The jobs come from a JobStream (job_stream.hpp) in arrival order. With
+ * --simulate [HORIZON] no search is done: the stream feeds a
+ * non-preemptive EDF simulation over [0, HORIZON) (one hyperperiod by
+ * default) in O(#tasks) memory, which works for horizons far beyond the
+ * 64 jobs the search supports.
+ *
+ * The search enumerates the same sequences as the permutation brute force,
+ * one job at a time, and evaluates both scenarios in the same pass with an
+ * IncrementalEvaluator (evaluator.hpp). A scenario is pruned for a partial
+ * sequence when:
+ *   - a remaining job can no longer meet its deadline, or the remaining
+ *     demand does not fit before some deadline (processor-demand test);
+ *   - its waiting so far plus a lower bound on the remaining waiting
+ *     (shortest-processing-time order of the jobs already released) cannot
+ *     beat the best complete schedule found so far;
+ *   - it would run the second of two identical jobs (same C, arrival,
+ *     deadline, skippable or not in that scenario) before the first: both
+ *     orders give the same schedule;
+ *   - it leaves the CPU idle waiting for a job while another job could run
+ *     entirely inside that gap (strict scenario only);
+ *   - the same set of scheduled jobs was already reached at the same time
+ *     with less or equal waiting (memoization on (scheduled set, time)).
+ * The search below a prefix stops as soon as both scenarios are pruned.
+ *
+ * --seed SCENARIO ID,ID,... (strict or t5_allowed, repeatable) gives a complete
+ * job order known to be good, typically the best order of a nearby task set
+ * remembered by scheduling.py. If it is feasible for this task set it becomes
+ * the initial best schedule, so the search starts with a tight bound and only
+ * looks for strictly better orders; an infeasible or incomplete seed is ignored.
+ *
+ * --threads N splits the first levels of the search tree into tasks run by
+ * N threads on a work-stealing pool (work_stealing.hpp); 0 uses every core.
+ * The best total waiting found so far is shared, so every thread prunes
+ * with the global bound.
+ *
+ * --memo N caps the memoization entries of the whole search (default 2^23),
+ * split evenly between the threads and the two scenarios, each of which has
+ * its own table; past its share a table stops growing and the search goes
+ * on without it. An entry costs about 60 bytes (unordered_map node and
+ * bucket), so the default peaks near 500 MB whatever the thread count.
+ *
+ * Build: g++ -O2 -std=c++17 -pthread scheduler.cpp -o scheduler
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <thread>
+#include <vector>
+
+#include "analysis.hpp"
+#include "evaluator.hpp"
+#include "job_table.hpp"
+#include "simulate.hpp"
+#include "work_stealing.hpp"
+
+namespace {
+
+struct Schedule {
+    bool found = false;
+    long total_waiting = 0;
+    std::vector<int> order;     // indices into the job table, skipped jobs included
+};
+
+/* A prefix of the search tree handed to the work-stealing pool. */
+struct Subtree {
+    std::vector<int> prefix;
+    std::uint64_t mask = 0;
+    std::array<bool, kScenarios> alive{};
+};
+
+/*
+ * Depth-first branch and bound over job sequences, both scenarios at once.
+ * With several threads the first levels of the tree are split into Subtree
+ * tasks; every thread prunes against the same best totals (atomics), and
+ * keeps its own evaluator and memo tables.
+ */
+class Solver {
+public:
+    /* Default memoization budget of one search, all threads and scenarios. */
+    static constexpr std::size_t kMemoEntries = std::size_t{1} << 23;
+
+    /* enabled[s] is false for a scenario already known to be infeasible;
+     * memo_entries is the memoization budget of the whole search. */
+    Solver(const JobTable& jobs, int threads, std::array<bool, kScenarios> enabled,
+           std::size_t memo_entries = kMemoEntries)
+        : jobs_(jobs), n_(jobs.size()), pool_(threads), enabled_(enabled)
+    {
+        memo_limit_ = memo_entries / (static_cast<std::size_t>(pool_.threads()) * kScenarios);
+
+        // Branch in (arrival, deadline) order: good schedules are found early.
+        branch_order_.resize(n_);
+        std::iota(branch_order_.begin(), branch_order_.end(), 0);
+        std::stable_sort(branch_order_.begin(), branch_order_.end(), [&](int a, int b) {
+            if (jobs_.arrival[a] != jobs_.arrival[b]) return jobs_.arrival[a] < jobs_.arrival[b];
+            return jobs_.deadline[a] < jobs_.deadline[b];
+        });
+
+        // Jobs by deadline, for the processor-demand test.
+        by_deadline_ = branch_order_;
+        std::stable_sort(by_deadline_.begin(), by_deadline_.end(),
+                         [&](int a, int b) { return jobs_.deadline[a] < jobs_.deadline[b]; });
+
+        // Identical jobs: only the first unscheduled one of a group may be chosen.
+        for (int s = 0; s < kScenarios; s++) {
+            twin_before_[s].assign(n_, -1);
+            for (int b = 0; b < n_; b++) {
+                for (int a = b - 1; a >= 0; a--) {
+                    if (jobs_.C[a] == jobs_.C[b] && jobs_.arrival[a] == jobs_.arrival[b] &&
+                        jobs_.deadline[a] == jobs_.deadline[b] && skippable(s, a) == skippable(s, b)) {
+                        twin_before_[s][b] = a;
+                        break;
+                    }
+                }
+            }
+            bound_[s].store(std::numeric_limits<long>::max());
+        }
+        full_ = n_ == 64 ? ~0ULL : ((1ULL << n_) - 1);
+        split_depth_ = pool_.threads() > 1 ? kSplitDepth : 0;
+    }
+
+    /* Start scenario s from a complete order; false if it is not feasible there. */
+    bool seed(int s, const std::vector<int>& order)
+    {
+        if (!enabled_[s] || static_cast<int>(order.size()) != n_) return false;
+        IncrementalEvaluator eval(jobs_);
+        std::uint64_t mask = 0;
+        for (int j : order) {
+            if (j < 0 || j >= n_ || done(mask, j)) return false;
+            mask |= 1ULL << j;
+            eval.push(j);
+        }
+        if (!eval.lane(s).alive) return false;
+        record(s, eval.lane(s), eval.sequence());
+        return true;
+    }
+
+    void solve()
+    {
+        std::vector<Worker> workers;
+        workers.reserve(pool_.threads());
+        for (int w = 0; w < pool_.threads(); w++) {
+            workers.emplace_back(jobs_);
+        }
+
+        Subtree root;
+        root.alive = enabled_;
+        if (!root.alive[kStrict] && !root.alive[kSkipAllowed]) return;
+        pool_.run(std::move(root), [&](int w, const Subtree& task) {
+            Worker& worker = workers[w];
+            worker.eval.reset();
+            for (int j : task.prefix) {
+                worker.eval.push(j);
+            }
+            for (int s = 0; s < kScenarios; s++) {
+                if (!task.alive[s]) worker.eval.kill(s);
+            }
+            search(w, worker, task.mask);
+        });
+
+        for (const Worker& worker : workers) {
+            nodes_ += worker.nodes;
+        }
+    }
+
+    const Schedule& best(int s) const { return best_[s]; }
+    std::uint64_t nodes() const { return nodes_; }
+
+private:
+    struct StateHash {
+        std::size_t operator()(const std::pair<std::uint64_t, int>& k) const
+        {
+            return std::hash<std::uint64_t>()(k.first * 0x9E3779B97F4A7C15ULL ^ static_cast<std::uint64_t>(k.second));
+        }
+    };
+    using Memo = std::unordered_map<std::pair<std::uint64_t, int>, long, StateHash>;
+
+    /* Per-thread search state. */
+    struct Worker {
+        explicit Worker(const JobTable& jobs) : eval(jobs) {}
+        IncrementalEvaluator eval;
+        Memo memo[kScenarios];
+        std::uint64_t nodes = 0;
+    };
+
+
+    // Prefixes shorter than this become pool tasks when running multi-threaded.
+    static constexpr int kSplitDepth = 4;
+
+    bool done(std::uint64_t mask, int j) const { return (mask >> j) & 1ULL; }
+    bool skippable(int s, int j) const { return s == kSkipAllowed && jobs_.skippable[j]; }
+
+    /* False if some mandatory remaining job cannot meet its deadline anymore. */
+    bool feasible(int s, std::uint64_t mask, int t) const
+    {
+        long demand = t;
+        for (int j : by_deadline_) {
+            if (done(mask, j) || skippable(s, j)) continue;
+            if (std::max(t, jobs_.arrival[j]) + jobs_.C[j] > jobs_.deadline[j]) return false;
+            demand += jobs_.C[j];
+            if (demand > jobs_.deadline[j]) return false;
+        }
+        return true;
+    }
+
+    /* Lower bound on the waiting still to come: released mandatory jobs in SPT order. */
+    long waiting_bound(int s, std::uint64_t mask, int t) const
+    {
+        int c[64];
+        int count = 0;
+        long bound = 0;
+        for (int j = 0; j < n_; j++) {
+            if (done(mask, j) || skippable(s, j) || jobs_.arrival[j] > t) continue;
+            bound += t - jobs_.arrival[j];
+            c[count++] = jobs_.C[j];
+        }
+        std::sort(c, c + count);
+        long elapsed = 0;
+        for (int i = 0; i + 1 < count; i++) {
+            elapsed += c[i];
+            bound += elapsed;
+        }
+        return bound;
+    }
+
+    /* True if a mandatory job other than j fits entirely in the idle gap [t, arrival of j). */
+    bool fills_gap(std::uint64_t mask, int t, int j) const
+    {
+        const int gap_end = jobs_.arrival[j];
+        for (int k = 0; k < n_; k++) {
+            if (k == j || done(mask, k) || jobs_.skippable[k]) continue;
+            const int finish = std::max(t, jobs_.arrival[k]) + jobs_.C[k];
+            if (finish <= gap_end && finish <= jobs_.deadline[k]) return true;
+        }
+        return false;
+    }
+
+    /* True if the prefix cannot lead to a better schedule in scenario s. */
+    bool pruned(Worker& worker, int s, std::uint64_t mask)
+    {
+        const Lane& lane = worker.eval.lane(s);
+        if (!feasible(s, mask, lane.time)) return true;
+        if (lane.waiting + waiting_bound(s, mask, lane.time) >= bound_[s].load(std::memory_order_relaxed)) return true;
+
+        Memo& memo = worker.memo[s];
+        auto key = std::make_pair(mask, lane.time);
+        auto it = memo.find(key);
+        if (it != memo.end()) {
+            if (it->second <= lane.waiting) return true;
+            it->second = lane.waiting;
+        } else if (memo.size() < memo_limit_) {
+            memo.emplace(key, lane.waiting);
+        }
+        return false;
+    }
+
+    void record(int s, const Lane& lane, const std::vector<int>& sequence)
+    {
+        std::lock_guard<std::mutex> lock(best_mutex_);
+        if (!best_[s].found || lane.waiting < best_[s].total_waiting) {
+            best_[s].found = true;
+            best_[s].total_waiting = lane.waiting;
+            best_[s].order = sequence;
+            bound_[s].store(lane.waiting, std::memory_order_relaxed);
+        }
+    }
+
+    void search(int w, Worker& worker, std::uint64_t mask)
+    {
+        IncrementalEvaluator& eval = worker.eval;
+        worker.nodes++;
+        for (int s = 0; s < kScenarios; s++) {
+            if (!eval.lane(s).alive) continue;
+            if (mask == full_) {
+                record(s, eval.lane(s), eval.sequence());
+            } else if (pruned(worker, s, mask)) {
+                eval.kill(s);
+            }
+        }
+        if (mask == full_ || !eval.any_alive()) return;
+
+        const bool split = static_cast<int>(eval.sequence().size()) < split_depth_;
+        for (int j : branch_order_) {
+            if (done(mask, j)) continue;
+
+            // Scenarios in which choosing j now is dominated by another choice.
+            bool excluded[kScenarios];
+            for (int s = 0; s < kScenarios; s++) {
+                const Lane& lane = eval.lane(s);
+                excluded[s] = twin_before_[s][j] >= 0 && !done(mask, twin_before_[s][j]);
+                if (s == kStrict && !excluded[s] && lane.alive && jobs_.arrival[j] > lane.time) {
+                    excluded[s] = fills_gap(mask, lane.time, j);
+                }
+            }
+
+            eval.push(j);
+            for (int s = 0; s < kScenarios; s++) {
+                if (excluded[s]) eval.kill(s);
+            }
+            if (eval.any_alive()) {
+                if (split) {
+                    Subtree task;
+                    task.prefix = eval.sequence();
+                    task.mask = mask | (1ULL << j);
+                    for (int s = 0; s < kScenarios; s++) {
+                        task.alive[s] = eval.lane(s).alive;
+                    }
+                    pool_.push(w, std::move(task));
+                } else {
+                    search(w, worker, mask | (1ULL << j));
+                }
+            }
+            eval.pop();
+        }
+    }
+
+    const JobTable& jobs_;
+    int n_;
+    WorkStealingPool<Subtree> pool_;
+    std::array<bool, kScenarios> enabled_;
+    int split_depth_ = 0;
+    std::size_t memo_limit_ = 0;    // entries per memo table
+    std::uint64_t full_ = 0;
+    std::vector<int> branch_order_;
+    std::vector<int> by_deadline_;
+    std::vector<int> twin_before_[kScenarios];
+    std::atomic<long> bound_[kScenarios];
+    std::mutex best_mutex_;
+    Schedule best_[kScenarios];
+    std::uint64_t nodes_ = 0;
+};
+
+void print_schedule(const char* key, const Schedule& s, const JobTable& jobs,
+                    const std::vector<Task>& tasks, std::uint64_t nodes, bool last)
+{
+    std::cout << "  \"" << key << "\": ";
+    if (!s.found) {
+        std::cout << "null";
+    } else {
+        std::cout << "{\"total_waiting\": " << s.total_waiting << ", \"nodes\": " << nodes << ", \"order\": [";
+        for (std::size_t i = 0; i < s.order.size(); i++) {
+            std::cout << (i ? ", " : "") << '"' << job_id(jobs, tasks, s.order[i]) << '"';
+        }
+        std::cout << "]}";
+    }
+    std::cout << (last ? "\n" : ",\n");
+}
+
+void print_analysis(const Analysis& a, const Analysis& relaxed, const std::vector<Task>& tasks,
+                    const std::string& skippable)
+{
+    std::cout << "{\"utilization\": " << a.utilization << ", \"liu_layland_bound\": " << a.liu_layland_bound
+              << ", \"liu_layland\": " << (a.liu_layland ? "true" : "false")
+              << ", \"hyperbolic\": " << (a.hyperbolic ? "true" : "false") << ", \"rm_response_times\": {";
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        std::cout << (i ? ", " : "") << '"' << tasks[i].name << "\": ";
+        if (a.response[i] < 0) {
+            std::cout << "null";
+        } else {
+            std::cout << a.response[i];
+        }
+    }
+    std::cout << "}, \"rm_feasible\": " << (a.rm_feasible ? "true" : "false")
+              << ", \"edf_feasible\": " << (a.edf_feasible ? "true" : "false")
+              << ", \"edf_feasible_without_" << skippable << "\": " << (relaxed.edf_feasible ? "true" : "false") << "}";
+}
+
+int skippable_index(const std::vector<Task>& tasks, const std::string& skippable)
+{
+    for (int i = 0; i < static_cast<int>(tasks.size()); i++) {
+        if (tasks[i].name == skippable) return i;
+    }
+    return -1;
+}
+
+/* Read tasks up to a blank line or the end of input; false on a malformed line. */
+bool read_task_set(std::istream& input, std::vector<Task>& tasks, bool stop_at_blank)
+{
+    std::string line;
+    while (std::getline(input, line)) {
+        std::istringstream in(line);
+        Task t;
+        if (!(in >> t.name)) {
+            if (stop_at_blank && !tasks.empty()) break;
+            continue;
+        }
+        if (!(in >> t.C >> t.T) || t.C <= 0 || t.T <= 0) {
+            std::cerr << "scheduler: bad task line: " << line << "\n";
+            return false;
+        }
+        if (!(in >> t.D)) t.D = t.T;
+        tasks.push_back(t);
+    }
+    return true;
+}
+
+/* Job indices of a comma-separated list of job ids; false on an unknown id. */
+bool parse_order(const std::string& list, const JobTable& jobs, const std::vector<Task>& tasks,
+                 std::vector<int>& order)
+{
+    std::unordered_map<std::string, int> index;
+    for (int j = 0; j < jobs.size(); j++) {
+        index.emplace(job_id(jobs, tasks, j), j);
+    }
+    std::istringstream in(list);
+    std::string id;
+    while (std::getline(in, id, ',')) {
+        auto it = index.find(id);
+        if (it == index.end()) return false;
+        order.push_back(it->second);
+    }
+    return true;
+}
+
+int usage()
+{
+    std::cerr << "usage: scheduler [--skippable TASK] [--threads N] [--memo ENTRIES] [--seed strict|t5_allowed ID,...]"
+                 " [--analyse | --simulate [HORIZON]] < tasks.txt\n";
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::string skippable = "T5";
+    int threads = 1;
+    std::size_t memo_entries = Solver::kMemoEntries;
+    bool analyse_only = false;
+    bool simulate = false;
+    long horizon = 0;
+    std::string seeds[kScenarios];
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--skippable") == 0 && i + 1 < argc) {
+            skippable = argv[++i];
+        } else if (std::strcmp(argv[i], "--simulate") == 0) {
+            simulate = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') horizon = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--analyse") == 0) {
+            analyse_only = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 2 < argc) {
+            const std::string scenario = argv[++i];
+            if (scenario != "strict" && scenario != "t5_allowed") return usage();
+            seeds[scenario == "strict" ? kStrict : kSkipAllowed] = argv[++i];
+        } else if (std::strcmp(argv[i], "--memo") == 0 && i + 1 < argc) {
+            memo_entries = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+            if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+        } else {
+            return usage();
+        }
+    }
+
+    if (analyse_only) {
+        while (std::cin) {
+            std::vector<Task> tasks;
+            if (!read_task_set(std::cin, tasks, true)) return 2;
+            if (tasks.empty()) break;
+            print_analysis(analyse(tasks), analyse(tasks, skippable_index(tasks, skippable)), tasks, skippable);
+            std::cout << "\n";
+        }
+        return 0;
+    }
+
+    std::vector<Task> tasks;
+    if (!read_task_set(std::cin, tasks, false)) return 2;
+    if (tasks.empty()) return usage();
+
+    const Analysis full = analyse(tasks);
+    const Analysis relaxed = analyse(tasks, skippable_index(tasks, skippable));
+
+    const long hyper = hyperperiod(tasks);
+    if (simulate) {
+        if (horizon <= 0) horizon = hyper;
+        const SimulationResult r = simulate_edf(tasks, horizon, skippable_index(tasks, skippable));
+        std::cout << "{\"horizon\": " << horizon << ", \"jobs\": " << r.jobs << ", \"skipped\": " << r.skipped
+                  << ", \"total_waiting\": " << r.total_waiting << ", \"max_waiting\": " << r.max_waiting
+                  << ", \"max_ready\": " << r.max_ready << ", \"deadline_misses\": {";
+        for (std::size_t i = 0; i < tasks.size(); i++) {
+            std::cout << (i ? ", " : "") << '"' << tasks[i].name << "\": " << r.misses[i];
+        }
+        std::cout << "}}\n";
+        return 0;
+    }
+
+    const long count = job_count(tasks, hyper);
+    if (count > 64) {
+        std::cerr << "scheduler: " << count << " jobs in the hyperperiod, at most 64 are supported\n";
+        return 1;
+    }
+    const JobTable jobs = build_job_table(tasks, hyper, skippable);
+
+    Solver solver(jobs, threads, {full.edf_feasible, relaxed.edf_feasible}, memo_entries);
+    for (int s = 0; s < kScenarios; s++) {
+        std::vector<int> order;
+        if (!seeds[s].empty() && parse_order(seeds[s], jobs, tasks, order)) {
+            solver.seed(s, order);
+        }
+    }
+    solver.solve();
+
+    std::cout << "{\n  \"hyperperiod\": " << hyper << ",\n  \"jobs\": " << jobs.size() << ",\n  \"analysis\": ";
+    print_analysis(full, relaxed, tasks, skippable);
+    std::cout << ",\n";
+    print_schedule("best_strict", solver.best(kStrict), jobs, tasks, solver.nodes(), false);
+    print_schedule("best_t5_allowed", solver.best(kSkipAllowed), jobs, tasks, solver.nodes(), true);
+    std::cout << "}\n";
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Schedule simulations driven by a JobStream.
+ *
+ * simulate_edf(): non-preemptive EDF.
+ *
+ * Jobs are pulled from the stream as time reaches their arrival and kept in
+ * a ready queue ordered by absolute deadline; the CPU runs the ready job
+ * with the earliest deadline to completion, or idles until the next
+ * arrival. Memory is O(#tasks + backlog), so horizons of millions of ticks
+ * are simulated without building the job list. Jobs of the skippable task
+ * that would miss are dropped, as in scenario B of scheduling.py.
+ *
+ * simulate_preemptive(): preemptive fixed-priority (Rate-Monotonic order)
+ * or EDF, the two dispatch modes of periodic_task.c in main_blinky. A job
+ * that misses its deadline still runs to completion, as it does there, and
+ * waiting counts the time a job is ready but not running.
+ */
+
+#ifndef SIMULATE_HPP
+#define SIMULATE_HPP
+
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "job_stream.hpp"
+#include "task_set.hpp"
+
+struct SimulationResult {
+    long jobs = 0;
+    long total_waiting = 0;
+    long max_waiting = 0;
+    long skipped = 0;
+    std::size_t max_ready = 0;
+    std::vector<long> misses;       // deadline misses per task
+};
+
+inline SimulationResult simulate_edf(const std::vector<Task>& tasks, long horizon, int skippable)
+{
+    using Ready = std::tuple<long, long, int, long>;    // (deadline, arrival, task, instance)
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+    JobStream stream(tasks, horizon);
+    SimulationResult r;
+    r.misses.assign(tasks.size(), 0);
+
+    long t = 0;
+    StreamJob job;
+    while (!stream.empty() || !ready.empty()) {
+        if (ready.empty() && stream.next_arrival() > t) t = stream.next_arrival();
+        while (!stream.empty() && stream.next_arrival() <= t) {
+            stream.next(job);
+            ready.push({job.deadline, job.arrival, job.task, job.instance});
+        }
+        r.max_ready = std::max(r.max_ready, ready.size());
+
+        const auto [deadline, arrival, k, instance] = ready.top();
+        ready.pop();
+        (void)instance;
+        const long finish = t + tasks[k].C;
+        if (finish > deadline && k == skippable) {
+            r.skipped++;
+            continue;
+        }
+        if (finish > deadline) r.misses[k]++;
+        r.jobs++;
+        r.total_waiting += t - arrival;
+        r.max_waiting = std::max(r.max_waiting, t - arrival);
+        t = finish;
+    }
+    return r;
+}
+
+enum class Policy { kFixedPriority, kEdf };
+
+inline SimulationResult simulate_preemptive(const std::vector<Task>& tasks, long horizon, Policy policy)
+{
+    // Rate-Monotonic rank: shorter period first, ties in table order.
+    std::vector<long> rank(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        rank[i] = 0;
+        for (std::size_t j = 0; j < tasks.size(); j++) {
+            rank[i] += tasks[j].T < tasks[i].T || (tasks[j].T == tasks[i].T && j < i);
+        }
+    }
+
+    using Ready = std::tuple<long, long, int, long>;    // (key, arrival, task, remaining)
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+    JobStream stream(tasks, horizon);
+    SimulationResult r;
+    r.misses.assign(tasks.size(), 0);
+
+    long t = 0;
+    StreamJob job;
+    while (!stream.empty() || !ready.empty()) {
+        if (ready.empty() && stream.next_arrival() > t) t = stream.next_arrival();
+        while (!stream.empty() && stream.next_arrival() <= t) {
+            stream.next(job);
+            const long key = policy == Policy::kEdf ? job.deadline : rank[job.task];
+            ready.push({key, job.arrival, job.task, job.C});
+        }
+        r.max_ready = std::max(r.max_ready, ready.size());
+
+        // Run the top job until it finishes or the next release may preempt it.
+        auto [key, arrival, k, remaining] = ready.top();
+        ready.pop();
+        const long slice = stream.empty() ? remaining : std::min(remaining, stream.next_arrival() - t);
+        t += slice;
+        remaining -= slice;
+        if (remaining > 0) {
+            ready.push({key, arrival, k, remaining});
+            continue;
+        }
+        const long waiting = t - arrival - tasks[k].C;
+        if (t > arrival + tasks[k].D) r.misses[k]++;
+        r.jobs++;
+        r.total_waiting += waiting;
+        r.max_waiting = std::max(r.max_waiting, waiting);
+    }
+    return r;
+}
+
+#endif
@@ -0,0 +1,379 @@
+/*
+ * Host-side discrete-event simulator of the main_blinky.c task set.
+ *
+ * Reads a task table (main_blinky.tasks describes the default build of
+ * main_blinky.c) and simulates it with event_simulator.hpp, without the
+ * FreeRTOS port: response-time distribution, deadline misses and mutex
+ * blocking of every task, occupancy and drops of every queue.  This is the
+ * way to size mainQUEUE_LENGTH, the log rings and the priorities for a
+ * higher load before trying it on the target.
+ *
+ * Table, one declaration per line, '#' to the end of a line is a comment:
+ *
+ *     tick   <time>                              (default 1ms)
+ *     queue  <name> <length>
+ *     mutex  <name>
+ *     source <name> <queue> periodic <T> [offset=<time>]
+ *     source <name> <queue> sporadic <min> <max> [offset=<time>]
+ *     task   <name> <priority> periodic <T> [offset=<time>] [deadline=<time>] : <steps>
+ *     task   <name> <priority> loop [deadline=<time>] : <steps>
+ *
+ * A periodic task runs its steps once per period (vTaskDelayUntil), with a
+ * deadline of one period by default; a loop task runs them back to back,
+ * and if it starts with a receive each job is timed from the arrival of the
+ * item it receives.  A source is an interrupt pushing an item into a queue.
+ * Steps are separated by ';':
+ *
+ *     run <time>[-<time>]     compute, uniformly between the two bounds
+ *     lock <mutex>            xSemaphoreTake(mutex, portMAX_DELAY)
+ *     unlock <mutex>          xSemaphoreGive(mutex)
+ *     send <queue>            xQueueSend(queue, ..., 0): dropped when full
+ *     recv <queue>            xQueueReceive(queue, ..., portMAX_DELAY)
+ *     drain <queue> <time>    take every item there, computing <time> for each
+ *     delay <time>            vTaskDelay()
+ *
+ * A time is a number of ticks, or a number followed by us, ms or s.
+ *
+ * Usage: simulate_blinky [--horizon SECONDS] [--seed N] [--scale-c X] [--rate X]
+ *                        [--queue NAME=LENGTH] [--priority TASK=P] [TABLE]
+ *   --scale-c  multiplies every execution time, --rate the frequency of every
+ *              source; --queue and --priority override the table.  The table
+ *              is read on stdin when no file is given.
+ *
+ * Build: g++ -O2 -std=c++17 simulate_blinky.cpp -o simulate_blinky
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "event_simulator.hpp"
+
+namespace {
+
+/* Index of the item called name, -1 if absent. */
+template <typename T, typename Name>
+int find(const std::vector<T>& items, const std::string& name, Name name_of)
+{
+    for (std::size_t i = 0; i < items.size(); i++) {
+        if (name_of(items[i]) == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int find_queue(const Model& m, const std::string& name)
+{
+    return find(m.queues, name, [](const ModelQueue& q) { return q.name; });
+}
+
+int find_mutex(const Model& m, const std::string& name)
+{
+    return find(m.mutexes, name, [](const std::string& s) { return s; });
+}
+
+int find_task(const Model& m, const std::string& name)
+{
+    return find(m.tasks, name, [](const ModelTask& t) { return t.name; });
+}
+
+/* Ticks, or a number with a us / ms / s suffix; false if malformed. */
+bool parse_time(const std::string& text, Time tick, Time& out)
+{
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (end == text.c_str() || value < 0) return false;
+    const std::string unit(end);
+    double us;
+    if (unit.empty()) {
+        us = value * tick;
+    } else if (unit == "us") {
+        us = value;
+    } else if (unit == "ms") {
+        us = value * 1e3;
+    } else if (unit == "s") {
+        us = value * 1e6;
+    } else {
+        return false;
+    }
+    out = static_cast<Time>(std::llround(us));
+    return true;
+}
+
+/* "key=value" options at the end of a declaration. */
+bool parse_options(std::istringstream& in, Time tick, Time* offset, Time* deadline)
+{
+    std::string word;
+    while (in >> word) {
+        const std::size_t eq = word.find('=');
+        const std::string key = word.substr(0, eq);
+        Time* target = key == "offset" ? offset : key == "deadline" ? deadline : nullptr;
+        if (eq == std::string::npos || target == nullptr || !parse_time(word.substr(eq + 1), tick, *target)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_step(const std::string& text, const Model& m, Step& step)
+{
+    std::istringstream in(text);
+    std::string op, arg, extra;
+    if (!(in >> op >> arg)) return false;
+    if (op == "run") {
+        step.kind = StepKind::kRun;
+        const std::size_t dash = arg.find('-');
+        if (!parse_time(arg.substr(0, dash), m.tick, step.min)) return false;
+        step.max = step.min;
+        if (dash != std::string::npos && !parse_time(arg.substr(dash + 1), m.tick, step.max)) return false;
+        return step.max >= step.min && !(in >> extra);
+    }
+    if (op == "delay") {
+        step.kind = StepKind::kDelay;
+        return parse_time(arg, m.tick, step.min) && !(in >> extra);
+    }
+    if (op == "lock" || op == "unlock") {
+        step.kind = op == "lock" ? StepKind::kLock : StepKind::kUnlock;
+        step.object = find_mutex(m, arg);
+        return step.object >= 0 && !(in >> extra);
+    }
+    if (op == "send" || op == "recv" || op == "drain") {
+        step.kind = op == "send" ? StepKind::kSend : op == "recv" ? StepKind::kReceive : StepKind::kDrain;
+        step.object = find_queue(m, arg);
+        if (step.object < 0) return false;
+        if (step.kind == StepKind::kDrain && !(in >> extra && parse_time(extra, m.tick, step.min))) return false;
+        return !(in >> extra);
+    }
+    return false;
+}
+
+/* A loop task must give the CPU back somewhere, or nothing below it runs. */
+bool yields(const ModelTask& t)
+{
+    if (t.period > 0) return true;
+    for (const Step& s : t.steps) {
+        if (s.kind == StepKind::kReceive || s.kind == StepKind::kDelay) return true;
+    }
+    return false;
+}
+
+bool parse_line(const std::string& raw, Model& m)
+{
+    const std::string line = raw.substr(0, raw.find('#'));
+    const std::size_t colon = line.find(':');
+    std::istringstream in(line.substr(0, colon));
+    std::string kind, name;
+    if (!(in >> kind)) return true;
+    if (kind != "tick" && !(in >> name)) return false;
+
+    if (kind == "tick") {
+        std::string value;
+        return in >> value && parse_time(value, 1, m.tick) && m.tick > 0;
+    }
+    if (kind == "queue") {
+        ModelQueue q{name, 0};
+        m.queues.push_back(q);
+        return in >> m.queues.back().length && m.queues.back().length > 0;
+    }
+    if (kind == "mutex") {
+        m.mutexes.push_back(name);
+        return true;
+    }
+    if (kind == "source") {
+        ModelSource s;
+        std::string queue, release, gap;
+        s.name = name;
+        if (!(in >> queue >> release >> gap) || (s.queue = find_queue(m, queue)) < 0) return false;
+        if (!parse_time(gap, m.tick, s.min_gap)) return false;
+        s.max_gap = s.min_gap;
+        if (release == "sporadic") {
+            if (!(in >> gap) || !parse_time(gap, m.tick, s.max_gap) || s.max_gap < s.min_gap) return false;
+        } else if (release != "periodic") {
+            return false;
+        }
+        if (!parse_options(in, m.tick, &s.offset, nullptr) || s.max_gap <= 0) return false;
+        m.sources.push_back(s);
+        return true;
+    }
+    if (kind == "task") {
+        ModelTask t;
+        std::string release;
+        t.name = name;
+        if (!(in >> t.priority >> release) || t.priority < 0 || colon == std::string::npos) return false;
+        if (release == "periodic") {
+            std::string period;
+            if (!(in >> period) || !parse_time(period, m.tick, t.period) || t.period <= 0) return false;
+            t.deadline = t.period;
+        } else if (release != "loop") {
+            return false;
+        }
+        if (!parse_options(in, m.tick, t.period > 0 ? &t.offset : nullptr, &t.deadline)) return false;
+
+        std::istringstream steps(line.substr(colon + 1));
+        std::string text;
+        while (std::getline(steps, text, ';')) {
+            if (text.find_first_not_of(" \t\r") == std::string::npos) continue;
+            Step step{StepKind::kRun};
+            if (!parse_step(text, m, step)) return false;
+            t.steps.push_back(step);
+        }
+        if (!yields(t)) return false;
+        m.tasks.push_back(t);
+        return true;
+    }
+    return false;
+}
+
+bool read_model(std::istream& input, Model& m)
+{
+    std::string line;
+    for (int n = 1; std::getline(input, line); n++) {
+        if (!parse_line(line, m)) {
+            std::cerr << "simulate_blinky: line " << n << ": bad declaration: " << line << "\n";
+            return false;
+        }
+    }
+    if (m.tasks.empty()) {
+        std::cerr << "simulate_blinky: no task in the table\n";
+        return false;
+    }
+    return true;
+}
+
+/* NAME=VALUE of --queue and --priority. */
+bool parse_override(const std::string& arg, std::string& name, int& value)
+{
+    const std::size_t eq = arg.find('=');
+    if (eq == std::string::npos) return false;
+    name = arg.substr(0, eq);
+    char* end = nullptr;
+    value = static_cast<int>(std::strtol(arg.c_str() + eq + 1, &end, 10));
+    return *end == '\0' && end != arg.c_str() + eq + 1;
+}
+
+double ms(Time us) { return us / 1000.0; }
+
+void print_report(const Model& m, const EventSimulator& sim, Time horizon, double seconds)
+{
+    const double ticks = static_cast<double>(horizon) / m.tick;
+    Time busy = 0;
+    for (const TaskStats& s : sim.task_stats()) busy += s.busy;
+    std::printf("horizon %.1f s (%.0f ticks), %ld events in %.3f s: %.1f M ticks/s, cpu %.2f %% busy\n\n",
+                horizon / 1e6, ticks, sim.events(), seconds, seconds > 0 ? ticks / seconds / 1e6 : 0.0,
+                100.0 * busy / horizon);
+
+    std::printf("%-8s %4s %9s %7s %10s %10s %10s %10s %7s %11s\n", "task", "prio", "jobs", "cpu %", "resp p50",
+                "p90", "p99", "max (ms)", "misses", "blocked max");
+    for (std::size_t k = 0; k < m.tasks.size(); k++) {
+        const TaskStats& s = sim.task_stats()[k];
+        std::printf("%-8s %4d %9ld %7.3f %10.3f %10.3f %10.3f %10.3f %7ld %11.3f\n", m.tasks[k].name.c_str(),
+                    m.tasks[k].priority, s.jobs, 100.0 * s.busy / horizon, ms(s.response.percentile(0.5)),
+                    ms(s.response.percentile(0.9)), ms(s.response.percentile(0.99)), ms(s.response.max()),
+                    s.misses, ms(s.blocked.max()));
+    }
+
+    std::printf("\n%-8s %6s %9s %7s %8s %9s %12s %10s   %s\n", "queue", "length", "sends", "drops", "max fill",
+                "mean fill", "wait p99", "max (ms)", "time at fill 0, 1, ... (%)");
+    for (std::size_t q = 0; q < m.queues.size(); q++) {
+        const QueueStats& s = sim.queue_stats()[q];
+        double mean = 0.0;
+        std::string fills;
+        for (std::size_t i = 0; i < s.time_at_fill.size(); i++) {
+            mean += static_cast<double>(i) * s.time_at_fill[i] / horizon;
+            char cell[16];
+            std::snprintf(cell, sizeof(cell), "%s%.3g", i ? " " : "", 100.0 * s.time_at_fill[i] / horizon);
+            fills += cell;
+        }
+        std::printf("%-8s %6d %9ld %7ld %8d %9.4f %12.3f %10.3f   %s\n", m.queues[q].name.c_str(),
+                    m.queues[q].length, s.sends, s.drops, s.max_fill, mean, ms(s.wait.percentile(0.99)),
+                    ms(s.wait.max()), fills.c_str());
+    }
+
+    if (!m.mutexes.empty()) {
+        std::printf("\n%-8s %9s %10s %12s %10s\n", "mutex", "takes", "contended", "wait p99", "max (ms)");
+        for (std::size_t i = 0; i < m.mutexes.size(); i++) {
+            const MutexStats& s = sim.mutex_stats()[i];
+            std::printf("%-8s %9ld %10ld %12.3f %10.3f\n", m.mutexes[i].c_str(), s.takes, s.contended,
+                        ms(s.wait.percentile(0.99)), ms(s.wait.max()));
+        }
+    }
+}
+
+int usage()
+{
+    std::cerr << "usage: simulate_blinky [--horizon SECONDS] [--seed N] [--scale-c X] [--rate X]"
+                 " [--queue NAME=LENGTH] [--priority TASK=P] [TABLE]\n";
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    double horizon_s = 3600.0;
+    unsigned seed = 2463534242u;
+    Load load;
+    std::vector<std::string> queue_overrides, priority_overrides;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--horizon") == 0 && i + 1 < argc) {
+            horizon_s = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--scale-c") == 0 && i + 1 < argc) {
+            load.compute = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            load.rate = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--queue") == 0 && i + 1 < argc) {
+            queue_overrides.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--priority") == 0 && i + 1 < argc) {
+            priority_overrides.push_back(argv[++i]);
+        } else if (argv[i][0] != '-' || std::strcmp(argv[i], "-") == 0) {
+            path = std::strcmp(argv[i], "-") == 0 ? nullptr : argv[i];
+        } else {
+            return usage();
+        }
+    }
+    if (horizon_s <= 0 || load.compute < 0 || load.rate <= 0) return usage();
+
+    Model model;
+    if (path != nullptr) {
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "simulate_blinky: cannot open " << path << "\n";
+            return 2;
+        }
+        if (!read_model(file, model)) return 2;
+    } else if (!read_model(std::cin, model)) {
+        return 2;
+    }
+
+    for (const std::string& arg : queue_overrides) {
+        std::string name;
+        int length;
+        const int q = parse_override(arg, name, length) ? find_queue(model, name) : -1;
+        if (q < 0 || length <= 0) return usage();
+        model.queues[q].length = length;
+    }
+    for (const std::string& arg : priority_overrides) {
+        std::string name;
+        int priority;
+        const int k = parse_override(arg, name, priority) ? find_task(model, name) : -1;
+        if (k < 0 || priority < 0) return usage();
+        model.tasks[k].priority = priority;
+    }
+
+    const Time horizon = static_cast<Time>(horizon_s * 1e6);
+    EventSimulator sim(model, load, seed);
+    const auto start = std::chrono::steady_clock::now();
+    sim.run(horizon);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print_report(model, sim, horizon, seconds);
+    return 0;
+}
@@ -0,0 +1,19 @@
+/* Produit par creer_table a partir de l'entree standard : ne pas modifier.
+ * Table triee de 50 valeurs au format de table_triee.h (cible petit-boutiste),
+ * a ouvrir avec tableDepuisMemoire( &table, ullTask4Table, sizeof( ullTask4Table ) ). */
+
+#include <stdint.h>
+
+static const uint64_t ullTask4Table[ 40 ] __attribute__( ( aligned( 64 ) ) ) =
+{
+    0x0004000149525454, 0x0000000000000001, 0x0000000000000032, 0x0000000000000040,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000140, 0x0000000000000000,
+    0x0000000200000000, 0x0000000600000004, 0x0000000a00000008, 0x0000000e0000000c,
+    0x0000001200000010, 0x0000001600000014, 0x0000001a00000018, 0x0000001e0000001c,
+    0x0000002200000020, 0x0000002600000024, 0x0000002a00000028, 0x0000002e0000002c,
+    0x0000003200000030, 0x0000003600000034, 0x0000003a00000038, 0x0000003e0000003c,
+    0x0000004200000040, 0x0000004600000044, 0x0000004a00000048, 0x0000004e0000004c,
+    0x0000005200000050, 0x0000005600000054, 0x0000005a00000058, 0x0000005e0000005c,
+    0x0000006200000060, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+    0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000
+};
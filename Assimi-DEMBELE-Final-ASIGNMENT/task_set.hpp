@@ -0,0 +1,39 @@
+/*
+ * Periodic task set shared by the scheduling tools.
+ */
+
+#ifndef TASK_SET_HPP
+#define TASK_SET_HPP
+
+#include <string>
+#include <vector>
+
+struct Task {
+    std::string name;
+    int C;
+    int T;
+    int D;
+};
+
+inline long gcd(long a, long b) { return b == 0 ? a : gcd(b, a % b); }
+
+inline long hyperperiod(const std::vector<Task>& tasks)
+{
+    long h = 1;
+    for (const Task& t : tasks) {
+        h = h / gcd(h, t.T) * t.T;
+    }
+    return h;
+}
+
+/* Number of jobs released in [0, horizon). */
+inline long job_count(const std::vector<Task>& tasks, long horizon)
+{
+    long n = 0;
+    for (const Task& t : tasks) {
+        n += (horizon + t.T - 1) / t.T;
+    }
+    return n;
+}
+
+#endif
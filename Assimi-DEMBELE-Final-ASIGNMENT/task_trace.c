@@ -0,0 +1,298 @@
+/*
+ * Per-job instrumentation of the main_blinky tasks, see task_trace.h.
+ *
+ * The hooks run inside the kernel, often with interrupts masked, so they
+ * only read the counter and update a few words of the task's slot: no
+ * allocation, no loop, no kernel call.  vTraceDump() copies one slot at a
+ * time inside a critical section and prints outside of it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "task_trace.h"
+
+#if defined( traceCOUNTER_CLOCK )
+    #include <time.h>
+#endif
+
+/* A job goes idle -> released (Ready) -> running/preempted -> idle. */
+#define traceJOB_IDLE        0
+#define traceJOB_RELEASED    1
+#define traceJOB_STARTED     2
+
+typedef struct xTRACE_TASK
+{
+    const char * pcName;
+    uint32_t ulPeriodMs;
+    uint32_t ulDeadlineMs;
+    uint32_t ulDeadline;                       /* Relative deadline in counter units. */
+
+    /* The job in progress. */
+    uint32_t ulState;
+    uint32_t ulRelease;
+    uint32_t ulSwitchedIn;                     /* Start of the current running interval. */
+    uint32_t ulExecuted;                       /* Running time of the job so far. */
+    uint32_t ulJitter;                         /* Start - release of the job. */
+
+    /* Statistics of the finished jobs. */
+    uint32_t ulJobs;
+    uint32_t ulMisses;
+    uint32_t ulBestCase;
+    uint32_t ulWorstCase;
+    uint64_t ullExecutedSum;
+    uint32_t ulWorstJitter;
+    uint32_t ulWorstResponse;
+    uint32_t ulExecHistogram[ traceHISTOGRAM_BUCKETS ];
+    uint32_t ulJitterHistogram[ traceHISTOGRAM_BUCKETS ];
+} TraceTask_t;
+
+static TraceTask_t xTraceTasks[ traceMAX_TASKS ];
+static UBaseType_t uxTraceRegistered = 0;
+
+/*-----------------------------------------------------------*/
+
+#if defined( traceCOUNTER_CLOCK )
+
+    uint32_t ulTraceCounter( void )
+    {
+        struct timespec xNow;
+
+        clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+        return ( uint32_t ) ( ( uint64_t ) xNow.tv_sec * 1000000ULL + ( uint64_t ) xNow.tv_nsec / 1000ULL );
+    }
+
+#elif defined( traceCOUNTER_TICKS )
+
+    uint32_t ulTraceCounter( void )
+    {
+        /* Some hooks run in the tick interrupt, hence the FromISR read. */
+        return ( uint32_t ) xTaskGetTickCountFromISR();
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvStartCounter( void )
+{
+    #if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+        /* CYCCNT only counts once trace is enabled in CoreDebug DEMCR (TRCENA)
+         * and the counter itself in DWT_CTRL (CYCCNTENA); both are 0 out of
+         * reset, and neither the kernel nor the startup code sets them. */
+        ( *( ( volatile uint32_t * ) 0xE000EDFCUL ) ) |= ( 1UL << 24 );
+        ( *( ( volatile uint32_t * ) 0xE0001004UL ) ) = 0;
+        ( *( ( volatile uint32_t * ) 0xE0001000UL ) ) |= 1UL;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static TraceTask_t * prvSlot( uintptr_t uxTag )
+{
+    return ( ( uxTag == 0 ) || ( uxTag > uxTraceRegistered ) ) ? NULL : &xTraceTasks[ uxTag - 1 ];
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvBucket( uint32_t ulValue )
+{
+    const UBaseType_t uxBits = ( ulValue == 0 ) ? 0 : ( UBaseType_t ) ( 32 - __builtin_clz( ulValue ) );
+
+    return ( uxBits < traceHISTOGRAM_BUCKETS ) ? uxBits : traceHISTOGRAM_BUCKETS - 1;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceReady( uintptr_t uxTag )
+{
+    TraceTask_t * const pxTask = prvSlot( uxTag );
+
+    /* A task already in a job can be moved to Ready again, e.g. when it
+     * wakes from a mutex or a queue inside the job: that is not a release. */
+    if( ( pxTask != NULL ) && ( pxTask->ulState == traceJOB_IDLE ) )
+    {
+        pxTask->ulRelease = traceCOUNTER();
+        pxTask->ulExecuted = 0;
+        pxTask->ulState = traceJOB_RELEASED;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTraceSwitchedIn( uintptr_t uxTag )
+{
+    TraceTask_t * const pxTask = prvSlot( uxTag );
+
+    if( pxTask != NULL )
+    {
+        const uint32_t ulNow = traceCOUNTER();
+
+        if( pxTask->ulState == traceJOB_RELEASED )
+        {
+            pxTask->ulJitter = ulNow - pxTask->ulRelease;
+            pxTask->ulState = traceJOB_STARTED;
+        }
+
+        pxTask->ulSwitchedIn = ulNow;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTraceSwitchedOut( uintptr_t uxTag )
+{
+    TraceTask_t * const pxTask = prvSlot( uxTag );
+
+    if( ( pxTask != NULL ) && ( pxTask->ulState == traceJOB_STARTED ) )
+    {
+        pxTask->ulExecuted += traceCOUNTER() - pxTask->ulSwitchedIn;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTraceJobEnd( uintptr_t uxTag )
+{
+    TraceTask_t * const pxTask = prvSlot( uxTag );
+
+    if( ( pxTask != NULL ) && ( pxTask->ulState == traceJOB_STARTED ) )
+    {
+        const uint32_t ulNow = traceCOUNTER();
+        const uint32_t ulExecuted = pxTask->ulExecuted + ( ulNow - pxTask->ulSwitchedIn );
+        const uint32_t ulResponse = ulNow - pxTask->ulRelease;
+
+        pxTask->ulJobs++;
+        pxTask->ullExecutedSum += ulExecuted;
+
+        if( ( pxTask->ulJobs == 1 ) || ( ulExecuted < pxTask->ulBestCase ) )
+        {
+            pxTask->ulBestCase = ulExecuted;
+        }
+
+        if( ulExecuted > pxTask->ulWorstCase )
+        {
+            pxTask->ulWorstCase = ulExecuted;
+        }
+
+        if( pxTask->ulJitter > pxTask->ulWorstJitter )
+        {
+            pxTask->ulWorstJitter = pxTask->ulJitter;
+        }
+
+        if( ulResponse > pxTask->ulWorstResponse )
+        {
+            pxTask->ulWorstResponse = ulResponse;
+        }
+
+        if( ulResponse > pxTask->ulDeadline )
+        {
+            pxTask->ulMisses++;
+        }
+
+        pxTask->ulExecHistogram[ prvBucket( ulExecuted ) ]++;
+        pxTask->ulJitterHistogram[ prvBucket( pxTask->ulJitter ) ]++;
+
+        /* Switched out just after this, so stop charging running time. */
+        pxTask->ulState = traceJOB_IDLE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+int xTraceRegisterTask( void * xTask,
+                        const char * pcName,
+                        uint32_t ulPeriodMs,
+                        uint32_t ulDeadlineMs )
+{
+    TraceTask_t * pxTask;
+
+    if( uxTraceRegistered == traceMAX_TASKS )
+    {
+        return -1;
+    }
+
+    if( uxTraceRegistered == 0 )
+    {
+        prvStartCounter();
+    }
+
+    pxTask = &xTraceTasks[ uxTraceRegistered ];
+    memset( pxTask, 0, sizeof( *pxTask ) );
+    pxTask->pcName = pcName;
+    pxTask->ulPeriodMs = ulPeriodMs;
+    pxTask->ulDeadlineMs = ulDeadlineMs;
+    pxTask->ulDeadline = ( uint32_t ) ( ( uint64_t ) ulDeadlineMs * traceCOUNTER_HZ / 1000ULL );
+
+    /* The slot must be complete before the hooks can see the tag. */
+    taskENTER_CRITICAL();
+    uxTraceRegistered++;
+    vTaskSetApplicationTaskTag( ( TaskHandle_t ) xTask, ( TaskHookFunction_t ) ( uintptr_t ) uxTraceRegistered );
+    taskEXIT_CRITICAL();
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintHistogram( const char * pcLabel,
+                               const uint32_t * pulHistogram )
+{
+    printf( "#   %-6s", pcLabel );
+
+    for( UBaseType_t x = 0; x < traceHISTOGRAM_BUCKETS; x++ )
+    {
+        if( pulHistogram[ x ] != 0 )
+        {
+            printf( " <2^%lu:%lu", ( unsigned long ) x, ( unsigned long ) pulHistogram[ x ] );
+        }
+    }
+
+    printf( "\n" );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceDump( void )
+{
+    const uint64_t ullCountsPerS = traceCOUNTER_HZ;
+    TraceTask_t xCopy;
+
+    /* Every statistics line starts with '#', which scheduling.py --tasks
+     * skips, so only the table at the end is read as the task set. */
+    printf( "# task   jobs  C min/avg/max (counts)   max jitter  max response  misses   (%lu counts/s)\n",
+            ( unsigned long ) ullCountsPerS );
+
+    for( UBaseType_t x = 0; x < uxTraceRegistered; x++ )
+    {
+        taskENTER_CRITICAL();
+        xCopy = xTraceTasks[ x ];
+        taskEXIT_CRITICAL();
+
+        printf( "# %-6s %5lu  %8lu/%8lu/%8lu  %10lu  %12lu  %6lu\n",
+                xCopy.pcName,
+                ( unsigned long ) xCopy.ulJobs,
+                ( unsigned long ) xCopy.ulBestCase,
+                ( unsigned long ) ( xCopy.ulJobs ? xCopy.ullExecutedSum / xCopy.ulJobs : 0 ),
+                ( unsigned long ) xCopy.ulWorstCase,
+                ( unsigned long ) xCopy.ulWorstJitter,
+                ( unsigned long ) xCopy.ulWorstResponse,
+                ( unsigned long ) xCopy.ulMisses );
+        prvPrintHistogram( "C", xCopy.ulExecHistogram );
+        prvPrintHistogram( "jitter", xCopy.ulJitterHistogram );
+    }
+
+    /* Measured WCET rounded up to whole milliseconds (at least 1), as "name C T D" lines
+     * for scheduler or scheduling.py --tasks. */
+    printf( "# measured task set (ms)\n" );
+
+    for( UBaseType_t x = 0; x < uxTraceRegistered; x++ )
+    {
+        const TraceTask_t * const pxTask = &xTraceTasks[ x ];
+        const uint32_t ulWorstCase = pxTask->ulWorstCase;
+
+        printf( "%s %lu %lu %lu\n",
+                pxTask->pcName,
+                ( unsigned long ) ( ulWorstCase ? ( ulWorstCase * 1000ULL + ullCountsPerS - 1 ) / ullCountsPerS : 1 ),
+                ( unsigned long ) pxTask->ulPeriodMs,
+                ( unsigned long ) pxTask->ulDeadlineMs );
+    }
+
+    fflush( stdout );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,119 @@
+/*
+ * Per-job instrumentation of the main_blinky tasks, built on the FreeRTOS
+ * trace hook macros.
+ *
+ * For every registered task the hooks timestamp, from a free-running cycle
+ * counter:
+ *
+ *   release  the task is moved to the Ready list (its delay expired)
+ *   start    it is switched in for the first time after that release
+ *   finish   it calls vTaskDelay() / vTaskDelayUntil(), or blocks waiting
+ *            for a task notification (event-driven tasks), ending its job
+ *
+ * Execution time only counts the intervals during which the task was
+ * actually running, so preemption by other tasks is not charged to it.  Per
+ * task the module keeps the job count, best/worst/average execution time,
+ * log2 histograms of execution time and of start jitter (start - release),
+ * and the number of jobs whose response time (finish - release) exceeded the
+ * deadline.  vTraceDump() prints everything, the statistics as '#' comment
+ * lines followed by a "name C T D" table with the measured C, so that the
+ * whole dump can be saved and passed to scheduling.py --tasks as is.  The
+ * main_blinky set (1000/2000/3000/4000/200 ms) releases 85 jobs per
+ * hyperperiod, more than the 64 of the native solver: scheduling.py then
+ * answers with its non-preemptive EDF heuristic, and scheduler itself only
+ * accepts the table with --analyse or --simulate.
+ *
+ * To enable it, add to FreeRTOSConfig.h:
+ *
+ *     #define configUSE_APPLICATION_TASK_TAG    1
+ *     #include "task_trace.h"
+ *
+ * and build main_blinky.c with -DmainTASK_TRACE=1.  The hooks identify a
+ * task through its application task tag, set by xTraceRegisterTask(), so
+ * this header must not include any kernel header.  On Cortex-M the first
+ * xTraceRegisterTask() also starts the DWT cycle counter, which is stopped
+ * out of reset.
+ *
+ * Single core only: the per-task slots and the registration count are
+ * global and the hooks update them without a lock, so main_blinky.c refuses
+ * mainTASK_TRACE together with mainSMP.
+ */
+
+#ifndef TASK_TRACE_H
+#define TASK_TRACE_H
+
+#include <stdint.h>
+
+/* Number of tasks that can be registered. */
+#ifndef traceMAX_TASKS
+    #define traceMAX_TASKS          ( 8 )
+#endif
+
+/* Histogram buckets: bucket k counts the values v with 2^(k-1) <= v < 2^k. */
+#define traceHISTOGRAM_BUCKETS      ( 32 )
+
+/* The free-running counter: DWT CYCCNT on Cortex-M3/M4/M7, microseconds of
+ * the monotonic clock on the POSIX and Windows (MinGW) ports, and the tick
+ * count elsewhere (Cortex-M0+ has no DWT counter, and bare-metal newlib no
+ * clock_gettime()).  The tick count only resolves whole ticks: a port with a
+ * finer timer defines traceCOUNTER() and traceCOUNTER_HZ before including
+ * this header, e.g. the 1 MHz timer of the RP2040:
+ *
+ *     #define traceCOUNTER()     ( timer_hw->timerawl )
+ *     #define traceCOUNTER_HZ    ( 1000000UL )
+ *
+ * Only differences are used, so wrapping is harmless for jobs shorter than
+ * one counter period. */
+#if defined( traceCOUNTER )
+    #ifndef traceCOUNTER_HZ
+        #error traceCOUNTER() needs traceCOUNTER_HZ, its frequency
+    #endif
+#elif defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ )
+    #define traceCOUNTER()          ( *( ( volatile uint32_t * ) 0xE0001004UL ) )
+    #define traceCOUNTER_HZ         ( configCPU_CLOCK_HZ )
+#elif defined( __unix__ ) || defined( __APPLE__ ) || defined( __MINGW32__ )
+    #define traceCOUNTER_CLOCK      1
+    uint32_t ulTraceCounter( void );
+    #define traceCOUNTER()          ulTraceCounter()
+    #define traceCOUNTER_HZ         ( 1000000UL )
+#else
+    #define traceCOUNTER_TICKS      1
+    uint32_t ulTraceCounter( void );
+    #define traceCOUNTER()          ulTraceCounter()
+    #define traceCOUNTER_HZ         ( configTICK_RATE_HZ )
+#endif
+
+/*
+ * Hook entry points, called by the kernel with the application tag of the
+ * task concerned.  Tag 0 is an unregistered task and is ignored.
+ */
+void vTraceReady( uintptr_t uxTag );
+void vTraceSwitchedIn( uintptr_t uxTag );
+void vTraceSwitchedOut( uintptr_t uxTag );
+void vTraceJobEnd( uintptr_t uxTag );
+
+/*
+ * Register a task (a TaskHandle_t) for tracing.  ulPeriodMs and ulDeadlineMs
+ * are its nominal period and relative deadline.  Returns 0, or -1 if
+ * traceMAX_TASKS tasks are already registered.
+ */
+int xTraceRegisterTask( void * xTask,
+                        const char * pcName,
+                        uint32_t ulPeriodMs,
+                        uint32_t ulDeadlineMs );
+
+/*
+ * Print the statistics of every registered task on stdout.
+ */
+void vTraceDump( void );
+
+/* The trace hooks themselves, expanded inside tasks.c where pxCurrentTCB and
+ * the TCB fields are visible. */
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceReady( ( uintptr_t ) ( pxTCB )->pxTaskTag )
+#define traceTASK_SWITCHED_IN()                    vTraceSwitchedIn( ( uintptr_t ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_SWITCHED_OUT()                   vTraceSwitchedOut( ( uintptr_t ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_DELAY()                          vTraceJobEnd( ( uintptr_t ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )       vTraceJobEnd( ( uintptr_t ) pxCurrentTCB->pxTaskTag )
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndex )     vTraceJobEnd( ( uintptr_t ) pxCurrentTCB->pxTaskTag )
+
+#endif /* TASK_TRACE_H */
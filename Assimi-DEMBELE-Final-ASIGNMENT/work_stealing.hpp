@@ -0,0 +1,99 @@
+/*
+ * Minimal work-stealing pool for the schedule search.
+ *
+ * Every worker owns a deque of tasks. It pushes the tasks it spawns at the
+ * back and takes its own work from the back too (depth first, good for
+ * pruning). An idle worker steals from the front of another deque, where
+ * the oldest and therefore largest subtrees are. run() returns once every
+ * task, including the ones spawned while running, is finished.
+ */
+
+#ifndef WORK_STEALING_HPP
+#define WORK_STEALING_HPP
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+template <typename Task>
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads) : queues_(threads > 0 ? threads : 1) {}
+
+    int threads() const { return static_cast<int>(queues_.size()); }
+
+    /* Run work(worker, task) on the initial task and on every task pushed meanwhile. */
+    template <typename Work>
+    void run(Task initial, Work work)
+    {
+        push(0, std::move(initial));
+        std::vector<std::thread> helpers;
+        for (int w = 1; w < threads(); w++) {
+            helpers.emplace_back([this, w, &work] { loop(w, work); });
+        }
+        loop(0, work);
+        for (std::thread& t : helpers) {
+            t.join();
+        }
+    }
+
+    /* Called by worker `worker` from inside work() to spawn a subtask. */
+    void push(int worker, Task task)
+    {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        Queue& q = queues_[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(std::move(task));
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool take(int worker, Task& out)
+    {
+        {
+            Queue& own = queues_[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                out = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (int i = 1; i < threads(); i++) {
+            Queue& victim = queues_[(worker + i) % threads()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                out = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Work>
+    void loop(int worker, Work& work)
+    {
+        Task task;
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (take(worker, task)) {
+                work(worker, task);
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::vector<Queue> queues_;
+    std::atomic<long> pending_{0};
+};
+
+#endif
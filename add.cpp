@@ -1,24 +1,52 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            Addition
-            
------------------------------------*/
-
-#include <stdio.h>
-
-int main() {
-    int x, y, d;
-
-    printf("Entrez la valeur de x : ");
-    scanf("%d", &x);
-
-    printf("Entrez la valeur de y : ");
-    scanf("%d", &y);
-
-    d = x + y;
-    printf("La somme de x + y = %d + %d = %d\n", x, y, d);
-
-    return 0;
-}
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            Addition
+            
+-----------------------------------*/
+
+#include <stdio.h>
+#include "flux.h"
+
+// Couples lus par blocs de cette taille
+#define COUPLES_PAR_BLOC 4096
+
+static EcrivainEntiers sortie;
+
+static int additionnerBloc(const int *valeurs, size_t nb, void *) {
+    for (size_t i = 0; i < nb; i += 2) {
+        // Somme sur 64 bits : pas de dépassement pour deux int
+        ecrireEntier(&sortie, (long long)valeurs[i] + valeurs[i + 1], '\n');
+    }
+    return 0;
+}
+
+// Mode non interactif : add fichier (ou - pour l'entrée standard)
+// Le fichier contient des couples x y ; écrit x + y pour chacun, un par ligne.
+static int additionnerFichier(const char *chemin) {
+    static int valeurs[2 * COUPLES_PAR_BLOC];
+
+    ecrivainInit(&sortie, stdout);
+    int statut = traiterFichierParBlocs(chemin, valeurs, 2 * COUPLES_PAR_BLOC, 2, additionnerBloc, NULL);
+    return ecrivainVider(&sortie) == 0 && statut == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int x, y, d;
+
+    if (argc > 1) {
+        return additionnerFichier(argv[1]);
+    }
+
+    printf("Entrez la valeur de x : ");
+    scanf("%d", &x);
+
+    printf("Entrez la valeur de y : ");
+    scanf("%d", &y);
+
+    d = x + y;
+    printf("La somme de x + y = %d + %d = %d\n", x, y, d);
+
+    return 0;
+}
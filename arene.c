@@ -0,0 +1,59 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "arene.h"
+
+void areneInit(Arene *arene, void *memoire, size_t taille) {
+    arene->debut = memoire;
+    arene->taille = memoire != NULL ? taille : 0;
+    arene->utilise = 0;
+    arene->pic = 0;
+    arene->possede = 0;
+}
+
+int areneCreer(Arene *arene, size_t taille) {
+    void *memoire = malloc(taille > 0 ? taille : 1);
+    areneInit(arene, memoire, taille);
+    if (memoire == NULL) {
+        return -1;
+    }
+    arene->possede = 1;
+    return 0;
+}
+
+void areneDetruire(Arene *arene) {
+    if (arene->possede) {
+        free(arene->debut);
+    }
+    areneInit(arene, NULL, 0);
+}
+
+void *areneAllouer(Arene *arene, size_t taille, size_t alignement) {
+    if (alignement == 0) {
+        alignement = 1;
+    }
+    if ((alignement & (alignement - 1)) != 0) {
+        return NULL;
+    }
+
+    // Alignement de l'adresse elle-même : le bloc de départ peut être quelconque
+    uintptr_t adresse = (uintptr_t)(arene->debut + arene->utilise);
+    size_t decalage = (size_t)(-adresse & (alignement - 1));
+    size_t reste = arene->taille - arene->utilise;
+    if (decalage > reste || taille > reste - decalage) {
+        return NULL;
+    }
+
+    void *bloc = arene->debut + arene->utilise + decalage;
+    arene->utilise += decalage + taille;
+    if (arene->utilise > arene->pic) {
+        arene->pic = arene->utilise;
+    }
+    return bloc;
+}
+
+void *areneAllouerTableau(Arene *arene, size_t n, size_t tailleElement) {
+    if (tailleElement != 0 && n > SIZE_MAX / tailleElement) {
+        return NULL;
+    }
+    return areneAllouer(arene, n * tailleElement, ARENE_ALIGNEMENT_SIMD);
+}
@@ -0,0 +1,70 @@
+// Arène mémoire : allocation par simple avancée d'un pointeur dans un bloc
+// Pas de libération individuelle : on vide l'arène d'un coup à la fin de chaque
+// tour de boucle (ou de chaque job d'une tâche), ou on revient à une marque.
+// Les allocations ne coûtent que quelques instructions, sans fragmentation,
+// et l'alignement demandé (jusqu'à ARENE_ALIGNEMENT_SIMD pour AVX2) est respecté.
+// Une arène n'a pas de verrou : une arène par tâche ou par fil d'exécution.
+
+#ifndef ARENE_H
+#define ARENE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignement des tampons destinés aux noyaux vectoriels (un registre AVX2)
+#define ARENE_ALIGNEMENT_SIMD 32
+
+typedef struct {
+    unsigned char *debut;
+    size_t taille;
+    size_t utilise;
+    size_t pic;          // plus haut niveau atteint, pour dimensionner l'arène
+    int possede;         // 1 si le bloc vient de areneCreer (libéré par areneDetruire)
+} Arene;
+
+// Arène sur un bloc fourni : tableau statique, pile d'une tâche...
+void areneInit(Arene *arene, void *memoire, size_t taille);
+
+// Arène sur un bloc alloué une seule fois avec malloc.
+// Retourne 0, ou -1 si l'allocation échoue.
+int areneCreer(Arene *arene, size_t taille);
+void areneDetruire(Arene *arene);
+
+// taille octets alignés sur alignement (une puissance de 2, 0 vaut 1).
+// Retourne NULL si l'arène est pleine ou si l'alignement n'est pas une puissance de 2.
+void *areneAllouer(Arene *arene, size_t taille, size_t alignement);
+
+// Tableau de n éléments, aligné pour les noyaux vectoriels ; NULL aussi si
+// n * tailleElement déborde
+void *areneAllouerTableau(Arene *arene, size_t n, size_t tailleElement);
+
+#define areneTableau(arene, type, n) ((type *)areneAllouerTableau((arene), (n), sizeof(type)))
+
+// Marque et retour arrière : tout ce qui a été alloué après la marque est rendu
+static inline size_t areneMarque(const Arene *arene) {
+    return arene->utilise;
+}
+
+static inline void areneRevenir(Arene *arene, size_t marque) {
+    if (marque < arene->utilise) {
+        arene->utilise = marque;
+    }
+}
+
+// Rend tout : à appeler au début (ou à la fin) de chaque tour
+static inline void areneVider(Arene *arene) {
+    arene->utilise = 0;
+}
+
+static inline size_t areneDisponible(const Arene *arene) {
+    return arene->taille - arene->utilise;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,28 @@
+# Lance bench_noyaux pour la cible bench (cmake -P)
+# Le JSON porte le commit mesuré, pour comparer les résultats d'un commit à l'autre.
+
+execute_process(
+    COMMAND git rev-parse --short HEAD
+    WORKING_DIRECTORY ${SOURCE}
+    OUTPUT_VARIABLE REVISION
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+    RESULT_VARIABLE GIT_STATUT
+)
+if(NOT GIT_STATUT EQUAL 0 OR REVISION STREQUAL "")
+    set(REVISION "inconnue")
+endif()
+
+execute_process(
+    COMMAND ${BANC}
+            --tailles ${TAILLES}
+            --distributions ${DISTRIBUTIONS}
+            --temps ${TEMPS}
+            --revision ${REVISION}
+            --json ${SORTIE}
+    RESULT_VARIABLE STATUT
+)
+if(NOT STATUT EQUAL 0)
+    message(FATAL_ERROR "bench_noyaux a échoué (${STATUT})")
+endif()
+message(STATUS "Résultats : ${SORTIE}")
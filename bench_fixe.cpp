@@ -0,0 +1,154 @@
+/*-----------------------------------
+       Benchmark du tri et de la recherche de taille fixe
+
+   Compare, pour des tableaux de N éléments connus à la
+   compilation (tableau_fixe.hpp) :
+     - triFixe<N> (réseau de tri) et triInsertion ;
+     - rechercheFixe<N> (profondeur fixe, sans branchement),
+       rechercheBinaire et rechercher (parcours) ;
+     - IndexFixe sur la table de recherche.c et la liste de Task4.
+   Les réseaux sont d'abord vérifiés : toutes les entrées 0/1
+   jusqu'à N = 16 (principe du 0-1), puis des entrées aléatoires.
+
+   gcc -O2 -c tri.c recherche_binaire.c recherche_simd.c
+   g++ -O2 -std=c++17 bench_fixe.cpp tri.o recherche_binaire.o recherche_simd.o -o bench_fixe
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <string.h>
+#include "bench_outils.h"
+#include "recherche.h"
+#include "recherche_binaire.h"
+#include "tableau_fixe.hpp"
+#include "tri.h"
+
+// Table de recherche.c et liste triée de Task4 (0, 2, ..., 98)
+static constexpr int tableRecherche[10] = {2, 7, 5, 9, 6, 4, 0, 1, 3, 8};
+static constexpr IndexFixe<10> indexRecherche(tableRecherche);
+
+static constexpr int listeTask4[50] = {0,  2,  4,  6,  8,  10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32,
+                                       34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66,
+                                       68, 70, 72, 74, 76, 78, 80, 82, 84, 86, 88, 90, 92, 94, 96, 98};
+
+// Vérifiés à la compilation
+static_assert(indexRecherche.rechercher(2) == 0, "");
+static_assert(indexRecherche.rechercher(8) == 9, "");
+static_assert(indexRecherche.rechercher(10) == -1, "");
+static_assert(rechercheFixe(listeTask4, 98) == 49, "");
+static_assert(rechercheFixe(listeTask4, 25) == -1, "");
+static_assert(rechercheFixe(listeTask4, -1) == -1, "");
+
+static constexpr std::array<int, 5> trierAlaCompilation() {
+    std::array<int, 5> t = {5, -3, 9, 0, -3};
+    triFixe(t);
+    return t;
+}
+static_assert(trierAlaCompilation()[0] == -3 && trierAlaCompilation()[4] == 9, "");
+
+static int estTrie(const int* t, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (t[i - 1] > t[i]) return 0;
+    }
+    return 1;
+}
+
+// 0 si triFixe<N> trie toutes les entrées 0/1 (N <= 16) et des entrées aléatoires
+template <size_t N>
+static int verifierReseau() {
+    int t[N];
+    if (N <= 16) {
+        for (unsigned long m = 0; m < (1ul << N); m++) {
+            for (size_t i = 0; i < N; i++) t[i] = (int)((m >> i) & 1);
+            triFixe(t);
+            if (!estTrie(t, N)) return 1;
+        }
+    }
+    for (int essai = 0; essai < 10000; essai++) {
+        long long somme = 0, sommeTriee = 0;
+        for (size_t i = 0; i < N; i++) {
+            t[i] = (int)(aleatoire() % 64) - 32;
+            somme += t[i];
+        }
+        triFixe(t);
+        for (size_t i = 0; i < N; i++) sommeTriee += t[i];
+        if (!estTrie(t, N) || somme != sommeTriee) return 1;
+    }
+    return 0;
+}
+
+template <size_t... N>
+static int verifierReseaux(std::index_sequence<N...>) {
+    return (verifierReseau<N + 1>() + ...);
+}
+
+#define REPETITIONS 200000
+#define NB_ENTREES 256
+
+static int entrees[NB_ENTREES][TRI_FIXE_MAX];
+static volatile int puits;
+
+// ns par tri de N éléments : triFixe puis triInsertion, sur les mêmes entrées
+template <size_t N>
+static void mesurerTri() {
+    int t[N];
+    for (int e = 0; e < NB_ENTREES; e++) {
+        for (size_t i = 0; i < N; i++) entrees[e][i] = (int)aleatoire();
+    }
+    double debut = maintenant();
+    for (int r = 0; r < REPETITIONS; r++) {
+        memcpy(t, entrees[r % NB_ENTREES], sizeof(t));
+        triFixe(t);
+        puits = t[N / 2];
+    }
+    double fixe = (maintenant() - debut) * 1e9 / REPETITIONS;
+    debut = maintenant();
+    for (int r = 0; r < REPETITIONS; r++) {
+        memcpy(t, entrees[r % NB_ENTREES], sizeof(t));
+        triInsertion(t, (int)N);
+        puits = t[N / 2];
+    }
+    double insertion = (maintenant() - debut) * 1e9 / REPETITIONS;
+    printf("tri        N = %2zu %12.1f %14.1f %10.2fx   (%zu comparateurs)\n", N, fixe, insertion,
+           insertion / fixe, ReseauTri<N>::taille);
+}
+
+// ns par recherche dans un tableau trié de N éléments
+template <size_t N>
+static void mesurerRecherche(const int (&t)[N]) {
+    int cles[NB_ENTREES];
+    long somme = 0, sommeFixe = 0;
+    for (int k = 0; k < NB_ENTREES; k++) cles[k] = (int)(aleatoire() % (2 * N + 2)) - 1;
+    double debut = maintenant();
+    for (int r = 0; r < REPETITIONS; r++) sommeFixe += rechercheFixe(t, cles[r % NB_ENTREES]);
+    double fixe = (maintenant() - debut) * 1e9 / REPETITIONS;
+    debut = maintenant();
+    for (int r = 0; r < REPETITIONS; r++) somme += rechercheBinaire(t, N, cles[r % NB_ENTREES]);
+    double binaire = (maintenant() - debut) * 1e9 / REPETITIONS;
+    debut = maintenant();
+    for (int r = 0; r < REPETITIONS; r++) puits = (int)rechercher(t, N, cles[r % NB_ENTREES]);
+    double parcours = (maintenant() - debut) * 1e9 / REPETITIONS;
+    printf("recherche  N = %2zu %12.1f %14.1f %10.2fx   (parcours %.1f)%s\n", N, fixe, binaire, binaire / fixe,
+           parcours, somme == sommeFixe ? "" : "   ERREUR : résultats différents");
+}
+
+int main(void) {
+    int erreurs = verifierReseaux(std::make_index_sequence<TRI_FIXE_MAX>{});
+    for (int v = -5; v < 110; v++) {
+        erreurs += rechercheFixe(listeTask4, v) != rechercheBinaire(listeTask4, 50, v);
+        erreurs += indexRecherche.rechercher(v) != rechercher(tableRecherche, 10, v);
+    }
+    printf("réseaux N = 1..%d et recherches : %s\n\n", TRI_FIXE_MAX, erreurs == 0 ? "justes" : "ERREUR");
+
+    printf("%-16s %12s %14s %11s\n", "", "fixe (ns)", "générique (ns)", "gain");
+    mesurerTri<4>();
+    mesurerTri<8>();
+    mesurerTri<10>();
+    mesurerTri<16>();
+    mesurerTri<32>();
+    mesurerTri<50>();
+    mesurerTri<64>();
+    static const int dix[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    mesurerRecherche(dix);
+    mesurerRecherche(listeTask4);
+    return erreurs == 0 ? 0 : 1;
+}
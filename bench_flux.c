@@ -0,0 +1,128 @@
+/*-----------------------------------
+       Benchmark de la lecture d'entiers
+
+   Écrit n entiers (10^7 par défaut) dans un fichier texte puis
+   compare, pour les relire :
+     - fscanf("%d"), comme les exercices le faisaient ;
+     - fread du fichier entier puis strtol ;
+     - lireEntier sur le fichier projeté en mémoire (flux.c) ;
+     - lireEntier sur le texte déjà en mémoire (analyse seule).
+   Puis l'écriture : fprintf("%d\n") contre ecrireEntiers.
+
+   gcc -O2 bench_flux.c flux.c -o bench_flux
+   ./bench_flux [n] [fichier temporaire]
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "flux.h"
+
+static EcrivainEntiers ecrivain;
+
+static void afficher(const char *nom, double duree, size_t n, double octets, long long somme, long long attendu) {
+    printf("%-28s %8.3f s %8.1f ns/entier %8.0f Mo/s%s\n", nom, duree, duree * 1e9 / (double)n,
+           octets / duree / 1e6, somme == attendu ? "" : "   ERREUR : résultat différent");
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    const char *chemin = argc > 2 ? argv[2] : "bench_flux.txt";
+    int *valeurs = malloc((n > 0 ? n : 1) * sizeof(int));
+    long long attendu = 0;
+    int erreurs = 0;
+
+    if (valeurs == NULL || n == 0) {
+        printf("n invalide ou mémoire insuffisante\n");
+        return 1;
+    }
+    // Entiers de toutes tailles : la moitié sur 32 bits, le reste plus court
+    for (size_t i = 0; i < n; i++) {
+        unsigned int r = aleatoire();
+        valeurs[i] = (i % 2 == 0) ? (int)r : (int)(r % 100000) - 50000;
+        attendu += valeurs[i];
+    }
+
+    // Écriture : fprintf puis ecrireEntiers, sur le même fichier
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL) {
+        printf("Impossible d'écrire %s\n", chemin);
+        return 1;
+    }
+    double debut = maintenant();
+    for (size_t i = 0; i < n; i++) {
+        fprintf(f, "%d\n", valeurs[i]);
+    }
+    fflush(f);
+    double dureeFprintf = maintenant() - debut;
+    long octets = ftell(f);
+    fclose(f);
+
+    f = fopen(chemin, "w");
+    debut = maintenant();
+    ecrivainInit(&ecrivain, f);
+    ecrireEntiers(&ecrivain, valeurs, n);
+    erreurs += ecrivainVider(&ecrivain) != 0;
+    double dureeEcrivain = maintenant() - debut;
+    fclose(f);
+
+    printf("%zu entiers, %.1f Mo\n", n, octets / 1e6);
+    afficher("fprintf", dureeFprintf, n, (double)octets, attendu, attendu);
+    afficher("ecrireEntiers", dureeEcrivain, n, (double)octets, attendu, attendu);
+
+    // Lecture avec fscanf
+    long long somme = 0;
+    int v;
+    f = fopen(chemin, "r");
+    debut = maintenant();
+    while (fscanf(f, "%d", &v) == 1) {
+        somme += v;
+    }
+    afficher("fscanf", maintenant() - debut, n, (double)octets, somme, attendu);
+    fclose(f);
+
+    // Lecture en bloc puis strtol
+    f = fopen(chemin, "rb");
+    char *texte = malloc((size_t)octets + 1);
+    debut = maintenant();
+    size_t lus = fread(texte, 1, (size_t)octets, f);
+    texte[lus] = '\0';
+    somme = 0;
+    for (char *p = texte, *suite;; p = suite) {
+        long x = strtol(p, &suite, 10);
+        if (suite == p) break;
+        somme += x;
+    }
+    afficher("fread + strtol", maintenant() - debut, n, (double)octets, somme, attendu);
+    fclose(f);
+
+    // lireEntier sur le fichier projeté (à froid pour le mmap, mais dans le cache du système)
+    LecteurEntiers lecteur;
+    debut = maintenant();
+    if (lecteurOuvrir(&lecteur, chemin) != 0) {
+        printf("Impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+    somme = 0;
+    while (lireEntier(&lecteur, &v) == 1) {
+        somme += v;
+    }
+    lecteurFermer(&lecteur);
+    afficher("lireEntier (fichier)", maintenant() - debut, n, (double)octets, somme, attendu);
+    erreurs += somme != attendu;
+
+    // lireEntier sur le texte en mémoire : le coût de l'analyse seule
+    debut = maintenant();
+    lecteurDepuisMemoire(&lecteur, texte, lus);
+    somme = 0;
+    while (lireEntier(&lecteur, &v) == 1) {
+        somme += v;
+    }
+    afficher("lireEntier (memoire)", maintenant() - debut, n, (double)octets, somme, attendu);
+    erreurs += somme != attendu;
+
+    free(texte);
+    free(valeurs);
+    remove(chemin);
+    return erreurs == 0 ? 0 : 1;
+}
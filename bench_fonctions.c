@@ -0,0 +1,207 @@
+/*-----------------------------------
+       Benchmark des calculs sur tableaux
+
+   Compare, pour somme, comparaison et multiplication,
+   la boucle d'origine (un appel de fonction par élément,
+   comme quand elles étaient dans fonction.c)
+   aux versions sur tableaux de fonctions.h.
+   Vérifie d'abord chaque mode contre un calcul scalaire,
+   cas limites INT_MIN / INT_MAX compris.
+
+   gcc -O2 bench_fonctions.c fonction.c -o bench_fonctions
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "fonctions.h"
+
+// Fonctions de fonction.c, telles qu'elles étaient
+__attribute__((noinline)) static int sommeOrigine(int a, int b) {
+    return (int)((unsigned)a + (unsigned)b);
+}
+
+__attribute__((noinline)) static int comparaisonOrigine(int a, int b) {
+    if (a > b) {
+        return 1;
+    } else if (a < b) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+__attribute__((noinline)) static int multiplicationOrigine(int a, int b) {
+    return (int)((unsigned)a * (unsigned)b);
+}
+
+// Résultat attendu de chaque mode pour un élément
+static int attenduSature(long long v) {
+    return v > INT_MAX ? INT_MAX : v < INT_MIN ? INT_MIN : (int)v;
+}
+
+static int modulo(long long v) {
+    return (int)(unsigned)(unsigned long long)v;
+}
+
+// Vérifie les sept fonctions sur a, b ; 0 si tout est juste
+static int verifier(const int *a, const int *b, int *out, size_t n) {
+    long premierSomme = -1, premierProduit = -1;
+    int erreurs = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        long long s = (long long)a[i] + b[i];
+        long long p = (long long)a[i] * b[i];
+        if (premierSomme < 0 && s != modulo(s)) premierSomme = (long)i;
+        if (premierProduit < 0 && p != modulo(p)) premierProduit = (long)i;
+    }
+
+#define CONTROLER(appel, attendu, nom)                                   \
+    do {                                                                 \
+        appel;                                                           \
+        for (size_t i = 0; i < n; i++) {                                 \
+            long long s = (long long)a[i] + b[i];                        \
+            long long p = (long long)a[i] * b[i];                        \
+            (void)s; (void)p;                                            \
+            if (out[i] != (attendu)) {                                   \
+                printf("ERREUR : %s, n = %zu, i = %zu\n", nom, n, i);    \
+                erreurs++;                                               \
+                break;                                                   \
+            }                                                            \
+        }                                                                \
+    } while (0)
+
+    CONTROLER(somme_n(a, b, out, n), modulo(s), "somme_n");
+    CONTROLER(somme_n_saturee(a, b, out, n), attenduSature(s), "somme_n_saturee");
+    CONTROLER((void)somme_n_verifiee(a, b, out, n), modulo(s), "somme_n_verifiee");
+    CONTROLER(comparaison_n(a, b, out, n), comparaisonOrigine(a[i], b[i]), "comparaison_n");
+    CONTROLER(multiplication_n(a, b, out, n), modulo(p), "multiplication_n");
+    CONTROLER(multiplication_n_saturee(a, b, out, n), attenduSature(p), "multiplication_n_saturee");
+    CONTROLER((void)multiplication_n_verifiee(a, b, out, n), modulo(p), "multiplication_n_verifiee");
+#undef CONTROLER
+
+    // Indice du premier dépassement
+    if (somme_n_verifiee(a, b, out, n) != premierSomme) {
+        printf("ERREUR : somme_n_verifiee, n = %zu, mauvais indice\n", n);
+        erreurs++;
+    }
+    if (multiplication_n_verifiee(a, b, out, n) != premierProduit) {
+        printf("ERREUR : multiplication_n_verifiee, n = %zu, mauvais indice\n", n);
+        erreurs++;
+    }
+    return erreurs;
+}
+
+static int verifierTout(void) {
+    static const int limites[] = {INT_MIN, INT_MIN + 1, -65536, -46341, -1, 0, 1, 46340, 46341, 65536, INT_MAX - 1, INT_MAX};
+    const size_t nbLimites = sizeof(limites) / sizeof(limites[0]);
+    const size_t n = nbLimites * nbLimites;
+    int *a = malloc(n * sizeof(int));
+    int *b = malloc(n * sizeof(int));
+    int *out = malloc(n * sizeof(int));
+    int erreurs = 0;
+
+    // Toutes les paires de valeurs limites
+    for (size_t i = 0; i < n; i++) {
+        a[i] = limites[i / nbLimites];
+        b[i] = limites[i % nbLimites];
+    }
+    // Chaque longueur de 0 à n, pour passer par tous les restes des boucles vectorielles
+    for (size_t k = 0; k <= n; k++) {
+        erreurs += verifier(a, b, out, k);
+        erreurs += verifier(a + n - k, b + n - k, out, k);
+    }
+    // Petites valeurs aléatoires : aucun dépassement, le mode vérifié doit rendre -1
+    for (size_t i = 0; i < n; i++) {
+        a[i] = (int)(aleatoire() % 2001) - 1000;
+        b[i] = (int)(aleatoire() % 2001) - 1000;
+    }
+    erreurs += verifier(a, b, out, n);
+
+    free(a);
+    free(b);
+    free(out);
+    return erreurs;
+}
+
+typedef void (*FonctionTableau)(const int *, const int *, int *, size_t);
+
+static void sommeBoucle(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = sommeOrigine(a[i], b[i]);
+}
+
+static void comparaisonBoucle(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = comparaisonOrigine(a[i], b[i]);
+}
+
+static void multiplicationBoucle(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = multiplicationOrigine(a[i], b[i]);
+}
+
+static void multiplicationVerifieeSansRetour(const int *a, const int *b, int *out, size_t n) {
+    (void)multiplication_n_verifiee(a, b, out, n);
+}
+
+// Temps moyen par élément en nanosecondes
+static double mesurer(FonctionTableau fn, const int *a, const int *b, int *out, size_t n) {
+    long repetitions = 1;
+    while (1) {
+        double debut = maintenant();
+        for (long r = 0; r < repetitions; r++) {
+            fn(a, b, out, n);
+        }
+        double duree = maintenant() - debut;
+        if (duree >= 0.1) {
+            return duree * 1e9 / ((double)repetitions * n);
+        }
+        repetitions *= 2;
+    }
+}
+
+int main(void) {
+    const size_t tailles[] = {1024, 65536, 1048576};
+    const int nbTailles = sizeof(tailles) / sizeof(tailles[0]);
+    const struct {
+        const char *nom;
+        FonctionTableau origine, tableau;
+    } operations[] = {
+        {"somme_n", sommeBoucle, somme_n},
+        {"somme_n_saturee", sommeBoucle, somme_n_saturee},
+        {"comparaison_n", comparaisonBoucle, comparaison_n},
+        {"multiplication_n", multiplicationBoucle, multiplication_n},
+        {"multiplication_n_saturee", multiplicationBoucle, multiplication_n_saturee},
+        {"multiplication_n_verifiee", multiplicationBoucle, multiplicationVerifieeSansRetour},
+    };
+    const int nbOperations = sizeof(operations) / sizeof(operations[0]);
+
+    printf("noyau : %s\n", calculImplementation());
+    if (verifierTout() != 0) {
+        return 1;
+    }
+    printf("%-26s %8s %14s %14s %10s\n", "fonction", "n", "origine (ns)", "tableau (ns)", "accél.");
+
+    for (int k = 0; k < nbTailles; k++) {
+        size_t n = tailles[k];
+        int *a = malloc(n * sizeof(int));
+        int *b = malloc(n * sizeof(int));
+        int *out = malloc(n * sizeof(int));
+
+        // Valeurs sur 16 bits : ni somme ni produit ne débordent,
+        // le mode vérifié parcourt donc tout le tableau
+        for (size_t i = 0; i < n; i++) {
+            a[i] = (int)(aleatoire() & 0xFFFF) - 32768;
+            b[i] = (int)(aleatoire() & 0xFFFF) - 32768;
+        }
+
+        for (int o = 0; o < nbOperations; o++) {
+            double t0 = mesurer(operations[o].origine, a, b, out, n);
+            double t1 = mesurer(operations[o].tableau, a, b, out, n);
+            printf("%-26s %8zu %14.3f %14.3f %9.1fx\n", operations[o].nom, n, t0, t1, t0 / t1);
+        }
+        free(a);
+        free(b);
+        free(out);
+    }
+    return 0;
+}
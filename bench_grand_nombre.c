@@ -0,0 +1,173 @@
+/*-----------------------------------
+       Benchmark des grands nombres
+
+   Compare la multiplication scolaire à multiplierMots
+   (Karatsuba au-dessus de GRAND_NOMBRE_SEUIL_KARATSUBA mots)
+   pour des opérandes de 4 à 4096 mots de 64 bits,
+   après avoir vérifié que les deux donnent le même produit.
+   Mesure aussi le produit 64 x 64 -> 128 bits.
+
+   gcc -O2 bench_grand_nombre.c grand_nombre.c -o bench_grand_nombre
+   (-DGRAND_NOMBRE_SEUIL_KARATSUBA=n sur les deux fichiers pour essayer un autre seuil)
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_outils.h"
+#include "grand_nombre.h"
+
+static uint64_t aleatoire64(void) {
+    return (uint64_t)aleatoire() << 32 | aleatoire();
+}
+
+// Produits et textes connus, cas limites compris
+static int verifierProduit128(void) {
+    const struct {
+        int64_t a, b;
+        int signe;
+        const char *attendu;
+    } cas[] = {
+        {123456789, 987654321, 1, "121932631112635269"},
+        {-1, -1, 0, "340282366920938463426481119284349108225"},
+        {-1, -1, 1, "1"},
+        {INT64_MIN, INT64_MAX, 1, "-85070591730234615856620279821087277056"},
+        {INT64_MIN, INT64_MIN, 1, "85070591730234615865843651857942052864"},
+        {0, 123, 1, "0"},
+        {-1000000000, 1000000000, 1, "-1000000000000000000"},
+    };
+    char texte[48];
+    int erreurs = 0;
+
+    for (size_t i = 0; i < sizeof(cas) / sizeof(cas[0]); i++) {
+        Produit128 p = cas[i].signe ? multiplier64Signe(cas[i].a, cas[i].b)
+                                    : multiplier64((uint64_t)cas[i].a, (uint64_t)cas[i].b);
+        produit128VersTexte(p, cas[i].signe, texte, sizeof(texte));
+        if (strcmp(texte, cas[i].attendu) != 0) {
+            printf("ERREUR : %s au lieu de %s\n", texte, cas[i].attendu);
+            erreurs++;
+        }
+    }
+    // Texte trop petit : rien n'est écrit au-delà, la fonction rend 0
+    if (produit128VersTexte(multiplier64(123456789, 987654321), 0, texte, 18) != 0) {
+        printf("ERREUR : dépassement du texte non détecté\n");
+        erreurs++;
+    }
+    return erreurs;
+}
+
+// Karatsuba contre méthode scolaire, opérandes équilibrés ou non, mots extrêmes compris
+static int verifierMots(void) {
+    const size_t tailles[][2] = {{1, 1}, {3, 40}, {31, 32}, {32, 32}, {33, 33}, {64, 64},
+                                 {100, 37}, {200, 64}, {257, 129}, {513, 513}, {1000, 999}};
+    int erreurs = 0;
+
+    for (size_t k = 0; k < sizeof(tailles) / sizeof(tailles[0]); k++) {
+        for (int plein = 0; plein < 2; plein++) {
+            size_t na = tailles[k][0], nb = tailles[k][1];
+            uint64_t *a = malloc(na * sizeof(uint64_t));
+            uint64_t *b = malloc(nb * sizeof(uint64_t));
+            uint64_t *r0 = malloc((na + nb) * sizeof(uint64_t));
+            uint64_t *r1 = malloc((na + nb) * sizeof(uint64_t));
+
+            // plein : tous les mots à 2^64 - 1, qui poussent les retenues au maximum
+            for (size_t i = 0; i < na; i++) a[i] = plein ? UINT64_MAX : aleatoire64();
+            for (size_t i = 0; i < nb; i++) b[i] = plein ? UINT64_MAX : aleatoire64();
+            multiplierMotsScolaire(a, na, b, nb, r0);
+            if (multiplierMots(a, na, b, nb, r1) != 0 ||
+                memcmp(r0, r1, (na + nb) * sizeof(uint64_t)) != 0) {
+                printf("ERREUR : produits différents (%zu x %zu mots)\n", na, nb);
+                erreurs++;
+            }
+            free(a);
+            free(b);
+            free(r0);
+            free(r1);
+        }
+    }
+    return erreurs;
+}
+
+typedef void (*Multiplication)(const uint64_t *, size_t, const uint64_t *, size_t, uint64_t *);
+
+static void multiplierMotsSansRetour(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *r) {
+    if (multiplierMots(a, na, b, nb, r) != 0) {
+        printf("ERREUR : mémoire insuffisante\n");
+        exit(1);
+    }
+}
+
+// Temps moyen d'une multiplication en microsecondes
+static double mesurer(Multiplication fn, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *r) {
+    long repetitions = 1;
+    while (1) {
+        double debut = maintenant();
+        for (long i = 0; i < repetitions; i++) {
+            fn(a, n, b, n, r);
+        }
+        double duree = maintenant() - debut;
+        if (duree >= 0.1) {
+            return duree * 1e6 / (double)repetitions;
+        }
+        repetitions *= 2;
+    }
+}
+
+#define NB_PRODUITS 4096
+
+int main(void) {
+    const size_t tailles[] = {4, 16, 32, 64, 128, 256, 1024, 4096};
+    const int nbTailles = sizeof(tailles) / sizeof(tailles[0]);
+
+    printf("boucle interne : %s, seuil Karatsuba : %d mots\n",
+           grandNombreImplementation(), GRAND_NOMBRE_SEUIL_KARATSUBA);
+    if (verifierProduit128() + verifierMots() != 0) {
+        return 1;
+    }
+
+    // Produits 64 x 64 -> 128 indépendants
+    {
+        static uint64_t x[NB_PRODUITS], y[NB_PRODUITS];
+        uint64_t controle = 0;
+        long repetitions = 1;
+        double duree;
+        for (int i = 0; i < NB_PRODUITS; i++) {
+            x[i] = aleatoire64();
+            y[i] = aleatoire64();
+        }
+        while (1) {
+            double debut = maintenant();
+            for (long r = 0; r < repetitions; r++) {
+                for (int i = 0; i < NB_PRODUITS; i++) {
+                    Produit128 p = multiplier64(x[i], y[i]);
+                    controle += p.bas ^ p.haut;
+                }
+            }
+            duree = maintenant() - debut;
+            if (duree >= 0.1) break;
+            repetitions *= 2;
+        }
+        printf("multiplier64 : %.2f ns par produit (contrôle %llx)\n",
+               duree * 1e9 / ((double)repetitions * NB_PRODUITS), (unsigned long long)(controle & 0xFFFF));
+    }
+
+    printf("%8s %16s %16s %10s\n", "mots", "scolaire (us)", "multiplier (us)", "accél.");
+    for (int k = 0; k < nbTailles; k++) {
+        size_t n = tailles[k];
+        uint64_t *a = malloc(n * sizeof(uint64_t));
+        uint64_t *b = malloc(n * sizeof(uint64_t));
+        uint64_t *r = malloc(2 * n * sizeof(uint64_t));
+        for (size_t i = 0; i < n; i++) {
+            a[i] = aleatoire64();
+            b[i] = aleatoire64();
+        }
+
+        double t0 = mesurer(multiplierMotsScolaire, a, b, n, r);
+        double t1 = mesurer(multiplierMotsSansRetour, a, b, n, r);
+        printf("%8zu %16.3f %16.3f %9.2fx\n", n, t0, t1, t0 / t1);
+        free(a);
+        free(b);
+        free(r);
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*-----------------------------------
+       Benchmark de l'index par hachage
+
+   Pour un tableau non trié de n entiers, compare le parcours
+   (rechercher, une requête à la fois) et l'index par hachage
+   (index_hachage.c) : temps de construction, temps par requête,
+   et nombre de requêtes à partir duquel construire l'index est
+   rentable. Deux distributions : valeurs sur 32 bits (table de
+   hachage seule) et valeurs denses (index avec ensemble de bits).
+
+   gcc -O2 bench_index.c index_hachage.c recherche_simd.c -o bench_index
+   ./bench_index
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "index_hachage.h"
+#include "recherche.h"
+
+#define NB_CLES 65536
+
+static int cles[NB_CLES];
+static long resultats[NB_CLES];
+
+int main(void) {
+    const size_t tailles[] = {1000, 10000, 100000, 1000000, 10000000};
+    const char *noms[2] = {"aleatoire", "dense"};
+    int erreurs = 0;
+
+    printf("comparaison des octets de contrôle : %s, parcours : %s\n", indexImplementation(),
+           rechercherImplementation());
+    printf("%-10s %9s %14s %16s %14s %12s %10s\n", "valeurs", "n", "construction", "parcours", "index",
+           "index lot", "rentable");
+    printf("%-10s %9s %14s %16s %14s %12s %10s\n", "", "", "(ns/elem)", "(ns/req)", "(ns/req)", "(ns/req)",
+           "(req)");
+    for (int d = 0; d < 2; d++) {
+        for (size_t t = 0; t < sizeof(tailles) / sizeof(tailles[0]); t++) {
+            size_t n = tailles[t];
+            int *tab = malloc(n * sizeof(int));
+            if (tab == NULL) {
+                printf("Mémoire insuffisante\n");
+                return 1;
+            }
+            // dense : valeurs dans [0, 2n), avec des doublons
+            for (size_t i = 0; i < n; i++) {
+                tab[i] = d == 0 ? (int)aleatoire() : (int)(aleatoire() % (2 * n));
+            }
+            // Trois requêtes sur quatre sont présentes
+            for (size_t k = 0; k < NB_CLES; k++) {
+                cles[k] = k % 4 == 3 ? (int)aleatoire() : tab[aleatoire() % n];
+            }
+
+            IndexHachage index;
+            double debut = maintenant();
+            if (indexCreer(&index, tab, n) != 0) {
+                printf("Mémoire insuffisante pour l'index (n = %zu)\n", n);
+                free(tab);
+                return 1;
+            }
+            double construction = maintenant() - debut;
+
+            // Le parcours est en O(n) : moins de requêtes pour les grandes tables
+            size_t nbParcours = n >= 1000000 ? 64 : NB_CLES * 1000 / n;
+            nbParcours = nbParcours > NB_CLES ? NB_CLES : nbParcours;
+            debut = maintenant();
+            for (size_t k = 0; k < nbParcours; k++) {
+                resultats[k] = rechercher(tab, n, cles[k]);
+            }
+            double parcours = (maintenant() - debut) / nbParcours;
+
+            for (size_t k = 0; k < nbParcours; k++) {
+                erreurs += indexRechercher(&index, cles[k]) != resultats[k];
+            }
+            debut = maintenant();
+            for (size_t k = 0; k < NB_CLES; k++) {
+                resultats[k] = indexRechercher(&index, cles[k]);
+            }
+            double requete = (maintenant() - debut) / NB_CLES;
+            debut = maintenant();
+            indexRechercheLot(&index, cles, NB_CLES, resultats);
+            double lot = (maintenant() - debut) / NB_CLES;
+            for (size_t k = 0; k < NB_CLES; k++) {
+                erreurs += resultats[k] != indexRechercher(&index, cles[k]);
+            }
+
+            printf("%-10s %9zu %14.1f %16.1f %14.1f %12.1f %10.0f%s\n", noms[d], n, construction * 1e9 / n,
+                   parcours * 1e9, requete * 1e9, lot * 1e9, construction / (parcours - requete),
+                   index.bits != NULL ? "   (bits)" : "");
+            indexLiberer(&index);
+            free(tab);
+        }
+    }
+    if (erreurs != 0) {
+        printf("ERREUR : %d résultats différents de rechercher\n", erreurs);
+    }
+    return erreurs == 0 ? 0 : 1;
+}
@@ -0,0 +1,798 @@
+/*-----------------------------------
+       Benchmark de tous les noyaux du dépôt
+
+   Chaque algorithme est appelé comme une fonction de bibliothèque
+   sur des jeux de données générés, de taille et de distribution
+   choisies. Pour chaque mesure : ns par opération et, si le système
+   donne les compteurs perf, cycles, défauts de cache et erreurs de
+   prédiction de branchement par opération. Résultats en tableau
+   et, avec --json, dans un fichier pour suivre les régressions
+   d'un commit à l'autre.
+
+   cmake --build build --target bench          (écrit build/bench.json)
+   build/bench_noyaux --tailles 1000,100000 --noyaux tri --json tri.json
+
+   Options :
+     --tailles n1,n2,...       tailles des jeux de données (1024,65536,1048576)
+     --distributions d1,...    aleatoire, triee, inversee, peu_uniques (toutes)
+     --noyaux texte            seulement les noyaux dont le nom contient texte
+     --temps secondes          durée minimale de chaque mesure (0.05)
+     --json fichier            écrit aussi les résultats en JSON
+     --revision texte          version du code, recopiée dans le JSON
+     --graine n                graine du générateur (2463534242)
+     --liste                   affiche les noyaux et s'arrête
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arene.h"
+#include "bench_outils.h"
+#include "compteurs.h"
+#include "flux.h"
+#include "fonctions.h"
+#include "grand_nombre.h"
+#include "index_hachage.h"
+#include "recherche.h"
+#include "recherche_binaire.h"
+#include "temperature.h"
+#include "tri.h"
+#include "tri_parallele.h"
+
+typedef enum {
+    DISTRIBUTION_ALEATOIRE,
+    DISTRIBUTION_TRIEE,
+    DISTRIBUTION_INVERSEE,
+    DISTRIBUTION_PEU_UNIQUES,
+    NB_DISTRIBUTIONS
+} Distribution;
+
+static const char *nomsDistributions[NB_DISTRIBUTIONS] = {"aleatoire", "triee", "inversee", "peu_uniques"};
+
+static const char *nomsCompteurs[NB_COMPTEURS] = {"cycles", "defauts_cache", "branches_manquees"};
+
+// Chaque mesure traite au moins ce nombre d'éléments : sur les petits jeux,
+// le noyau est appelé plusieurs fois pour ne pas mesurer surtout le chronomètre
+#define ELEMENTS_PAR_APPEL 65536
+
+typedef void (*CalculTableau)(const int *, const int *, int *, size_t);
+
+typedef struct Noyau Noyau;
+
+// Données d'une mesure. x et y sont générés pour chaque couple (taille,
+// distribution) ; le reste est alloué dans l'arène par le noyau mesuré.
+typedef struct {
+    const Noyau *noyau;
+    Arene *arene;
+    size_t n;
+    int *x, *y;
+    size_t lots;             // appels du noyau par mesure
+    int *tampon;
+    int *trie;
+    int *cles;
+    size_t nbCles;
+    long *resultats;
+    TableEytzinger eytzinger;
+    IndexHachage index;
+    uint64_t *motsA, *motsB, *motsR;
+    char *texte;
+    size_t tailleTexte;
+} Banc;
+
+struct Noyau {
+    const char *nom;
+    const char *unite;                      // ce que compte une opération
+    size_t tailleMax;                       // 0 : pas de limite
+    const char *(*implementation)(void);    // variante choisie à l'exécution, ou NULL
+    // Alloue et remplit les tampons ; retourne le nombre d'opérations d'un appel
+    // à executer, 0 si l'arène est pleine
+    size_t (*preparer)(Banc *banc);
+    void (*reinitialiser)(Banc *banc);      // avant chaque appel, hors mesure (ou NULL)
+    void (*executer)(Banc *banc);
+    int (*verifier)(const Banc *banc);      // 0 si le résultat est juste (ou NULL)
+    void (*liberer)(Banc *banc);            // ou NULL
+    CalculTableau calcul;                   // noyaux de fonctions.h
+    int (*attendu)(int a, int b);           // et leur résultat élément par élément
+};
+
+static size_t lotsPour(size_t elements) {
+    return elements >= ELEMENTS_PAR_APPEL ? 1 : ELEMENTS_PAR_APPEL / elements;
+}
+
+// Clés des recherches : trois sur quatre sont des valeurs du tableau,
+// les autres sont tirées au hasard (presque toujours absentes)
+static int preparerCles(Banc *banc, size_t nbCles) {
+    banc->nbCles = nbCles;
+    banc->cles = areneTableau(banc->arene, int, nbCles);
+    banc->resultats = areneTableau(banc->arene, long, nbCles);
+    if (banc->cles == NULL || banc->resultats == NULL) {
+        return -1;
+    }
+    for (size_t k = 0; k < nbCles; k++) {
+        banc->cles[k] = (k % 4 == 3) ? (int)aleatoire() : banc->x[aleatoire() % banc->n];
+    }
+    return 0;
+}
+
+/*------------------------- Tri -------------------------*/
+
+static size_t preparerTri(Banc *banc) {
+    banc->lots = lotsPour(banc->n);
+    banc->tampon = areneTableau(banc->arene, int, banc->lots * banc->n);
+    return banc->tampon != NULL ? banc->lots * banc->n : 0;
+}
+
+// Le tri se fait en place : chaque appel repart de copies des données
+static void reinitialiserTri(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        memcpy(banc->tampon + l * banc->n, banc->x, banc->n * sizeof(int));
+    }
+}
+
+static void executerTriHybride(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        triInsertion(banc->tampon + l * banc->n, (int)banc->n);
+    }
+}
+
+static void executerTriSimple(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        triInsertionSimple(banc->tampon + l * banc->n, (int)banc->n);
+    }
+}
+
+// Tri par base seul, tampon de travail dans l'arène
+static size_t preparerTriRadix(Banc *banc) {
+    size_t operations = preparerTri(banc);
+    banc->trie = areneTableau(banc->arene, int, banc->n);
+    return banc->trie != NULL ? operations : 0;
+}
+
+static void executerTriRadix(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        triRadix(banc->tampon + l * banc->n, (int)banc->n, banc->trie);
+    }
+}
+
+// Un fil par processeur
+static void executerTriParallele(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        triParallele(banc->tampon + l * banc->n, banc->n, 0);
+    }
+}
+
+static int verifierTri(const Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        const int *t = banc->tampon + l * banc->n;
+        for (size_t i = 1; i < banc->n; i++) {
+            if (t[i - 1] > t[i]) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*------------------- Recherche linéaire -------------------*/
+
+#define CLES_RECHERCHE_INDEX 16384
+
+// Environ 2^24 éléments parcourus par appel, entre 128 et 16384 requêtes
+static size_t preparerRechercheLineaire(Banc *banc) {
+    size_t nbCles = ((size_t)1 << 24) / banc->n;
+    nbCles = nbCles < 128 ? 128 : nbCles > 16384 ? 16384 : nbCles;
+    return preparerCles(banc, nbCles) == 0 ? nbCles : 0;
+}
+
+static void executerRechercher(Banc *banc) {
+    for (size_t k = 0; k < banc->nbCles; k++) {
+        banc->resultats[k] = rechercher(banc->x, banc->n, banc->cles[k]);
+    }
+}
+
+static void executerRechercherScalaire(Banc *banc) {
+    for (size_t k = 0; k < banc->nbCles; k++) {
+        banc->resultats[k] = rechercherScalaire(banc->x, banc->n, banc->cles[k]);
+    }
+}
+
+static int verifierRechercheLineaire(const Banc *banc) {
+    for (size_t k = 0; k < banc->nbCles; k++) {
+        long i = banc->resultats[k];
+        if (i != rechercherScalaire(banc->x, banc->n, banc->cles[k])) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Index par hachage de x (construit hors mesure), mêmes requêtes
+static size_t preparerIndex(Banc *banc) {
+    if (preparerCles(banc, CLES_RECHERCHE_INDEX) != 0 || indexCreer(&banc->index, banc->x, banc->n) != 0) {
+        return 0;
+    }
+    return banc->nbCles;
+}
+
+static void libererIndex(Banc *banc) {
+    indexLiberer(&banc->index);
+}
+
+static void executerIndexLot(Banc *banc) {
+    indexRechercheLot(&banc->index, banc->cles, banc->nbCles, banc->resultats);
+}
+
+/*------------------- Recherche binaire -------------------*/
+
+#define CLES_RECHERCHE_BINAIRE 16384
+
+static size_t preparerRechercheBinaire(Banc *banc) {
+    banc->trie = areneTableau(banc->arene, int, banc->n);
+    if (banc->trie == NULL || preparerCles(banc, CLES_RECHERCHE_BINAIRE) != 0) {
+        return 0;
+    }
+    memcpy(banc->trie, banc->x, banc->n * sizeof(int));
+    triInsertion(banc->trie, (int)banc->n);
+    return CLES_RECHERCHE_BINAIRE;
+}
+
+static size_t preparerEytzinger(Banc *banc) {
+    size_t operations = preparerRechercheBinaire(banc);
+    if (operations == 0 || eytzingerCreer(&banc->eytzinger, banc->trie, banc->n) != 0) {
+        return 0;
+    }
+    return operations;
+}
+
+static void libererEytzinger(Banc *banc) {
+    eytzingerLiberer(&banc->eytzinger);
+}
+
+static void executerRechercheBinaire(Banc *banc) {
+    for (size_t k = 0; k < banc->nbCles; k++) {
+        banc->resultats[k] = rechercheBinaire(banc->trie, banc->n, banc->cles[k]);
+    }
+}
+
+static void executerRechercheLot(Banc *banc) {
+    rechercheLot(banc->trie, banc->n, banc->cles, banc->nbCles, banc->resultats);
+}
+
+static void executerEytzingerLot(Banc *banc) {
+    eytzingerRechercheLot(&banc->eytzinger, banc->cles, banc->nbCles, banc->resultats);
+}
+
+static int verifierRechercheBinaire(const Banc *banc) {
+    for (size_t k = 0; k < banc->nbCles; k++) {
+        long i = banc->resultats[k];
+        if (i != rechercheBinaire(banc->trie, banc->n, banc->cles[k]) ||
+            (i >= 0 && banc->trie[i] != banc->cles[k])) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*------------------ Calculs sur tableaux ------------------*/
+
+static size_t preparerCalcul(Banc *banc) {
+    banc->lots = lotsPour(banc->n);
+    banc->tampon = areneTableau(banc->arene, int, banc->n);
+    return banc->tampon != NULL ? banc->lots * banc->n : 0;
+}
+
+static void executerCalcul(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        banc->noyau->calcul(banc->x, banc->y, banc->tampon, banc->n);
+    }
+}
+
+static int verifierCalcul(const Banc *banc) {
+    for (size_t i = 0; i < banc->n; i++) {
+        if (banc->tampon[i] != banc->noyau->attendu(banc->x[i], banc->y[i])) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static void sommeVerifieeSansRetour(const int *a, const int *b, int *out, size_t n) {
+    (void)somme_n_verifiee(a, b, out, n);
+}
+
+static void multiplicationVerifieeSansRetour(const int *a, const int *b, int *out, size_t n) {
+    (void)multiplication_n_verifiee(a, b, out, n);
+}
+
+static int sature(long long v) {
+    return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (int)v;
+}
+
+static int sommeModulo(int a, int b) { return (int)((unsigned)a + (unsigned)b); }
+static int sommeSaturee(int a, int b) { return sature((long long)a + b); }
+static int comparaisonAttendue(int a, int b) { return comparaison(a, b); }
+static int multiplicationModulo(int a, int b) { return (int)((unsigned)a * (unsigned)b); }
+static int multiplicationSaturee(int a, int b) { return sature((long long)a * b); }
+
+/*--------------------- Grands nombres ---------------------*/
+
+// n mots par opérande, fabriqués à partir de x et y
+static size_t preparerMots(Banc *banc) {
+    banc->motsA = areneTableau(banc->arene, uint64_t, banc->n);
+    banc->motsB = areneTableau(banc->arene, uint64_t, banc->n);
+    banc->motsR = areneTableau(banc->arene, uint64_t, 2 * banc->n);
+    if (banc->motsA == NULL || banc->motsB == NULL || banc->motsR == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < banc->n; i++) {
+        banc->motsA[i] = (uint64_t)(uint32_t)banc->x[i] << 32 | (uint32_t)banc->y[i];
+        banc->motsB[i] = (uint64_t)(uint32_t)banc->y[i] << 32 | (uint32_t)banc->x[i];
+    }
+    return 1;
+}
+
+// Une opération par produit de deux nombres de n mots ; au moins 4096 mots par appel
+static size_t preparerMultiplierMots(Banc *banc) {
+    if (preparerMots(banc) == 0) {
+        return 0;
+    }
+    banc->lots = banc->n >= 4096 ? 1 : 4096 / banc->n;
+    return banc->lots;
+}
+
+static void executerMultiplierMots(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        if (multiplierMots(banc->motsA, banc->n, banc->motsB, banc->n, banc->motsR) != 0) {
+            banc->motsR[0] = 0;
+        }
+    }
+}
+
+static void executerMultiplierMotsScolaire(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        multiplierMotsScolaire(banc->motsA, banc->n, banc->motsB, banc->n, banc->motsR);
+    }
+}
+
+// Karatsuba contre la méthode scolaire, jusqu'à 4096 mots (au-delà, trop long)
+static int verifierMultiplierMots(const Banc *banc) {
+    if (banc->n > 4096) {
+        return 0;
+    }
+    uint64_t *attendu = malloc(2 * banc->n * sizeof(uint64_t));
+    if (attendu == NULL) {
+        return 0;
+    }
+    multiplierMotsScolaire(banc->motsA, banc->n, banc->motsB, banc->n, attendu);
+    int erreur = memcmp(attendu, banc->motsR, 2 * banc->n * sizeof(uint64_t)) != 0 ? -1 : 0;
+    free(attendu);
+    return erreur;
+}
+
+// Une opération par produit 64 x 64 -> 128 bits
+static size_t preparerMultiplier64(Banc *banc) {
+    if (preparerMots(banc) == 0) {
+        return 0;
+    }
+    banc->lots = lotsPour(banc->n);
+    return banc->lots * banc->n;
+}
+
+static void executerMultiplier64(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        for (size_t i = 0; i < banc->n; i++) {
+            Produit128 p = multiplier64(banc->motsA[i], banc->motsB[i]);
+            banc->motsR[2 * i] = p.bas;
+            banc->motsR[2 * i + 1] = p.haut;
+        }
+    }
+}
+
+/*----------------------- Température -----------------------*/
+
+static size_t preparerTemperature(Banc *banc) {
+    banc->lots = lotsPour(banc->n);
+    banc->trie = areneTableau(banc->arene, int, banc->n);
+    banc->tampon = areneTableau(banc->arene, int, banc->n);
+    if (banc->trie == NULL || banc->tampon == NULL) {
+        return 0;
+    }
+    // Relevés de -1000 °F à 1000 °F avec une partie fractionnaire
+    for (size_t i = 0; i < banc->n; i++) {
+        banc->trie[i] = temperatureDepuisEntier(banc->x[i] % 1000) + (banc->y[i] & 0xFFFF);
+    }
+    return banc->lots * banc->n;
+}
+
+static void executerTemperature(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        convertirFahrenheitQ16(banc->trie, banc->tampon, banc->n);
+    }
+}
+
+static int verifierTemperature(const Banc *banc) {
+    for (size_t i = 0; i < banc->n; i++) {
+        if (banc->tampon[i] != celsiusDepuisFahrenheitQ16(banc->trie[i])) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*------------------- Lecture d'entiers -------------------*/
+
+// x écrit en texte, un entier par ligne, puis relu par lireEntier
+static size_t preparerLecture(Banc *banc) {
+    banc->texte = areneTableau(banc->arene, char, 12 * banc->n);
+    banc->tampon = areneTableau(banc->arene, int, banc->n);
+    if (banc->texte == NULL || banc->tampon == NULL) {
+        return 0;
+    }
+    char *p = banc->texte;
+    for (size_t i = 0; i < banc->n; i++) {
+        p += sprintf(p, "%d\n", banc->x[i]);
+    }
+    banc->tailleTexte = (size_t)(p - banc->texte);
+    banc->lots = lotsPour(banc->n);
+    return banc->lots * banc->n;
+}
+
+static void executerLecture(Banc *banc) {
+    for (size_t l = 0; l < banc->lots; l++) {
+        LecteurEntiers lecteur;
+        lecteurDepuisMemoire(&lecteur, banc->texte, banc->tailleTexte);
+        if (lireEntiers(&lecteur, banc->tampon, banc->n) != (long)banc->n) {
+            banc->tampon[0] = ~banc->x[0];
+        }
+    }
+}
+
+static int verifierLecture(const Banc *banc) {
+    return memcmp(banc->tampon, banc->x, banc->n * sizeof(int)) == 0 ? 0 : -1;
+}
+
+/*-------------------------------------------------------------*/
+
+static const Noyau noyaux[] = {
+    {"tri_hybride", "element", 0, NULL,
+     preparerTri, reinitialiserTri, executerTriHybride, verifierTri, NULL, NULL, NULL},
+    {"tri_radix", "element", 0, NULL,
+     preparerTriRadix, reinitialiserTri, executerTriRadix, verifierTri, NULL, NULL, NULL},
+    {"tri_parallele", "element", 0, NULL,
+     preparerTri, reinitialiserTri, executerTriParallele, verifierTri, NULL, NULL, NULL},
+    {"tri_insertion_simple", "element", 16384, NULL,
+     preparerTri, reinitialiserTri, executerTriSimple, verifierTri, NULL, NULL, NULL},
+    {"rechercher", "requete", 0, rechercherImplementation,
+     preparerRechercheLineaire, NULL, executerRechercher, verifierRechercheLineaire, NULL, NULL, NULL},
+    {"rechercher_scalaire", "requete", 0, NULL,
+     preparerRechercheLineaire, NULL, executerRechercherScalaire, NULL, NULL, NULL, NULL},
+    {"index_hachage_lot", "requete", 0, indexImplementation,
+     preparerIndex, NULL, executerIndexLot, verifierRechercheLineaire, libererIndex, NULL, NULL},
+    {"recherche_binaire", "requete", 0, NULL,
+     preparerRechercheBinaire, NULL, executerRechercheBinaire, verifierRechercheBinaire, NULL, NULL, NULL},
+    {"recherche_binaire_lot", "requete", 0, NULL,
+     preparerRechercheBinaire, NULL, executerRechercheLot, verifierRechercheBinaire, NULL, NULL, NULL},
+    {"eytzinger_lot", "requete", 0, NULL,
+     preparerEytzinger, NULL, executerEytzingerLot, verifierRechercheBinaire, libererEytzinger, NULL, NULL},
+    {"somme_n", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, somme_n, sommeModulo},
+    {"somme_n_saturee", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, somme_n_saturee, sommeSaturee},
+    {"somme_n_verifiee", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, sommeVerifieeSansRetour, sommeModulo},
+    {"comparaison_n", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, comparaison_n, comparaisonAttendue},
+    {"multiplication_n", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, multiplication_n, multiplicationModulo},
+    {"multiplication_n_saturee", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, multiplication_n_saturee, multiplicationSaturee},
+    {"multiplication_n_verifiee", "element", 0, calculImplementation,
+     preparerCalcul, NULL, executerCalcul, verifierCalcul, NULL, multiplicationVerifieeSansRetour, multiplicationModulo},
+    {"multiplier64", "produit", 0, NULL,
+     preparerMultiplier64, NULL, executerMultiplier64, NULL, NULL, NULL, NULL},
+    {"multiplier_mots", "multiplication", 16384, grandNombreImplementation,
+     preparerMultiplierMots, NULL, executerMultiplierMots, verifierMultiplierMots, NULL, NULL, NULL},
+    {"multiplier_mots_scolaire", "multiplication", 4096, grandNombreImplementation,
+     preparerMultiplierMots, NULL, executerMultiplierMotsScolaire, NULL, NULL, NULL, NULL},
+    {"celsius_q16", "element", 0, NULL,
+     preparerTemperature, NULL, executerTemperature, verifierTemperature, NULL, NULL, NULL},
+    {"lire_entiers", "entier", 0, NULL,
+     preparerLecture, NULL, executerLecture, verifierLecture, NULL, NULL, NULL},
+};
+
+#define NB_NOYAUX (sizeof(noyaux) / sizeof(noyaux[0]))
+
+typedef struct {
+    const Noyau *noyau;
+    Distribution distribution;
+    size_t n;
+    size_t operations;          // par appel
+    long repetitions;
+    double secondes;
+    uint64_t compteurs[NB_COMPTEURS];
+} Resultat;
+
+static void genererDonnees(int *t, size_t n, Distribution distribution) {
+    for (size_t i = 0; i < n; i++) {
+        switch (distribution) {
+        case DISTRIBUTION_TRIEE:      t[i] = (int)(2 * i); break;
+        case DISTRIBUTION_INVERSEE:   t[i] = (int)(2 * (n - 1 - i)); break;
+        case DISTRIBUTION_PEU_UNIQUES: t[i] = (int)(aleatoire() % 16); break;
+        default:                      t[i] = (int)aleatoire(); break;
+        }
+    }
+}
+
+// 0 si la mesure est faite, -1 si l'arène est pleine, -2 si le résultat est faux
+static int mesurer(const Noyau *noyau, Banc *banc, Compteurs *compteurs, double tempsMin, Resultat *resultat) {
+    int statut = 0;
+    size_t operations = noyau->preparer(banc);
+
+    memset(resultat, 0, sizeof(*resultat));
+    if (operations == 0) {
+        statut = -1;
+    } else {
+        // Un premier appel hors mesure : caches, pages, choix du noyau SIMD
+        if (noyau->reinitialiser != NULL) noyau->reinitialiser(banc);
+        noyau->executer(banc);
+        if (noyau->verifier != NULL && noyau->verifier(banc) != 0) {
+            statut = -2;
+        }
+    }
+    while (statut == 0 && (resultat->secondes < tempsMin || resultat->repetitions < 3)) {
+        if (noyau->reinitialiser != NULL) noyau->reinitialiser(banc);
+        compteursDemarrer(compteurs);
+        double debut = maintenant();
+        noyau->executer(banc);
+        double fin = maintenant();
+        compteursArreter(compteurs, resultat->compteurs);
+        resultat->secondes += fin - debut;
+        resultat->repetitions++;
+    }
+    resultat->operations = operations;
+    if (noyau->liberer != NULL) {
+        noyau->liberer(banc);
+    }
+    return statut;
+}
+
+static double parOperation(const Resultat *r, double valeur) {
+    return valeur / ((double)r->repetitions * (double)r->operations);
+}
+
+// Chaîne JSON : seuls les guillemets, barres obliques inverses et caractères de contrôle sont échappés
+static void ecrireTexteJson(FILE *f, const char *texte) {
+    fputc('"', f);
+    for (; *texte != '\0'; texte++) {
+        unsigned char c = (unsigned char)*texte;
+        if (c == '"' || c == '\\') {
+            fprintf(f, "\\%c", c);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+static int ecrireJson(const char *chemin, const char *revision, const Compteurs *compteurs,
+                      const Resultat *resultats, size_t nbResultats) {
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL) {
+        return -1;
+    }
+
+    char date[32];
+    time_t t = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&t));
+
+    fprintf(f, "{\n  \"revision\": ");
+    ecrireTexteJson(f, revision);
+    fprintf(f, ",\n  \"date\": \"%s\",\n  \"compteurs\": {", date);
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        fprintf(f, "%s\"%s\": %s", k ? ", " : "", nomsCompteurs[k],
+                compteurDisponible(compteurs, (TypeCompteur)k) ? "true" : "false");
+    }
+    fprintf(f, "},\n  \"resultats\": [\n");
+
+    for (size_t i = 0; i < nbResultats; i++) {
+        const Resultat *r = &resultats[i];
+        const char *implementation = r->noyau->implementation != NULL ? r->noyau->implementation() : "";
+        fprintf(f, "    {\"noyau\": \"%s\", \"implementation\": \"%s\", \"distribution\": \"%s\", "
+                   "\"n\": %zu, \"unite\": \"%s\", \"operations\": %zu, \"repetitions\": %ld, "
+                   "\"ns_par_op\": %.6g",
+                r->noyau->nom, implementation, nomsDistributions[r->distribution],
+                r->n, r->noyau->unite, r->operations, r->repetitions,
+                parOperation(r, r->secondes * 1e9));
+        for (int k = 0; k < NB_COMPTEURS; k++) {
+            fprintf(f, ", \"%s_par_op\": ", nomsCompteurs[k]);
+            if (compteurDisponible(compteurs, (TypeCompteur)k)) {
+                fprintf(f, "%.6g", parOperation(r, (double)r->compteurs[k]));
+            } else {
+                fprintf(f, "null");
+            }
+        }
+        fprintf(f, "}%s\n", i + 1 < nbResultats ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+static void afficherResultat(const Resultat *r, const Compteurs *compteurs) {
+    printf("%-26s %-12s %9zu %12.3f", r->noyau->nom, nomsDistributions[r->distribution], r->n,
+           parOperation(r, r->secondes * 1e9));
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        if (compteurDisponible(compteurs, (TypeCompteur)k)) {
+            printf(" %18.3f", parOperation(r, (double)r->compteurs[k]));
+        } else {
+            printf(" %18s", "-");
+        }
+    }
+    printf("   %s\n", r->noyau->unite);
+}
+
+// Liste "a,b,c" -> valeurs ; retourne leur nombre, 0 si une valeur est invalide
+static size_t lireTailles(const char *texte, size_t *tailles, size_t max) {
+    size_t nb = 0;
+    while (*texte != '\0' && nb < max) {
+        char *fin;
+        unsigned long long v = strtoull(texte, &fin, 10);
+        if (fin == texte || v == 0 || (*fin != ',' && *fin != '\0')) {
+            return 0;
+        }
+        tailles[nb++] = (size_t)v;
+        texte = *fin == ',' ? fin + 1 : fin;
+    }
+    return nb;
+}
+
+static size_t lireDistributions(const char *texte, Distribution *distributions) {
+    size_t nb = 0;
+    while (*texte != '\0') {
+        size_t longueur = strcspn(texte, ",");
+        int trouvee = 0;
+        for (int d = 0; d < NB_DISTRIBUTIONS; d++) {
+            if (strlen(nomsDistributions[d]) == longueur && strncmp(texte, nomsDistributions[d], longueur) == 0) {
+                if (nb < NB_DISTRIBUTIONS) distributions[nb++] = (Distribution)d;
+                trouvee = 1;
+            }
+        }
+        if (!trouvee) {
+            return 0;
+        }
+        texte += longueur + (texte[longueur] == ',');
+    }
+    return nb;
+}
+
+#define MAX_TAILLES 16
+
+int main(int argc, char **argv) {
+    size_t tailles[MAX_TAILLES] = {1024, 65536, 1048576};
+    size_t nbTailles = 3;
+    Distribution distributions[NB_DISTRIBUTIONS] = {
+        DISTRIBUTION_ALEATOIRE, DISTRIBUTION_TRIEE, DISTRIBUTION_INVERSEE, DISTRIBUTION_PEU_UNIQUES};
+    size_t nbDistributions = NB_DISTRIBUTIONS;
+    const char *filtre = "";
+    const char *cheminJson = NULL;
+    const char *revision = "inconnue";
+    double tempsMin = 0.05;
+
+    for (int i = 1; i < argc; i++) {
+        const char *option = argv[i];
+        const char *valeur = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(option, "--liste") == 0) {
+            for (size_t k = 0; k < NB_NOYAUX; k++) printf("%s\n", noyaux[k].nom);
+            return 0;
+        }
+        if (valeur == NULL) {
+            fprintf(stderr, "option inconnue ou sans valeur : %s\n", option);
+            return 2;
+        }
+        i++;
+        if (strcmp(option, "--tailles") == 0) {
+            nbTailles = lireTailles(valeur, tailles, MAX_TAILLES);
+        } else if (strcmp(option, "--distributions") == 0) {
+            nbDistributions = lireDistributions(valeur, distributions);
+        } else if (strcmp(option, "--noyaux") == 0) {
+            filtre = valeur;
+        } else if (strcmp(option, "--temps") == 0) {
+            tempsMin = atof(valeur);
+        } else if (strcmp(option, "--json") == 0) {
+            cheminJson = valeur;
+        } else if (strcmp(option, "--revision") == 0) {
+            revision = valeur;
+        } else if (strcmp(option, "--graine") == 0) {
+            aleatoireGraine((unsigned int)strtoul(valeur, NULL, 10));
+        } else {
+            fprintf(stderr, "option inconnue : %s\n", option);
+            return 2;
+        }
+        if (nbTailles == 0 || nbDistributions == 0) {
+            fprintf(stderr, "valeur invalide pour %s : %s\n", option, valeur);
+            return 2;
+        }
+    }
+
+    // Une arène pour toutes les mesures : les données x et y, puis les tampons
+    // du noyau mesuré, rendus après chaque mesure (40 octets par élément au plus,
+    // pour les produits de grands nombres)
+    size_t nMax = ELEMENTS_PAR_APPEL;
+    for (size_t t = 0; t < nbTailles; t++) {
+        if (tailles[t] > nMax) nMax = tailles[t];
+    }
+    Arene arene;
+    if (areneCreer(&arene, 48 * nMax + (1u << 20)) != 0) {
+        fprintf(stderr, "mémoire insuffisante pour n = %zu\n", nMax);
+        return 1;
+    }
+
+    Compteurs compteurs;
+    compteursOuvrir(&compteurs);
+
+    size_t maxResultats = NB_NOYAUX * nbTailles * nbDistributions;
+    Resultat *resultats = malloc(maxResultats * sizeof(Resultat));
+    size_t nbResultats = 0;
+    int erreurs = 0;
+    if (resultats == NULL) {
+        fprintf(stderr, "mémoire insuffisante\n");
+        return 1;
+    }
+
+    printf("%-26s %-12s %9s %12s", "noyau", "distribution", "n", "ns/op");
+    for (int k = 0; k < NB_COMPTEURS; k++) printf(" %18s", nomsCompteurs[k]);
+    printf("\n");
+
+    for (size_t t = 0; t < nbTailles; t++) {
+        for (size_t d = 0; d < nbDistributions; d++) {
+            Banc banc;
+            memset(&banc, 0, sizeof(banc));
+            areneVider(&arene);
+            banc.arene = &arene;
+            banc.n = tailles[t];
+            banc.x = areneTableau(&arene, int, banc.n);
+            banc.y = areneTableau(&arene, int, banc.n);
+            genererDonnees(banc.x, banc.n, distributions[d]);
+            genererDonnees(banc.y, banc.n, distributions[d]);
+            const size_t marque = areneMarque(&arene);
+
+            for (size_t k = 0; k < NB_NOYAUX; k++) {
+                const Noyau *noyau = &noyaux[k];
+                if (strstr(noyau->nom, filtre) == NULL || (noyau->tailleMax != 0 && banc.n > noyau->tailleMax)) {
+                    continue;
+                }
+                Resultat *r = &resultats[nbResultats];
+                banc.noyau = noyau;
+                areneRevenir(&arene, marque);
+                int statut = mesurer(noyau, &banc, &compteurs, tempsMin, r);
+                if (statut == -1) {
+                    fprintf(stderr, "%s : mémoire insuffisante pour n = %zu\n", noyau->nom, banc.n);
+                    continue;
+                }
+                if (statut == -2) {
+                    printf("ERREUR : %s, %s, n = %zu : résultat faux\n", noyau->nom,
+                           nomsDistributions[distributions[d]], banc.n);
+                    erreurs++;
+                    continue;
+                }
+                r->noyau = noyau;
+                r->distribution = distributions[d];
+                r->n = banc.n;
+                afficherResultat(r, &compteurs);
+                nbResultats++;
+            }
+        }
+    }
+
+    if (cheminJson != NULL && ecrireJson(cheminJson, revision, &compteurs, resultats, nbResultats) != 0) {
+        fprintf(stderr, "impossible d'écrire %s\n", cheminJson);
+        erreurs++;
+    }
+    compteursFermer(&compteurs);
+    areneDetruire(&arene);
+    free(resultats);
+    return erreurs == 0 ? 0 : 1;
+}
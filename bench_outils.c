@@ -0,0 +1,21 @@
+#include <time.h>
+#include "bench_outils.h"
+
+static unsigned int graine = GRAINE_DEFAUT;
+
+void aleatoireGraine(unsigned int valeur) {
+    graine = valeur != 0 ? valeur : GRAINE_DEFAUT;
+}
+
+unsigned int aleatoire(void) {
+    graine ^= graine << 13;
+    graine ^= graine >> 17;
+    graine ^= graine << 5;
+    return graine;
+}
+
+double maintenant(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
@@ -0,0 +1,28 @@
+// Outils communs aux benchmarks : générateur pseudo-aléatoire déterministe
+// (xorshift32) et horloge monotone.
+// Tous les benchmarks partent de la même graine, de sorte qu'un même jeu de
+// données se retrouve d'un banc à l'autre et d'une exécution à l'autre.
+
+#ifndef BENCH_OUTILS_H
+#define BENCH_OUTILS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GRAINE_DEFAUT 2463534242u
+
+// Repart de la graine donnée (0, point fixe du xorshift, donne GRAINE_DEFAUT)
+void aleatoireGraine(unsigned int graine);
+
+// Entier pseudo-aléatoire suivant
+unsigned int aleatoire(void);
+
+// Temps de l'horloge monotone, en secondes
+double maintenant(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+/*-----------------------------------
+       Benchmark de la recherche linéaire
+
+   Compare la boucle d'origine de recherche.c
+   (un élément à la fois, sortie anticipée)
+   au noyau vectorisé de rechercher().
+
+   gcc -O2 bench_recherche.c recherche_simd.c -o bench_recherche
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "recherche.h"
+
+// Boucle de recherche.c, telle qu'elle était
+static long boucleOrigine(const int *tab, size_t n, int b) {
+    for (size_t i = 0; i < n; i++) {
+        if (b == tab[i]) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+#define NB_REQUETES 4096
+
+// Temps moyen par requête en nanosecondes ; somme sert de contrôle
+static double mesurer(long (*fn)(const int *, size_t, int), const int *tab, size_t n,
+                      const int *requetes, long *somme) {
+    long repetitions = 1;
+    while (1) {
+        long s = 0;
+        double debut = maintenant();
+        for (long r = 0; r < repetitions; r++) {
+            for (int q = 0; q < NB_REQUETES; q++) {
+                s += fn(tab, n, requetes[q]);
+            }
+        }
+        double duree = maintenant() - debut;
+        if (duree >= 0.1) {
+            *somme = s / repetitions;
+            return duree * 1e9 / ((double)repetitions * NB_REQUETES);
+        }
+        repetitions *= 2;
+    }
+}
+
+int main(void) {
+    const size_t tailles[] = {16, 256, 1024, 4096, 16384, 65536};
+    const int nbTailles = sizeof(tailles) / sizeof(tailles[0]);
+    int requetes[NB_REQUETES];
+
+    printf("noyau : %s\n", rechercherImplementation());
+    printf("%8s %14s %14s %14s %10s\n", "n", "origine (ns)", "scalaire (ns)", "simd (ns)", "simd Go/s");
+
+    for (int k = 0; k < nbTailles; k++) {
+        size_t n = tailles[k];
+        int *tab = malloc(n * sizeof(int));
+
+        // Valeurs distinctes : identifiants 0..n-1 mélangés
+        for (size_t i = 0; i < n; i++) tab[i] = (int)i;
+        for (size_t i = n - 1; i > 0; i--) {
+            size_t j = aleatoire() % (i + 1);
+            int t = tab[i]; tab[i] = tab[j]; tab[j] = t;
+        }
+        // Trois requêtes sur quatre sont présentes, les autres absentes
+        for (int q = 0; q < NB_REQUETES; q++) {
+            requetes[q] = (q % 4 == 3) ? -1 - q : (int)(aleatoire() % n);
+        }
+
+        long s0, s1, s2;
+        double t0 = mesurer(boucleOrigine, tab, n, requetes, &s0);
+        double t1 = mesurer(rechercherScalaire, tab, n, requetes, &s1);
+        double t2 = mesurer(rechercher, tab, n, requetes, &s2);
+        if (s0 != s1 || s0 != s2) {
+            printf("ERREUR : résultats différents (n = %zu)\n", n);
+            return 1;
+        }
+
+        // Octets parcourus en moyenne : 5/8 du tableau (présents à mi-chemin, absents en entier)
+        double octets = (double)n * sizeof(int) * 0.625;
+        printf("%8zu %14.1f %14.1f %14.1f %10.2f\n", n, t0, t1, t2, octets / t2);
+        free(tab);
+    }
+    return 0;
+}
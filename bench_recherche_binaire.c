@@ -0,0 +1,95 @@
+/*-----------------------------------
+      Benchmark de la recherche binaire
+
+   Boucle d'origine (milieu = (debut + fin) / 2)
+   contre borneInferieure, rechercheLot et la
+   disposition d'Eytzinger, jusqu'à des tables
+   bien plus grandes que le cache L2.
+
+   gcc -O2 bench_recherche_binaire.c recherche_binaire.c -o bench_recherche_binaire
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "recherche_binaire.h"
+
+// Boucle de binary_search.c, telle qu'elle était
+static long boucleOrigine(const int *tab, size_t taille, int b) {
+    long debut = 0;
+    long fin = (long)taille - 1;
+    while (debut <= fin) {
+        long milieu = (debut + fin) / 2;
+        if (tab[milieu] == b) {
+            return milieu;
+        } else if (tab[milieu] < b) {
+            debut = milieu + 1;
+        } else {
+            fin = milieu - 1;
+        }
+    }
+    return -1;
+}
+
+#define NB_CLES (1 << 20)
+
+int main(void) {
+    const size_t tailles[] = {1024, 65536, 1 << 20, 1 << 23};
+    const int nbTailles = sizeof(tailles) / sizeof(tailles[0]);
+    int *cles = malloc(NB_CLES * sizeof(int));
+    long *resultats = malloc(NB_CLES * sizeof(long));
+
+    printf("%10s %12s %12s %12s %12s %12s   (ns par clé)\n",
+           "n", "origine", "sans_branch", "lot", "eytzinger", "eytz_lot");
+
+    for (int k = 0; k < nbTailles; k++) {
+        size_t n = tailles[k];
+        int *tab = malloc(n * sizeof(int));
+        for (size_t i = 0; i < n; i++) tab[i] = (int)(2 * i);
+        // Moitié des clés présentes (paires), moitié absentes (impaires)
+        for (int q = 0; q < NB_CLES; q++) cles[q] = (int)(aleatoire() % (2 * n));
+
+        TableEytzinger table;
+        if (eytzingerCreer(&table, tab, n) != 0) {
+            printf("Allocation impossible\n");
+            return 1;
+        }
+
+        double temps[5];
+        long controle[5];
+        for (int methode = 0; methode < 5; methode++) {
+            long s = 0;
+            double debut = maintenant();
+            if (methode == 2) {
+                rechercheLot(tab, n, cles, NB_CLES, resultats);
+            } else if (methode == 4) {
+                eytzingerRechercheLot(&table, cles, NB_CLES, resultats);
+            } else {
+                for (int q = 0; q < NB_CLES; q++) {
+                    resultats[q] = methode == 0 ? boucleOrigine(tab, n, cles[q])
+                                 : methode == 1 ? rechercheBinaire(tab, n, cles[q])
+                                 : eytzingerRechercher(&table, cles[q]);
+                }
+            }
+            for (int q = 0; q < NB_CLES; q++) {
+                s += resultats[q];
+            }
+            temps[methode] = (maintenant() - debut) * 1e9 / NB_CLES;
+            controle[methode] = s;
+        }
+        for (int methode = 1; methode < 5; methode++) {
+            if (controle[methode] != controle[0]) {
+                printf("ERREUR : la méthode %d donne un résultat différent (n = %zu)\n", methode, n);
+                return 1;
+            }
+        }
+        printf("%10zu %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+               n, temps[0], temps[1], temps[2], temps[3], temps[4]);
+
+        eytzingerLiberer(&table);
+        free(tab);
+    }
+    free(cles);
+    free(resultats);
+    return 0;
+}
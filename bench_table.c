@@ -0,0 +1,145 @@
+/*-----------------------------------
+       Benchmark du démarrage d'une table triée
+
+   Temps entre le lancement et la première réponse pour une
+   table de n entiers (10^7 par défaut) :
+     - texte : lecture (flux.c), tri puis recherche, ce que fait
+       binary_search sur un fichier texte ;
+     - binaire : tableOuvrir (mmap) puis recherche, sur un fichier
+       écrit par tableEcrire, avec et sans disposition d'Eytzinger.
+   Puis le temps par requête une fois les pages chargées.
+   Les fichiers sont dans le cache du système : le cas binaire ne
+   paie que les défauts de page des pages réellement lues.
+
+   gcc -O2 bench_table.c table_triee.c recherche_binaire.c flux.c tri.c -o bench_table
+   ./bench_table [n] [répertoire temporaire]
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_outils.h"
+#include "flux.h"
+#include "table_triee.h"
+#include "tri.h"
+
+#define NB_REQUETES 16384
+
+static EcrivainEntiers ecrivain;
+static int requetes[NB_REQUETES];
+static long attendus[NB_REQUETES], resultats[NB_REQUETES];
+
+static int verifier(const char *nom) {
+    for (int q = 0; q < NB_REQUETES; q++) {
+        if (resultats[q] != attendus[q]) {
+            printf("ERREUR : %s, requête %d\n", nom, q);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Démarrage et requêtes sur un fichier binaire ; 0 si les résultats sont justes
+static int mesurerBinaire(const char *nom, const char *chemin) {
+    TableTriee table;
+    double debut = maintenant();
+    if (tableOuvrir(&table, chemin) != 0) {
+        printf("Impossible d'ouvrir %s\n", chemin);
+        return 1;
+    }
+    resultats[0] = tableRechercher(&table, requetes[0]);
+    double demarrage = maintenant() - debut;
+
+    // Premier passage : les pages sont chargées à la demande
+    debut = maintenant();
+    tableRechercheLot(&table, requetes, NB_REQUETES, resultats);
+    double froid = maintenant() - debut;
+    debut = maintenant();
+    tableRechercheLot(&table, requetes, NB_REQUETES, resultats);
+    double chaud = maintenant() - debut;
+    tableFermer(&table);
+
+    printf("%-22s %12.3f ms %12.1f %12.1f\n", nom, demarrage * 1e3, froid * 1e9 / NB_REQUETES,
+           chaud * 1e9 / NB_REQUETES);
+    return verifier(nom);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    const char *repertoire = argc > 2 ? argv[2] : ".";
+    char cheminTexte[512], cheminBinaire[512], cheminEytzinger[512];
+    int erreurs = 0;
+
+    snprintf(cheminTexte, sizeof(cheminTexte), "%s/bench_table.txt", repertoire);
+    snprintf(cheminBinaire, sizeof(cheminBinaire), "%s/bench_table.bin", repertoire);
+    snprintf(cheminEytzinger, sizeof(cheminEytzinger), "%s/bench_table_eytzinger.bin", repertoire);
+
+    int *valeurs = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (valeurs == NULL || n == 0 || n > 0x7FFFFFFF) {
+        printf("n invalide ou mémoire insuffisante\n");
+        return 1;
+    }
+    // Le fichier texte est dans le désordre : binary_search doit le trier
+    for (size_t i = 0; i < n; i++) valeurs[i] = (int)(2 * i);
+    for (size_t i = n - 1; i > 0; i--) {
+        size_t j = aleatoire() % (i + 1);
+        int t = valeurs[i]; valeurs[i] = valeurs[j]; valeurs[j] = t;
+    }
+    FILE *f = fopen(cheminTexte, "w");
+    if (f == NULL) {
+        printf("Impossible d'écrire %s\n", cheminTexte);
+        return 1;
+    }
+    ecrivainInit(&ecrivain, f);
+    ecrireEntiers(&ecrivain, valeurs, n);
+    erreurs += ecrivainVider(&ecrivain) != 0;
+    fclose(f);
+
+    triInsertion(valeurs, (int)n);
+    if (tableEcrire(cheminBinaire, valeurs, n, 0) != 0 ||
+        tableEcrire(cheminEytzinger, valeurs, n, TABLE_EYTZINGER) != 0) {
+        printf("Impossible d'écrire les tables\n");
+        return 1;
+    }
+    // Une requête sur deux est présente (valeur paire)
+    for (int q = 0; q < NB_REQUETES; q++) {
+        requetes[q] = (int)(aleatoire() % (2 * n));
+        attendus[q] = requetes[q] % 2 == 0 ? requetes[q] / 2 : -1;
+    }
+    free(valeurs);
+
+    printf("n = %zu, %d requêtes\n", n, NB_REQUETES);
+    printf("%-22s %15s %12s %12s\n", "", "démarrage", "ns/req (1)", "ns/req (2)");
+
+    // Texte : lecture, tri, puis les mêmes requêtes
+    double debut = maintenant();
+    LecteurEntiers lecteur;
+    size_t nLu;
+    if (lecteurOuvrir(&lecteur, cheminTexte) != 0) {
+        printf("Impossible d'ouvrir %s\n", cheminTexte);
+        return 1;
+    }
+    int *table = lireTousLesEntiers(&lecteur, &nLu);
+    lecteurFermer(&lecteur);
+    if (table == NULL || nLu != n) {
+        printf("ERREUR : lecture de %s\n", cheminTexte);
+        return 1;
+    }
+    triInsertion(table, (int)nLu);
+    resultats[0] = rechercheBinaire(table, nLu, requetes[0]);
+    double demarrage = maintenant() - debut;
+    debut = maintenant();
+    rechercheLot(table, nLu, requetes, NB_REQUETES, resultats);
+    double requete = maintenant() - debut;
+    printf("%-22s %12.3f ms %12.1f %12.1f\n", "texte + tri", demarrage * 1e3, requete * 1e9 / NB_REQUETES,
+           requete * 1e9 / NB_REQUETES);
+    erreurs += verifier("texte + tri");
+    free(table);
+
+    erreurs += mesurerBinaire("binaire (mmap)", cheminBinaire);
+    erreurs += mesurerBinaire("eytzinger (mmap)", cheminEytzinger);
+
+    remove(cheminTexte);
+    remove(cheminBinaire);
+    remove(cheminEytzinger);
+    return erreurs == 0 ? 0 : 1;
+}
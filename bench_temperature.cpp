@@ -0,0 +1,176 @@
+/*-----------------------------------
+       Benchmark de la conversion de température
+
+   Compare le calcul de Task2_ConvertTemperature
+   (float avec des constantes double), la version float simple,
+   le calcul Q16.16 de temperature.h et la table constexpr
+   de temperature_table.hpp, après avoir mesuré l'erreur
+   de chacun par rapport au calcul exact.
+
+   gcc -O2 -c temperature.c
+   g++ -O2 -std=c++17 bench_temperature.cpp temperature.o -o bench_temperature
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "bench_outils.h"
+#include "temperature.h"
+#include "temperature_table.hpp"
+
+// Sonde de -40 °F à 257 °F (-40 °C à 125 °C)
+using Sonde = TableCelsius<-40, 257>;
+
+// Points fixes vérifiés à la compilation
+static_assert(celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(212)) == 100 * TEMPERATURE_UN_Q16, "");
+static_assert(celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(32)) == 0, "");
+static_assert(Sonde::celsiusQ16(-40) == -40 * TEMPERATURE_UN_Q16, "");
+static_assert(Sonde::celsiusQ16(-100) == Sonde::celsiusQ16(-40), "");
+static_assert(Sonde::celsiusQ16(1000) == Sonde::celsiusQ16(257), "");
+
+// Calcul de Task2_ConvertTemperature, tel qu'il était
+__attribute__((noinline)) static float celsiusOrigine(float fahrenheit) {
+    return (fahrenheit - 32) * 5.0 / 9.0;
+}
+
+__attribute__((noinline)) static float celsiusFloat(float fahrenheit) {
+    return (fahrenheit - 32.0f) * 5.0f / 9.0f;
+}
+
+static long double exact(int32_t fahrenheitQ16) {
+    return ((long double)fahrenheitQ16 / TEMPERATURE_UN_Q16 - 32) * 5 / 9;
+}
+
+// Erreurs maximales en unités Q16.16 ; 0 si les bornes annoncées tiennent
+static int mesurerErreurs(void) {
+    long double erreurQ16 = 0, erreurFloat = 0, ecart = 0, ecartSonde = 0;
+
+    // D'abord l'intervalle des capteurs (-460 °F à 1000 °F), pas de 7 unités,
+    // puis des valeurs tirées sur tout le domaine de celsiusDepuisFahrenheitQ16
+    for (int64_t f = -460LL * TEMPERATURE_UN_Q16; f <= 1000LL * TEMPERATURE_UN_Q16 + 7LL * (1 << 24); f += 7) {
+        int32_t fq = (int32_t)f;
+        if (f > 1000LL * TEMPERATURE_UN_Q16) {
+            fq = (int32_t)((int64_t)(aleatoire() % 4292870144u) - 32736LL * TEMPERATURE_UN_Q16);
+        }
+        long double e = exact(fq);
+        long double q = (long double)celsiusDepuisFahrenheitQ16(fq) / TEMPERATURE_UN_Q16;
+        long double fl = celsiusFloat((float)fq / TEMPERATURE_UN_Q16);
+        erreurQ16 = fmaxl(erreurQ16, fabsl(q - e));
+        if (fabsl(e) <= 1000) {
+            erreurFloat = fmaxl(erreurFloat, fabsl(fl - e));
+            ecart = fmaxl(ecart, fabsl(q - fl));
+        }
+        if (e >= -40 && e <= 125) {
+            ecartSonde = fmaxl(ecartSonde, fabsl(q - fl));
+        }
+    }
+
+    printf("erreur max Q16.16 / exact       : %.3Lf unité (%.2Le °C)\n", erreurQ16 * TEMPERATURE_UN_Q16, erreurQ16);
+    printf("erreur max float / exact         : %.3Lf unité (%.2Le °C), |C| <= 1000\n", erreurFloat * TEMPERATURE_UN_Q16, erreurFloat);
+    printf("écart max Q16.16 / float         : %.3Lf unité (%.2Le °C), |C| <= 1000\n", ecart * TEMPERATURE_UN_Q16, ecart);
+    printf("écart max Q16.16 / float         : %.3Lf unité (%.2Le °C), -40 <= C <= 125\n", ecartSonde * TEMPERATURE_UN_Q16, ecartSonde);
+
+    int erreurs = 0;
+    if (erreurQ16 * TEMPERATURE_UN_Q16 > 5.0L / 9 + 1e-9L || ecartSonde > 2.5e-5L || ecart > 1.3e-4L) {
+        printf("ERREUR : borne d'erreur dépassée\n");
+        erreurs++;
+    }
+    // La table donne exactement le calcul Q16.16, bornes ramenées comprises
+    for (int f = -1000; f <= 1000; f++) {
+        int g = f < -40 ? -40 : f > 257 ? 257 : f;
+        if (Sonde::celsiusQ16(f) != celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(g))) {
+            printf("ERREUR : table différente du calcul en %d °F\n", f);
+            erreurs++;
+            break;
+        }
+    }
+    // Écriture à deux décimales
+    const struct { int32_t q16; const char *attendu; } textes[] = {
+        {celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(100)), "37.78"},
+        {-TEMPERATURE_UN_Q16 / 2, "-0.50"},
+        {-TEMPERATURE_UN_Q16 / 400, "0.00"},
+        {temperatureDepuisEntier(-40), "-40.00"},
+        {0, "0.00"},
+    };
+    char texte[16];
+    for (size_t i = 0; i < sizeof(textes) / sizeof(textes[0]); i++) {
+        temperatureVersTexte(textes[i].q16, texte, sizeof(texte));
+        if (strcmp(texte, textes[i].attendu) != 0) {
+            printf("ERREUR : %s au lieu de %s\n", texte, textes[i].attendu);
+            erreurs++;
+        }
+    }
+    return erreurs;
+}
+
+#define NB_ECHANTILLONS 4096
+
+// Sorties non statiques : sinon, jamais relues, leurs écritures seraient supprimées
+float celsiusFloatSortie[NB_ECHANTILLONS];
+int32_t celsiusQ16[NB_ECHANTILLONS];
+static float fahrenheitFloat[NB_ECHANTILLONS];
+static int32_t fahrenheitQ16[NB_ECHANTILLONS];
+static int16_t fahrenheitEntier[NB_ECHANTILLONS];
+
+static void boucleOrigine(void) {
+    for (int i = 0; i < NB_ECHANTILLONS; i++) celsiusFloatSortie[i] = celsiusOrigine(fahrenheitFloat[i]);
+}
+
+static void boucleFloat(void) {
+    for (int i = 0; i < NB_ECHANTILLONS; i++) celsiusFloatSortie[i] = celsiusFloat(fahrenheitFloat[i]);
+}
+
+static void boucleQ16(void) {
+    convertirFahrenheitQ16(fahrenheitQ16, celsiusQ16, NB_ECHANTILLONS);
+}
+
+static void boucleEntiers(void) {
+    convertirFahrenheitEntiers(fahrenheitEntier, celsiusQ16, NB_ECHANTILLONS);
+}
+
+static void boucleTable(void) {
+    Sonde::convertir(fahrenheitEntier, celsiusQ16, NB_ECHANTILLONS);
+}
+
+// Temps moyen par échantillon en nanosecondes
+static double mesurer(void (*fn)(void)) {
+    long repetitions = 1;
+    while (1) {
+        double debut = maintenant();
+        for (long r = 0; r < repetitions; r++) {
+            fn();
+            // Empêche le compilateur de fusionner les répétitions
+            __asm__ volatile("" ::: "memory");
+        }
+        double duree = maintenant() - debut;
+        if (duree >= 0.1) {
+            return duree * 1e9 / ((double)repetitions * NB_ECHANTILLONS);
+        }
+        repetitions *= 2;
+    }
+}
+
+int main(void) {
+    if (mesurerErreurs() != 0) {
+        return 1;
+    }
+
+    for (int i = 0; i < NB_ECHANTILLONS; i++) {
+        fahrenheitEntier[i] = (int16_t)(aleatoire() % 298) - 40;
+        fahrenheitQ16[i] = temperatureDepuisEntier(fahrenheitEntier[i]) + (int32_t)(aleatoire() & 0xFFFF);
+        fahrenheitFloat[i] = (float)fahrenheitQ16[i] / TEMPERATURE_UN_Q16;
+    }
+
+    const struct { const char *nom; void (*fn)(void); } versions[] = {
+        {"origine (double)", boucleOrigine},
+        {"float", boucleFloat},
+        {"Q16.16", boucleQ16},
+        {"entiers -> Q16.16", boucleEntiers},
+        {"table constexpr", boucleTable},
+    };
+    printf("%-20s %14s\n", "version", "ns / échant.");
+    for (size_t v = 0; v < sizeof(versions) / sizeof(versions[0]); v++) {
+        printf("%-20s %14.3f\n", versions[v].nom, mesurer(versions[v].fn));
+    }
+    return 0;
+}
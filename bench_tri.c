@@ -0,0 +1,111 @@
+/*-----------------------------------
+            Benchmark du tri
+
+   Compare triInsertionSimple (O(n^2), version
+   d'origine), triInsertion (hybride) et triRadix
+   (tri par base seul) pour n = 16 ... 10^6 sur
+   quatre distributions.
+
+   gcc -O2 bench_tri.c tri.c -o bench_tri
+   ./bench_tri [n max pour le tri quadratique]
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_outils.h"
+#include "tri.h"
+
+typedef void (*FonctionTri)(int tableau[], int taille);
+
+// Remplir le tableau selon la distribution demandée
+static void generer(int *t, int n, int distribution) {
+    for (int i = 0; i < n; i++) {
+        switch (distribution) {
+        case 0: t[i] = (int)aleatoire(); break;          // aléatoire
+        case 1: t[i] = i; break;                         // déjà trié
+        case 2: t[i] = n - i; break;                     // trié à l'envers
+        default: t[i] = (int)(aleatoire() % 8); break;   // peu de valeurs distinctes
+        }
+    }
+}
+
+// triRadix avec un tampon de travail alloué une fois
+static int *tamponRadix;
+static void trierRadix(int tableau[], int taille) {
+    triRadix(tableau, taille, tamponRadix);
+}
+
+static int estTrie(const int *t, int n) {
+    for (int i = 1; i < n; i++) {
+        if (t[i - 1] > t[i]) return 0;
+    }
+    return 1;
+}
+
+// Temps moyen d'un tri en nanosecondes (copie de la source incluse)
+// On double le nombre de répétitions jusqu'à mesurer au moins 50 ms
+static double mesurer(FonctionTri tri, const int *source, int *travail, int n) {
+    long repetitions = 1;
+    while (1) {
+        double debut = maintenant();
+        for (long r = 0; r < repetitions; r++) {
+            memcpy(travail, source, (size_t)n * sizeof(int));
+            tri(travail, n);
+        }
+        double duree = maintenant() - debut;
+        if (!estTrie(travail, n)) {
+            printf("ERREUR : tableau non trié (n = %d)\n", n);
+            exit(1);
+        }
+        if (duree >= 0.05 || repetitions >= (1L << 24)) {
+            return duree * 1e9 / repetitions;
+        }
+        repetitions *= 2;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *noms[4] = {"aleatoire", "trie", "inverse", "peu_distincts"};
+    const int tailles[] = {16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1000000};
+    const int nbTailles = sizeof(tailles) / sizeof(tailles[0]);
+
+    // Au-delà de cette taille le tri quadratique prend des minutes :
+    // il n'est mesuré que sur les entrées où il reste linéaire (trié)
+    int maxQuadratique = 65536;
+    if (argc > 1) {
+        maxQuadratique = atoi(argv[1]);
+    }
+
+    int *source = malloc(1000000 * sizeof(int));
+    int *travail = malloc(1000000 * sizeof(int));
+    tamponRadix = malloc(1000000 * sizeof(int));
+    if (source == NULL || travail == NULL || tamponRadix == NULL) {
+        printf("Allocation impossible\n");
+        return 1;
+    }
+
+    printf("%-14s %8s %16s %16s %16s %10s\n", "distribution", "n", "simple (ns)", "hybride (ns)", "radix (ns)",
+           "gain");
+    for (int d = 0; d < 4; d++) {
+        for (int k = 0; k < nbTailles; k++) {
+            int n = tailles[k];
+            generer(source, n, d);
+
+            double hybride = mesurer(triInsertion, source, travail, n);
+            double radix = mesurer(trierRadix, source, travail, n);
+            if (n <= maxQuadratique || d == 1) {
+                double simple = mesurer(triInsertionSimple, source, travail, n);
+                printf("%-14s %8d %16.0f %16.0f %16.0f %9.1fx\n", noms[d], n, simple, hybride, radix,
+                       simple / hybride);
+            } else {
+                printf("%-14s %8d %16s %16.0f %16.0f %10s\n", noms[d], n, "-", hybride, radix, "-");
+            }
+        }
+    }
+
+    free(source);
+    free(travail);
+    free(tamponRadix);
+    return 0;
+}
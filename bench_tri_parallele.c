@@ -0,0 +1,97 @@
+/*-----------------------------------
+       Benchmark du tri parallèle
+
+   Trie n entiers (10^7 par défaut, 10^8 pour les traitements
+   de nuit) avec triInsertion sur un seul fil, puis avec
+   triParallele sur 1, 2, 4... fils jusqu'au nombre de
+   processeurs, sur quatre distributions. Affiche le temps,
+   l'accélération par rapport à triInsertion et l'efficacité
+   (accélération / fils).
+
+   gcc -O2 -pthread bench_tri_parallele.c tri_parallele.c tri.c -o bench_tri_parallele
+   ./bench_tri_parallele [n] [fils max]
+-----------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_outils.h"
+#include "tri.h"
+#include "tri_parallele.h"
+
+static void generer(int *t, size_t n, int distribution) {
+    for (size_t i = 0; i < n; i++) {
+        switch (distribution) {
+        case 0: t[i] = (int)aleatoire(); break;          // aléatoire
+        case 1: t[i] = (int)i; break;                    // déjà trié
+        case 2: t[i] = (int)(n - i); break;              // trié à l'envers
+        default: t[i] = (int)(aleatoire() % 8); break;   // peu de valeurs distinctes
+        }
+    }
+}
+
+// 0 si t est trié et a la même somme (et le même ou exclusif) que la source
+static int verifier(const int *t, size_t n, long long somme, unsigned ou) {
+    long long s = 0;
+    unsigned x = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0 && t[i - 1] > t[i]) return 1;
+        s += t[i];
+        x ^= (unsigned)t[i];
+    }
+    return s != somme || x != ou;
+}
+
+int main(int argc, char *argv[]) {
+    const char *noms[4] = {"aleatoire", "trie", "inverse", "peu_distincts"};
+    size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 10000000;
+    int filsMax = argc > 2 ? atoi(argv[2]) : triNombreProcesseurs();
+    int erreurs = 0;
+
+    if (filsMax < 1) filsMax = 1;
+    if (filsMax > TRI_PARALLELE_FILS_MAX) filsMax = TRI_PARALLELE_FILS_MAX;
+    int *source = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *travail = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (source == NULL || travail == NULL || n == 0 || n > 0x7FFFFFFF) {
+        printf("n invalide ou mémoire insuffisante\n");
+        return 1;
+    }
+
+    printf("n = %zu, %d processeurs\n", n, triNombreProcesseurs());
+    printf("%-14s %8s %12s %10s %10s\n", "distribution", "fils", "temps (ms)", "accel.", "efficacite");
+    for (int d = 0; d < 4; d++) {
+        generer(source, n, d);
+        long long somme = 0;
+        unsigned ou = 0;
+        for (size_t i = 0; i < n; i++) {
+            somme += source[i];
+            ou ^= (unsigned)source[i];
+        }
+
+        memcpy(travail, source, n * sizeof(int));
+        double debut = maintenant();
+        triInsertion(travail, (int)n);
+        double reference = maintenant() - debut;
+        erreurs += verifier(travail, n, somme, ou);
+        printf("%-14s %8s %12.1f %10.2f %10s\n", noms[d], "hybride", reference * 1e3, 1.0, "");
+
+        // Toujours au moins 2 fils pour exercer la fusion, même sur un seul cœur
+        for (int fils = 1; fils <= filsMax || fils == 2; fils *= 2) {
+            memcpy(travail, source, n * sizeof(int));
+            debut = maintenant();
+            int statut = triParallele(travail, n, fils);
+            double duree = maintenant() - debut;
+            if (statut != 0 || verifier(travail, n, somme, ou) != 0) {
+                printf("ERREUR : %s, %d fils\n", noms[d], fils);
+                erreurs++;
+                continue;
+            }
+            printf("%-14s %8d %12.1f %10.2f %10.2f\n", noms[d], fils, duree * 1e3, reference / duree,
+                   reference / duree / fils);
+        }
+    }
+
+    free(travail);
+    free(source);
+    return erreurs == 0 ? 0 : 1;
+}
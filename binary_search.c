@@ -1,34 +1,115 @@
-#include <stdio.h>
-
-int main() {
-    int i, b, taille;
-    int tab[10] = {0,1,2,3,4,5,6,7,8,9};
-    taille = sizeof(tab) / sizeof(tab[0]); // Taille du tableau
-    
-    printf("Nombre recherché : ");
-    scanf("%d", &b);
-
-    int debut = 0;
-    int fin = taille - 1;
-    int milieu;
-
-    // Recherche binaire
-    while (debut <= fin) {
-        milieu = (debut + fin) / 2;
-
-        if (tab[milieu] == b) {
-            printf("Le nombre %d est dans la liste.\n", b);
-            printf("Il est à la position : %d\n", milieu);
-            return 0; // Quittez le programme si le nombre est trouvé
-        } else if (tab[milieu] < b) {
-            debut = milieu + 1;
-        } else {
-            fin = milieu - 1;
-        }
-    }
-
-    // Si le nombre n'a pas été trouvé, afficher un message approprié
-    printf("Le nombre %d n'est pas dans la liste.\n", b);
-
-    return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flux.h"
+#include "recherche_binaire.h"
+#include "table_triee.h"
+
+// Requêtes lues et traitées par blocs de cette taille
+#define REQUETES_PAR_BLOC 4096
+
+static EcrivainEntiers sortie;
+
+// La table où chercher : fichier binaire projeté (binaire non NULL) ou tableau
+typedef struct {
+    const TableTriee *binaire;
+    const int *tab;
+    size_t n;
+} Recherche;
+
+static int rechercherBloc(const int *cles, size_t nb, void *contexte) {
+    const Recherche *recherche = contexte;
+    long resultats[REQUETES_PAR_BLOC];
+
+    // Un bloc entier à la fois : les recherches se recouvrent en mémoire
+    if (recherche->binaire != NULL) {
+        tableRechercheLot(recherche->binaire, cles, nb, resultats);
+    } else {
+        rechercheLot(recherche->tab, recherche->n, cles, nb, resultats);
+    }
+    for (size_t k = 0; k < nb; k++) {
+        ecrireEntier(&sortie, resultats[k], '\n');
+    }
+    return 0;
+}
+
+// Mode non interactif : binary_search requetes [table]
+// (requetes ou table valent - pour l'entrée standard)
+// Écrit pour chaque nombre de requetes sa position dans la table, -1 s'il
+// n'y est pas, un résultat par ligne. La table doit être triée ; sans
+// fichier table, c'est tab. Un fichier écrit par creer_table est projeté
+// en mémoire tel quel ; sinon la table est lue comme du texte.
+static int rechercherFichier(const char *cheminRequetes, const char *cheminTable,
+                             const int *tabDefaut, size_t nDefaut) {
+    TableTriee binaire;
+    int estBinaire = 0;
+    const int *tab = tabDefaut;
+    int *table = NULL;
+    size_t n = nDefaut;
+    int cles[REQUETES_PAR_BLOC];
+
+    if (cheminTable != NULL && strcmp(cheminTable, "-") != 0) {
+        int statut = tableOuvrir(&binaire, cheminTable);
+        if (statut == -1) {
+            fprintf(stderr, "Impossible d'ouvrir %s\n", cheminTable);
+            return 1;
+        }
+        if (statut == -3) {
+            fprintf(stderr, "%s : table invalide\n", cheminTable);
+            return 1;
+        }
+        if (statut == 0 && !(binaire.drapeaux & TABLE_TRIEE)) {
+            fprintf(stderr, "%s : la table doit être triée\n", cheminTable);
+            tableFermer(&binaire);
+            return 1;
+        }
+        estBinaire = statut == 0;
+    }
+    if (cheminTable != NULL && !estBinaire) {
+        table = lireFichierEntiers(cheminTable, &n);
+        if (table == NULL) {
+            return 1;
+        }
+        for (size_t i = 1; i < n; i++) {
+            if (table[i - 1] > table[i]) {
+                fprintf(stderr, "%s : la table doit être triée (élément %zu)\n", cheminTable, i + 1);
+                free(table);
+                return 1;
+            }
+        }
+        tab = table;
+    }
+
+    Recherche recherche = {estBinaire ? &binaire : NULL, tab, n};
+    ecrivainInit(&sortie, stdout);
+    int statut = traiterFichierParBlocs(cheminRequetes, cles, REQUETES_PAR_BLOC, 1, rechercherBloc, &recherche);
+    if (estBinaire) tableFermer(&binaire);
+    free(table);
+    return ecrivainVider(&sortie) == 0 && statut == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int b, taille;
+    int tab[10] = {0,1,2,3,4,5,6,7,8,9};
+    taille = sizeof(tab) / sizeof(tab[0]); // Taille du tableau
+
+    if (argc > 1) {
+        return rechercherFichier(argv[1], argc > 2 ? argv[2] : NULL, tab, (size_t)taille);
+    }
+    
+    printf("Nombre recherché : ");
+    scanf("%d", &b);
+
+    // Recherche binaire
+    long milieu = rechercheBinaire(tab, taille, b);
+    if (milieu >= 0) {
+        printf("Le nombre %d est dans la liste.\n", b);
+        printf("Il est à la position : %ld\n", milieu);
+        return 0; // Quittez le programme si le nombre est trouvé
+    }
+
+    // Si le nombre n'a pas été trouvé, afficher un message approprié
+    printf("Le nombre %d n'est pas dans la liste.\n", b);
+
+    return 0;
+}
@@ -1,26 +1,54 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            comparateur
-            
------------------------------------*/
-#include <stdio.h>
-
-int main() {
-    int x, y;
-
-    printf("Entrez la valeur de x : ");
-    scanf("%d", &x);
-
-    printf("Entrez la valeur de y : ");
-    scanf("%d", &y);
-
-    if (x < y) {
-        printf("Le plus grand est : %d\n", y);
-    } else {
-        printf("Le plus grand est : %d\n", x);
-    }
-
-    return 0;
-}
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            comparateur
+            
+-----------------------------------*/
+#include <stdio.h>
+#include "flux.h"
+
+// Couples lus par blocs de cette taille
+#define COUPLES_PAR_BLOC 4096
+
+static EcrivainEntiers sortie;
+
+static int comparerBloc(const int *valeurs, size_t nb, void *contexte) {
+    (void)contexte;
+    for (size_t i = 0; i < nb; i += 2) {
+        ecrireEntier(&sortie, valeurs[i] < valeurs[i + 1] ? valeurs[i + 1] : valeurs[i], '\n');
+    }
+    return 0;
+}
+
+// Mode non interactif : compare fichier (ou - pour l'entrée standard)
+// Le fichier contient des couples x y ; écrit le plus grand de chacun, un par ligne.
+static int comparerFichier(const char *chemin) {
+    static int valeurs[2 * COUPLES_PAR_BLOC];
+
+    ecrivainInit(&sortie, stdout);
+    int statut = traiterFichierParBlocs(chemin, valeurs, 2 * COUPLES_PAR_BLOC, 2, comparerBloc, NULL);
+    return ecrivainVider(&sortie) == 0 && statut == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int x, y;
+
+    if (argc > 1) {
+        return comparerFichier(argv[1]);
+    }
+
+    printf("Entrez la valeur de x : ");
+    scanf("%d", &x);
+
+    printf("Entrez la valeur de y : ");
+    scanf("%d", &y);
+
+    if (x < y) {
+        printf("Le plus grand est : %d\n", y);
+    } else {
+        printf("Le plus grand est : %d\n", x);
+    }
+
+    return 0;
+}
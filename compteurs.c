@@ -0,0 +1,104 @@
+#include "compteurs.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define COMPTEURS_PERF 1
+#endif
+
+#ifdef COMPTEURS_PERF
+
+// glibc n'a pas d'enveloppe pour cet appel système
+static int ouvrirEvenement(uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int compteursOuvrir(Compteurs *compteurs) {
+    static const uint64_t configs[NB_COMPTEURS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    int ouverts = 0;
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        compteurs->fd[k] = ouvrirEvenement(configs[k]);
+        if (compteurs->fd[k] >= 0) {
+            ouverts++;
+        } else {
+            compteurs->fd[k] = -1;
+        }
+    }
+    return ouverts;
+}
+
+void compteursFermer(Compteurs *compteurs) {
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        if (compteurs->fd[k] >= 0) {
+            close(compteurs->fd[k]);
+            compteurs->fd[k] = -1;
+        }
+    }
+}
+
+void compteursDemarrer(Compteurs *compteurs) {
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        if (compteurs->fd[k] >= 0) {
+            ioctl(compteurs->fd[k], PERF_EVENT_IOC_RESET, 0);
+            ioctl(compteurs->fd[k], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void compteursArreter(Compteurs *compteurs, uint64_t cumul[NB_COMPTEURS]) {
+    // Tous arrêtés d'abord, pour ne pas compter les lectures des autres
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        if (compteurs->fd[k] >= 0) {
+            ioctl(compteurs->fd[k], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        uint64_t valeur;
+        if (compteurs->fd[k] >= 0 && read(compteurs->fd[k], &valeur, sizeof(valeur)) == (ssize_t)sizeof(valeur)) {
+            cumul[k] += valeur;
+        }
+    }
+}
+
+#else
+
+int compteursOuvrir(Compteurs *compteurs) {
+    for (int k = 0; k < NB_COMPTEURS; k++) {
+        compteurs->fd[k] = -1;
+    }
+    return 0;
+}
+
+void compteursFermer(Compteurs *compteurs) {
+    (void)compteurs;
+}
+
+void compteursDemarrer(Compteurs *compteurs) {
+    (void)compteurs;
+}
+
+void compteursArreter(Compteurs *compteurs, uint64_t cumul[NB_COMPTEURS]) {
+    (void)compteurs;
+    (void)cumul;
+}
+
+#endif
+
+int compteurDisponible(const Compteurs *compteurs, TypeCompteur type) {
+    return compteurs->fd[type] >= 0;
+}
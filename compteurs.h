@@ -0,0 +1,45 @@
+// Compteurs matériels du processeur pour les benchmarks
+// Sous Linux, perf_event_open compte les cycles, les défauts de cache et les
+// erreurs de prédiction de branchement du seul code placé entre
+// compteursDemarrer et compteursArreter (espace utilisateur uniquement,
+// ce qui suffit avec perf_event_paranoid <= 2).
+// Un compteur que le système refuse (machine virtuelle, conteneur, autre OS)
+// reste indisponible : sa valeur n'est pas comptée et vaut 0.
+
+#ifndef COMPTEURS_H
+#define COMPTEURS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    COMPTEUR_CYCLES,
+    COMPTEUR_DEFAUTS_CACHE,
+    COMPTEUR_BRANCHES_MANQUEES,
+    NB_COMPTEURS
+} TypeCompteur;
+
+typedef struct {
+    int fd[NB_COMPTEURS];       // -1 si le compteur est indisponible
+} Compteurs;
+
+// Ouvre les compteurs disponibles, retourne leur nombre
+int compteursOuvrir(Compteurs *compteurs);
+void compteursFermer(Compteurs *compteurs);
+
+int compteurDisponible(const Compteurs *compteurs, TypeCompteur type);
+
+// Remet à zéro et lance les compteurs
+void compteursDemarrer(Compteurs *compteurs);
+
+// Arrête les compteurs et ajoute leurs valeurs à cumul
+void compteursArreter(Compteurs *compteurs, uint64_t cumul[NB_COMPTEURS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
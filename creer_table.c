@@ -0,0 +1,114 @@
+/*-----------------------------------
+       Création d'une table triée
+
+   Lit des entiers en texte (flux.h), les trie et écrit la table
+   au format de table_triee.h, à ouvrir ensuite avec tableOuvrir
+   (par exemple : binary_search requetes.txt table.bin).
+
+   creer_table [--eytzinger] [--c nom] entree sortie
+     entree        entiers en texte, - pour l'entrée standard
+     --eytzinger   ajoute la disposition d'Eytzinger (grandes tables)
+     --c nom       écrit l'image en tableau C constant nommé nom, à
+                   compiler avec le programme (tableDepuisMemoire)
+
+   gcc -O2 creer_table.c table_triee.c recherche_binaire.c flux.c tri.c -o creer_table
+-----------------------------------*/
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flux.h"
+#include "table_triee.h"
+#include "tri.h"
+
+// Image en mots de 64 bits, alignée sur 64 octets comme un fichier projeté.
+// Commentaire en ASCII : le fichier se compile quel que soit l'encodage du projet.
+static int ecrireTableauC(const char *chemin, const char *nom, const char *source,
+                          const void *image, size_t taille, size_t n) {
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    size_t nbMots = taille / sizeof(uint64_t);
+    fprintf(f, "/* Produit par creer_table a partir de %s : ne pas modifier.\n",
+            strcmp(source, "-") == 0 ? "l'entree standard" : source);
+    fprintf(f, " * Table triee de %zu valeurs au format de table_triee.h (cible petit-boutiste),\n", n);
+    fprintf(f, " * a ouvrir avec tableDepuisMemoire( &table, %s, sizeof( %s ) ). */\n\n", nom, nom);
+    fprintf(f, "#include <stdint.h>\n\n");
+    fprintf(f, "static const uint64_t %s[ %zu ] __attribute__( ( aligned( %d ) ) ) =\n{\n", nom, nbMots,
+            TABLE_ALIGNEMENT);
+    for (size_t i = 0; i < nbMots; i++) {
+        uint64_t mot;
+        memcpy(&mot, (const unsigned char *)image + i * sizeof(mot), sizeof(mot));
+        fprintf(f, "%s0x%016" PRIx64 "%s", i % 4 == 0 ? "    " : " ", mot,
+                i + 1 < nbMots ? (i % 4 == 3 ? ",\n" : ",") : "\n");
+    }
+    fprintf(f, "};\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t options = 0;
+    const char *nomC = NULL;
+    int i = 1;
+
+    for (; i < argc && strncmp(argv[i], "--", 2) == 0; i++) {
+        if (strcmp(argv[i], "--eytzinger") == 0) {
+            options |= TABLE_EYTZINGER;
+        } else if (strcmp(argv[i], "--c") == 0 && i + 1 < argc) {
+            nomC = argv[++i];
+        } else {
+            break;
+        }
+    }
+    if (argc - i != 2) {
+        fprintf(stderr, "usage : %s [--eytzinger] [--c nom] entree sortie\n", argv[0]);
+        return 2;
+    }
+    const char *entree = argv[i], *sortie = argv[i + 1];
+
+    LecteurEntiers lecteur;
+    size_t n;
+    if (lecteurOuvrir(&lecteur, entree) != 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", entree);
+        return 1;
+    }
+    int *valeurs = lireTousLesEntiers(&lecteur, &n);
+    if (valeurs == NULL) {
+        fprintf(stderr, "%s, ligne %ld : %s\n", entree, lecteur.ligne, lecteurMessage(&lecteur));
+        lecteurFermer(&lecteur);
+        return 1;
+    }
+    lecteurFermer(&lecteur);
+    if (n > INT_MAX) {
+        fprintf(stderr, "%s : trop d'éléments\n", entree);
+        free(valeurs);
+        return 1;
+    }
+
+    triInsertion(valeurs, (int)n);
+
+    size_t taille = tableTailleImage(n, options);
+    void *image = taille != 0 ? malloc(taille) : NULL;
+    int statut = image != NULL ? tableConstruireImage(image, taille, valeurs, n, options) : -1;
+    if (statut == 0) {
+        if (nomC != NULL) {
+            statut = ecrireTableauC(sortie, nomC, entree, image, taille, n);
+        } else {
+            FILE *f = fopen(sortie, "wb");
+            statut = f != NULL && fwrite(image, 1, taille, f) == taille ? 0 : -1;
+            if (f != NULL && fclose(f) != 0) {
+                statut = -1;
+            }
+        }
+        if (statut != 0) {
+            fprintf(stderr, "Impossible d'écrire %s\n", sortie);
+        }
+    } else {
+        fprintf(stderr, "Mémoire insuffisante pour %zu éléments\n", n);
+    }
+    free(image);
+    free(valeurs);
+    return statut == 0 ? 0 : 1;
+}
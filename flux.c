@@ -0,0 +1,412 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flux.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FLUX_MMAP 1
+#endif
+
+static int estSeparateur(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',' || c == ';' || c == '\v' || c == '\f';
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define FLUX_SWAR 1
+
+// Huit caractères d'un coup (le premier dans l'octet de poids faible)
+static uint64_t charger8(const char *p) {
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+// Nombre de chiffres en tête des huit caractères : un octet est un chiffre si
+// son quartet haut vaut 3 et le reste après l'ajout de 6 ('0'..'9' -> 0x36..0x3F)
+static unsigned chiffresEnTete(uint64_t x) {
+    uint64_t t = (x & 0xF0F0F0F0F0F0F0F0u) | (((x + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4);
+    uint64_t differents = t ^ 0x3333333333333333u;
+    return differents == 0 ? 8 : (unsigned)__builtin_ctzll(differents) / 8;
+}
+
+// Valeur de nb chiffres (1 à 8) en tête de x, en trois multiplications
+static uint32_t valeurChiffres(uint64_t x, unsigned nb) {
+    x = (x & 0x0F0F0F0F0F0F0F0Fu) << (8 * (8 - nb));         // zéros de tête
+    x = (x * 2561) >> 8;
+    x = ((x & 0x00FF00FF00FF00FFu) * 6553601) >> 16;
+    return (uint32_t)(((x & 0x0000FFFF0000FFFFu) * 42949672960001u) >> 32);
+}
+#endif
+
+static void initialiser(LecteurEntiers *lecteur) {
+    memset(lecteur, 0, sizeof(*lecteur));
+    lecteur->ligne = 1;
+}
+
+int lecteurOuvrir(LecteurEntiers *lecteur, const char *chemin) {
+    initialiser(lecteur);
+    FILE *fichier = (chemin == NULL || strcmp(chemin, "-") == 0) ? stdin : fopen(chemin, "rb");
+    if (fichier == NULL) {
+        return -1;
+    }
+
+#ifdef FLUX_MMAP
+    // Fichier ordinaire (y compris "< fichier" sur l'entrée standard) : projeté en entier
+    struct stat etat;
+    if (fstat(fileno(fichier), &etat) == 0 && S_ISREG(etat.st_mode) && etat.st_size > 0 &&
+        (uintmax_t)etat.st_size <= SIZE_MAX) {
+        size_t taille = (size_t)etat.st_size;
+        void *projection = mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fileno(fichier), 0);
+        if (projection != MAP_FAILED) {
+            posix_madvise(projection, taille, POSIX_MADV_SEQUENTIAL);
+            if (fichier != stdin) {
+                fclose(fichier);
+            }
+            lecteur->projection = projection;
+            lecteur->tailleProjection = taille;
+            lecteur->pos = projection;
+            lecteur->fin = lecteur->pos + taille;
+            lecteur->finFichier = 1;
+            return 0;
+        }
+    }
+#endif
+
+    lecteur->tampon = malloc(FLUX_TAILLE_TAMPON);
+    if (lecteur->tampon == NULL) {
+        if (fichier != stdin) {
+            fclose(fichier);
+        }
+        return -1;
+    }
+    lecteur->fichier = fichier;
+    lecteur->pos = lecteur->tampon;
+    lecteur->fin = lecteur->tampon;
+    return 0;
+}
+
+void lecteurDepuisMemoire(LecteurEntiers *lecteur, const char *donnees, size_t taille) {
+    initialiser(lecteur);
+    lecteur->pos = donnees;
+    lecteur->fin = donnees + taille;
+    lecteur->finFichier = 1;
+}
+
+void lecteurFermer(LecteurEntiers *lecteur) {
+#ifdef FLUX_MMAP
+    if (lecteur->projection != NULL) {
+        munmap(lecteur->projection, lecteur->tailleProjection);
+    }
+#endif
+    if (lecteur->fichier != NULL && lecteur->fichier != stdin) {
+        fclose(lecteur->fichier);
+    }
+    free(lecteur->tampon);
+    lecteur->projection = NULL;
+    lecteur->fichier = NULL;
+    lecteur->tampon = NULL;
+    lecteur->pos = lecteur->fin = NULL;
+}
+
+const char *lecteurMessage(const LecteurEntiers *lecteur) {
+    switch (lecteur->erreur) {
+    case 0:                   return "pas d'erreur";
+    case FLUX_ERREUR_TEXTE:   return "entier invalide";
+    case FLUX_ERREUR_MEMOIRE: return "mémoire insuffisante";
+    default:                  return "erreur de lecture";
+    }
+}
+
+// Garde le texte non analysé en tête du tampon et complète avec la suite du fichier
+static void remplir(LecteurEntiers *lecteur) {
+    size_t reste = (size_t)(lecteur->fin - lecteur->pos);
+    memmove(lecteur->tampon, lecteur->pos, reste);
+    size_t lus = fread(lecteur->tampon + reste, 1, FLUX_TAILLE_TAMPON - reste, lecteur->fichier);
+    if (lus < FLUX_TAILLE_TAMPON - reste) {
+        lecteur->finFichier = 1;
+        if (ferror(lecteur->fichier)) {
+            lecteur->erreur = FLUX_ERREUR_LECTURE;
+        }
+    }
+    lecteur->pos = lecteur->tampon;
+    lecteur->fin = lecteur->tampon + reste + lus;
+}
+
+// Analyse l'entier qui commence en s. Retourne 1 (valeur écrite, *suite après
+// l'entier), -1 si le texte est invalide, 0 si l'entier touche la fin des données
+// alors que le fichier n'est pas fini : il faut relire.
+static int analyser(const char *s, const char *fin, int finFichier, const char **suite, int *valeur) {
+    // Signe sans branchement : il change d'un nombre à l'autre, mal prédit
+    int negatif = *s == '-';
+    s += negatif | (*s == '+');
+    const char *chiffres = s;
+    uint64_t v = 0;
+#ifdef FLUX_SWAR
+    // Jusqu'à huit chiffres sans boucle ni branchement par chiffre
+    if (fin - s >= 8) {
+        uint64_t x = charger8(s);
+        unsigned nb = chiffresEnTete(x);
+        if (nb > 0) {
+            v = valeurChiffres(x, nb);
+            s += nb;
+        }
+    }
+#endif
+    while (s < fin && (unsigned)(*s - '0') < 10) {
+        // Au-delà de 2^31 le nombre est déjà invalide : inutile de continuer le calcul
+        if (v <= 2147483648u) {
+            v = v * 10 + (unsigned)(*s - '0');
+        }
+        s++;
+    }
+    if (s == fin && !finFichier) {
+        return 0;
+    }
+    if (s == chiffres || (s < fin && !estSeparateur(*s)) || v > (negatif ? 2147483648u : 2147483647u)) {
+        return -1;
+    }
+    *valeur = negatif ? (int)(0u - (uint32_t)v) : (int)v;
+    *suite = s;
+    return 1;
+}
+
+// Saute les séparateurs puis analyse un entier. Travaille sur des copies locales
+// de la position et du numéro de ligne, que le compilateur garde dans des
+// registres : c'est la boucle de lireEntiers. Retourne comme analyser, et 0
+// aussi quand il ne reste que des séparateurs (*pos vaut alors fin).
+static inline int lireDansTampon(const char **pos, const char *fin, int finFichier, long *ligne, int *valeur) {
+    const char *p = *pos;
+    while (p < fin && estSeparateur(*p)) {
+        *ligne += *p == '\n';
+        p++;
+    }
+    *pos = p;
+    if (p == fin) {
+        return 0;
+    }
+    return analyser(p, fin, finFichier, pos, valeur);
+}
+
+int lireEntier(LecteurEntiers *lecteur, int *valeur) {
+    if (lecteur->erreur != 0) {
+        return -1;
+    }
+    for (;;) {
+        const char *p = lecteur->pos;
+        long ligne = lecteur->ligne;
+        int statut = lireDansTampon(&p, lecteur->fin, lecteur->finFichier, &ligne, valeur);
+        lecteur->pos = p;
+        lecteur->ligne = ligne;
+        if (statut == 1) {
+            return 1;
+        }
+        if (statut == 0 && lecteur->finFichier) {
+            return lecteur->erreur != 0 ? -1 : 0;
+        }
+        // Plus rien dans le tampon, ou entier coupé par sa fin : on relit,
+        // sauf si l'entier remplit déjà tout le tampon
+        if (statut == 0 && !(p == lecteur->tampon && lecteur->fin == lecteur->tampon + FLUX_TAILLE_TAMPON)) {
+            remplir(lecteur);
+            continue;
+        }
+        lecteur->erreur = FLUX_ERREUR_TEXTE;
+        return -1;
+    }
+}
+
+long lireEntiers(LecteurEntiers *lecteur, int *valeurs, size_t max) {
+    size_t n = 0;
+    if (lecteur->erreur != 0) {
+        return -1;
+    }
+    while (n < max) {
+        const char *p = lecteur->pos;
+        const char *fin = lecteur->fin;
+        const int finFichier = lecteur->finFichier;
+        long ligne = lecteur->ligne;
+
+        // Tant que les entiers sont en entier dans le tampon, sans repasser par lecteur
+        while (n < max && lireDansTampon(&p, fin, finFichier, &ligne, &valeurs[n]) == 1) {
+            n++;
+        }
+        lecteur->pos = p;
+        lecteur->ligne = ligne;
+        if (n == max) {
+            break;
+        }
+
+        // Fin du tampon, fin des données ou texte invalide : le cas général
+        int statut = lireEntier(lecteur, &valeurs[n]);
+        if (statut < 0) {
+            return -1;
+        }
+        if (statut == 0) {
+            break;
+        }
+        n++;
+    }
+    return (long)n;
+}
+
+int *lireTousLesEntiers(LecteurEntiers *lecteur, size_t *n) {
+    // Un fichier projeté ne peut pas contenir plus d'un entier tous les deux octets
+    // (chiffre et séparateur) : une seule allocation suffit
+    size_t capacite = lecteur->finFichier ? (size_t)(lecteur->fin - lecteur->pos) / 2 + 1 : 4096;
+    int *valeurs = malloc(capacite * sizeof(int));
+    size_t nb = 0;
+    int statut;
+
+    if (valeurs == NULL) {
+        lecteur->erreur = FLUX_ERREUR_MEMOIRE;
+        return NULL;
+    }
+    while ((statut = lireEntier(lecteur, &valeurs[nb])) == 1) {
+        if (++nb == capacite) {
+            int *plus = capacite <= SIZE_MAX / (2 * sizeof(int)) ? realloc(valeurs, 2 * capacite * sizeof(int)) : NULL;
+            if (plus == NULL) {
+                free(valeurs);
+                lecteur->erreur = FLUX_ERREUR_MEMOIRE;
+                return NULL;
+            }
+            valeurs = plus;
+            capacite *= 2;
+        }
+    }
+    if (statut < 0) {
+        free(valeurs);
+        return NULL;
+    }
+    *n = nb;
+    return valeurs;
+}
+
+static const char *nomFichier(const char *chemin) {
+    return chemin == NULL ? "-" : chemin;
+}
+
+int traiterFichierParBlocs(const char *chemin, int *valeurs, size_t max, size_t groupe,
+                           TraiterBloc traiter, void *contexte) {
+    LecteurEntiers lecteur;
+    long nb = 0;
+    int statut = 0;
+
+    if (lecteurOuvrir(&lecteur, chemin) != 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier(chemin));
+        return -1;
+    }
+    // Seul le dernier bloc a moins de max valeurs, lui seul peut couper un
+    // groupe : ses groupes complets sont traités avant le message d'erreur
+    while (statut == 0 && (nb = lireEntiers(&lecteur, valeurs, max)) > 0) {
+        size_t reste = (size_t)nb % groupe;
+        if (reste != 0) {
+            if ((size_t)nb > reste) {
+                traiter(valeurs, (size_t)nb - reste, contexte);
+            }
+            if (groupe == 2) {
+                fprintf(stderr, "%s : nombre impair de valeurs\n", nomFichier(chemin));
+            } else {
+                fprintf(stderr, "%s : nombre de valeurs qui n'est pas un multiple de %zu\n",
+                        nomFichier(chemin), groupe);
+            }
+            statut = -1;
+            break;
+        }
+        statut = traiter(valeurs, (size_t)nb, contexte);
+    }
+    if (nb < 0) {
+        fprintf(stderr, "%s, ligne %ld : %s\n", nomFichier(chemin), lecteur.ligne, lecteurMessage(&lecteur));
+        statut = -1;
+    }
+    lecteurFermer(&lecteur);
+    return statut;
+}
+
+int *lireFichierEntiers(const char *chemin, size_t *n) {
+    LecteurEntiers lecteur;
+
+    if (lecteurOuvrir(&lecteur, chemin) != 0) {
+        fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier(chemin));
+        return NULL;
+    }
+    int *valeurs = lireTousLesEntiers(&lecteur, n);
+    if (valeurs == NULL) {
+        fprintf(stderr, "%s, ligne %ld : %s\n", nomFichier(chemin), lecteur.ligne, lecteurMessage(&lecteur));
+    }
+    lecteurFermer(&lecteur);
+    return valeurs;
+}
+
+void ecrivainInit(EcrivainEntiers *ecrivain, FILE *fichier) {
+    ecrivain->fichier = fichier;
+    ecrivain->utilise = 0;
+    ecrivain->erreur = 0;
+}
+
+int ecrivainVider(EcrivainEntiers *ecrivain) {
+    if (ecrivain->utilise > 0 &&
+        fwrite(ecrivain->tampon, 1, ecrivain->utilise, ecrivain->fichier) != ecrivain->utilise) {
+        ecrivain->erreur = 1;
+    }
+    ecrivain->utilise = 0;
+    if (fflush(ecrivain->fichier) != 0) {
+        ecrivain->erreur = 1;
+    }
+    return ecrivain->erreur ? -1 : 0;
+}
+
+// Place pour un entier de 64 bits, son signe et le séparateur
+#define FLUX_PLACE_ENTIER 22
+
+// "00" à "99" : deux chiffres par division
+static const char paires[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+void ecrireEntier(EcrivainEntiers *ecrivain, long long valeur, char separateur) {
+    if (ecrivain->utilise + FLUX_PLACE_ENTIER > sizeof(ecrivain->tampon)) {
+        ecrivainVider(ecrivain);
+    }
+    char chiffres[20];
+    int k = 20;
+    char *sortie = ecrivain->tampon + ecrivain->utilise;
+    unsigned long long u = valeur < 0 ? 0ull - (unsigned long long)valeur : (unsigned long long)valeur;
+    while (u >= 100) {
+        unsigned p = (unsigned)(u % 100) * 2;
+        u /= 100;
+        chiffres[--k] = paires[p + 1];
+        chiffres[--k] = paires[p];
+    }
+    if (u >= 10) {
+        chiffres[--k] = paires[u * 2 + 1];
+        chiffres[--k] = paires[u * 2];
+    } else {
+        chiffres[--k] = (char)('0' + u);
+    }
+    if (valeur < 0) {
+        *sortie++ = '-';
+    }
+    memcpy(sortie, chiffres + k, (size_t)(20 - k));
+    sortie += 20 - k;
+    *sortie++ = separateur;
+    ecrivain->utilise = (size_t)(sortie - ecrivain->tampon);
+}
+
+void ecrireTexte(EcrivainEntiers *ecrivain, const char *texte) {
+    for (; *texte != '\0'; texte++) {
+        if (ecrivain->utilise == sizeof(ecrivain->tampon)) {
+            ecrivainVider(ecrivain);
+        }
+        ecrivain->tampon[ecrivain->utilise++] = *texte;
+    }
+}
+
+void ecrireEntiers(EcrivainEntiers *ecrivain, const int *valeurs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        ecrireEntier(ecrivain, valeurs[i], '\n');
+    }
+}
@@ -0,0 +1,106 @@
+// Lecture et écriture d'entiers en bloc, pour le mode non interactif des exercices
+// Un fichier ordinaire est projeté en mémoire (mmap) et lu d'un seul tenant ;
+// l'entrée standard ou un tube passe par un tampon de FLUX_TAILLE_TAMPON octets.
+// Les entiers sont analysés à la main (pas de scanf) : quelques instructions
+// par chiffre, si bien que la lecture va à la vitesse du disque.
+// Séparateurs acceptés : blancs, virgules et points-virgules.
+
+#ifndef FLUX_H
+#define FLUX_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLUX_TAILLE_TAMPON (1u << 20)
+
+// Valeurs de LecteurEntiers.erreur
+#define FLUX_ERREUR_TEXTE   1     // texte qui n'est pas un entier de 32 bits
+#define FLUX_ERREUR_MEMOIRE 2
+#define FLUX_ERREUR_LECTURE 3
+
+typedef struct {
+    const char *pos;         // prochain caractère à analyser
+    const char *fin;         // fin des données disponibles
+    FILE *fichier;           // lecture par tampon (NULL si projeté ou en mémoire)
+    char *tampon;
+    void *projection;        // zone mmap, rendue par lecteurFermer
+    size_t tailleProjection;
+    int finFichier;          // plus rien à lire après fin
+    long ligne;              // ligne de pos, pour les messages d'erreur
+    int erreur;              // 0 ou FLUX_ERREUR_*
+} LecteurEntiers;
+
+// Ouvre chemin, ou l'entrée standard si chemin vaut NULL ou "-".
+// Retourne 0, ou -1 si le fichier ne s'ouvre pas ou si la mémoire manque.
+int lecteurOuvrir(LecteurEntiers *lecteur, const char *chemin);
+
+// Lecture des taille octets de données (pas de copie, pas de fermeture à faire)
+void lecteurDepuisMemoire(LecteurEntiers *lecteur, const char *donnees, size_t taille);
+
+void lecteurFermer(LecteurEntiers *lecteur);
+
+// Texte de lecteur->erreur, pour les messages ("entier invalide"...)
+const char *lecteurMessage(const LecteurEntiers *lecteur);
+
+// Retourne 1 et écrit l'entier suivant dans valeur, 0 à la fin des données,
+// -1 en cas d'erreur (lecteur->erreur dit laquelle, lecteur->ligne où)
+int lireEntier(LecteurEntiers *lecteur, int *valeur);
+
+// Lit au plus max entiers dans valeurs ; retourne leur nombre (moins de max
+// à la fin des données), ou -1 en cas d'erreur. Pour traiter l'entrée par blocs.
+long lireEntiers(LecteurEntiers *lecteur, int *valeurs, size_t max);
+
+// Lit tous les entiers restants dans un tableau alloué avec malloc (à libérer
+// avec free) et écrit leur nombre dans n. Retourne NULL en cas d'erreur ;
+// un tableau vide n'est pas NULL.
+int *lireTousLesEntiers(LecteurEntiers *lecteur, size_t *n);
+
+// Mode non interactif des exercices : ouverture, lecture, message d'erreur et
+// fermeture en un appel. Les erreurs (fichier introuvable, entier invalide,
+// groupe incomplet) sont écrites sur stderr avec le nom du fichier et la ligne.
+
+// Traitement d'un bloc ; retourne 0 pour continuer, -1 pour arrêter la lecture
+typedef int (*TraiterBloc)(const int *valeurs, size_t nb, void *contexte);
+
+// Lit chemin (NULL ou "-" : l'entrée standard) par blocs d'au plus max entiers
+// dans valeurs et appelle traiter sur chacun. Les valeurs vont par groupes de
+// groupe entiers (2 pour des couples) : max doit en être un multiple, et un
+// groupe incomplet en fin de fichier est une erreur, signalée après le
+// traitement des groupes complets qui le précèdent (un entier invalide, lui,
+// arrête la lecture avant son bloc). Retourne 0, ou -1 en cas d'erreur ou si
+// traiter a arrêté la lecture.
+int traiterFichierParBlocs(const char *chemin, int *valeurs, size_t max, size_t groupe,
+                           TraiterBloc traiter, void *contexte);
+
+// lireTousLesEntiers sur le fichier chemin, avec le même traitement des erreurs
+int *lireFichierEntiers(const char *chemin, size_t *n);
+
+typedef struct {
+    FILE *fichier;
+    size_t utilise;
+    int erreur;              // une écriture a échoué
+    char tampon[1u << 16];
+} EcrivainEntiers;
+
+void ecrivainInit(EcrivainEntiers *ecrivain, FILE *fichier);
+
+// valeur en décimal suivie de separateur (' ' ou '\n' en général)
+void ecrireEntier(EcrivainEntiers *ecrivain, long long valeur, char separateur);
+
+void ecrireTexte(EcrivainEntiers *ecrivain, const char *texte);
+
+// Tableau complet, une valeur par ligne
+void ecrireEntiers(EcrivainEntiers *ecrivain, const int *valeurs, size_t n);
+
+// Vide le tampon dans le fichier ; retourne 0, ou -1 si une écriture a échoué
+int ecrivainVider(EcrivainEntiers *ecrivain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,22 +1,489 @@
-#include "fonctions.h"
-
-// Implémentation de la fonction somme
-int somme(int a, int b) {
-    return a + b;
-}
-
-// Implémentation de la fonction comparaison
-int comparaison(int a, int b) {
-    if (a > b) {
-        return 1;
-    } else if (a < b) {
-        return -1;
-    } else {
-        return 0;
-    }
-}
-
-// Implémentation de la fonction multiplication
-int multiplication(int a, int b) {
-    return a * b;
-}
+#include <limits.h>
+#include "fonctions.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CALCUL_X86 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define CALCUL_NEON 1
+#if defined(__linux__) && !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+// somme, comparaison et multiplication sont maintenant en ligne dans fonctions.h ;
+// ce fichier contient leurs versions sur des tableaux.
+
+typedef void (*NoyauCalcul)(const int *a, const int *b, int *out, size_t n);
+typedef long (*NoyauVerifie)(const int *a, const int *b, int *out, size_t n);
+
+// Un jeu de noyaux par jeu d'instructions
+typedef struct {
+    const char *nom;
+    NoyauCalcul somme;
+    NoyauCalcul sommeSaturee;
+    NoyauVerifie sommeVerifiee;
+    NoyauCalcul comparaison;
+    NoyauCalcul multiplication;
+    NoyauCalcul multiplicationSaturee;
+    NoyauVerifie multiplicationVerifiee;
+} NoyauxCalcul;
+
+// Versions scalaires : servent de repli et finissent les restes des noyaux vectoriels.
+// Les calculs modulo 2^32 passent par unsigned pour éviter le dépassement signé.
+static void sommeScalaire(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (int)((unsigned)a[i] + (unsigned)b[i]);
+    }
+}
+
+static void sommeSatureeScalaire(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int s;
+        if (__builtin_add_overflow(a[i], b[i], &s)) {
+            s = a[i] < 0 ? INT_MIN : INT_MAX;
+        }
+        out[i] = s;
+    }
+}
+
+static long sommeVerifieeScalaire(const int *a, const int *b, int *out, size_t n) {
+    long premier = -1;
+    for (size_t i = 0; i < n; i++) {
+        int s;
+        if (__builtin_add_overflow(a[i], b[i], &s) && premier < 0) {
+            premier = (long)i;
+        }
+        out[i] = s;
+    }
+    return premier;
+}
+
+static void comparaisonScalaire(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = comparaison(a[i], b[i]);
+    }
+}
+
+static void multiplicationScalaire(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (int)((unsigned)a[i] * (unsigned)b[i]);
+    }
+}
+
+static void multiplicationSatureeScalaire(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        long long p = (long long)a[i] * b[i];
+        out[i] = p > INT_MAX ? INT_MAX : p < INT_MIN ? INT_MIN : (int)p;
+    }
+}
+
+static long multiplicationVerifieeScalaire(const int *a, const int *b, int *out, size_t n) {
+    long premier = -1;
+    for (size_t i = 0; i < n; i++) {
+        int p;
+        if (__builtin_mul_overflow(a[i], b[i], &p) && premier < 0) {
+            premier = (long)i;
+        }
+        out[i] = p;
+    }
+    return premier;
+}
+
+// Les noyaux vérifiés s'arrêtent de vérifier au premier dépassement :
+// la suite du tableau est confiée au noyau modulo 2^32, qui a le même résultat.
+static long finirApresDepassement(NoyauCalcul suite, const int *a, const int *b, int *out,
+                                  size_t n, size_t fin, size_t premier) {
+    suite(a + fin, b + fin, out + fin, n - fin);
+    return (long)premier;
+}
+
+static const NoyauxCalcul noyauxScalaires = {
+    "scalaire",
+    sommeScalaire, sommeSatureeScalaire, sommeVerifieeScalaire,
+    comparaisonScalaire,
+    multiplicationScalaire, multiplicationSatureeScalaire, multiplicationVerifieeScalaire
+};
+
+#ifdef CALCUL_X86
+
+// SSE2 : 4 entiers par instruction.
+// Dépassement d'une somme s = a + b : a et b de même signe, s de l'autre signe,
+// c'est-à-dire le bit de signe de (a ^ s) & (b ^ s).
+// La borne à utiliser vient du signe de a : (a >> 31) ^ INT_MAX vaut INT_MAX ou INT_MIN.
+__attribute__((target("sse2")))
+static void sommeSSE2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        _mm_storeu_si128((__m128i *)(out + i), _mm_add_epi32(va, vb));
+    }
+    sommeScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void sommeSatureeSSE2(const int *a, const int *b, int *out, size_t n) {
+    const __m128i max = _mm_set1_epi32(INT_MAX);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i s = _mm_add_epi32(va, vb);
+        __m128i deb = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(va, s), _mm_xor_si128(vb, s)), 31);
+        __m128i borne = _mm_xor_si128(_mm_srai_epi32(va, 31), max);
+        s = _mm_or_si128(_mm_and_si128(deb, borne), _mm_andnot_si128(deb, s));
+        _mm_storeu_si128((__m128i *)(out + i), s);
+    }
+    sommeSatureeScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static long sommeVerifieeSSE2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i s = _mm_add_epi32(va, vb);
+        _mm_storeu_si128((__m128i *)(out + i), s);
+        __m128i deb = _mm_and_si128(_mm_xor_si128(va, s), _mm_xor_si128(vb, s));
+        unsigned masque = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(deb));
+        if (masque != 0) {
+            return finirApresDepassement(sommeSSE2, a, b, out, n, i + 4, i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    long reste = sommeVerifieeScalaire(a + i, b + i, out + i, n - i);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+// a > b donne -1 dans gt, a < b donne -1 dans lt : lt - gt vaut 1, 0 ou -1
+__attribute__((target("sse2")))
+static void comparaisonSSE2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i r = _mm_sub_epi32(_mm_cmplt_epi32(va, vb), _mm_cmpgt_epi32(va, vb));
+        _mm_storeu_si128((__m128i *)(out + i), r);
+    }
+    comparaisonScalaire(a + i, b + i, out + i, n - i);
+}
+
+// SSE2 n'a pas de multiplication 32 x 32 -> 32 bits (_mm_mullo_epi32 est SSE4.1) :
+// deux _mm_mul_epu32 sur les éléments pairs puis impairs, et on garde les 32 bits bas,
+// qui sont les mêmes en signé et en non signé.
+__attribute__((target("sse2")))
+static void multiplicationSSE2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i pair = _mm_mul_epu32(va, vb);
+        __m128i impair = _mm_mul_epu32(_mm_srli_epi64(va, 32), _mm_srli_epi64(vb, 32));
+        __m128i p = _mm_unpacklo_epi32(_mm_shuffle_epi32(pair, _MM_SHUFFLE(0, 0, 2, 0)),
+                                       _mm_shuffle_epi32(impair, _MM_SHUFFLE(0, 0, 2, 0)));
+        _mm_storeu_si128((__m128i *)(out + i), p);
+    }
+    multiplicationScalaire(a + i, b + i, out + i, n - i);
+}
+
+// Les multiplications saturée et vérifiée demandent le produit signé sur 64 bits
+// (_mm_mul_epi32, SSE4.1) : en SSE2 elles restent scalaires.
+static const NoyauxCalcul noyauxSSE2 = {
+    "sse2",
+    sommeSSE2, sommeSatureeSSE2, sommeVerifieeSSE2,
+    comparaisonSSE2,
+    multiplicationSSE2, multiplicationSatureeScalaire, multiplicationVerifieeScalaire
+};
+
+// AVX2 : 8 entiers par instruction, mêmes calculs qu'en SSE2
+__attribute__((target("avx2")))
+static void sommeAVX2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(va, vb));
+    }
+    sommeScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void sommeSatureeAVX2(const int *a, const int *b, int *out, size_t n) {
+    const __m256i max = _mm256_set1_epi32(INT_MAX);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i s = _mm256_add_epi32(va, vb);
+        __m256i deb = _mm256_and_si256(_mm256_xor_si256(va, s), _mm256_xor_si256(vb, s));
+        __m256i borne = _mm256_xor_si256(_mm256_srai_epi32(va, 31), max);
+        // blendv ne regarde que le bit de signe de chaque octet : on l'étend
+        deb = _mm256_srai_epi32(deb, 31);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_blendv_epi8(s, borne, deb));
+    }
+    sommeSatureeScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static long sommeVerifieeAVX2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i s = _mm256_add_epi32(va, vb);
+        _mm256_storeu_si256((__m256i *)(out + i), s);
+        __m256i deb = _mm256_and_si256(_mm256_xor_si256(va, s), _mm256_xor_si256(vb, s));
+        unsigned masque = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(deb));
+        if (masque != 0) {
+            return finirApresDepassement(sommeAVX2, a, b, out, n, i + 8, i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    long reste = sommeVerifieeScalaire(a + i, b + i, out + i, n - i);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+__attribute__((target("avx2")))
+static void comparaisonAVX2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i r = _mm256_sub_epi32(_mm256_cmpgt_epi32(vb, va), _mm256_cmpgt_epi32(va, vb));
+        _mm256_storeu_si256((__m256i *)(out + i), r);
+    }
+    comparaisonScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void multiplicationAVX2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_mullo_epi32(va, vb));
+    }
+    multiplicationScalaire(a + i, b + i, out + i, n - i);
+}
+
+// Produit signé 64 bits des éléments pairs puis impairs (_mm256_mul_epi32) ;
+// bas = 32 bits bas, haut = 32 bits hauts de chaque produit, remis dans l'ordre.
+// Le produit tient sur 32 bits si et seulement si haut == bas >> 31.
+__attribute__((target("avx2")))
+static __m256i produitAVX2(__m256i va, __m256i vb, __m256i *correct) {
+    __m256i pair = _mm256_mul_epi32(va, vb);
+    __m256i impair = _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32));
+    __m256i bas = _mm256_blend_epi32(pair, _mm256_slli_epi64(impair, 32), 0xAA);
+    __m256i haut = _mm256_blend_epi32(_mm256_srli_epi64(pair, 32), impair, 0xAA);
+    *correct = _mm256_cmpeq_epi32(haut, _mm256_srai_epi32(bas, 31));
+    return bas;
+}
+
+__attribute__((target("avx2")))
+static void multiplicationSatureeAVX2(const int *a, const int *b, int *out, size_t n) {
+    const __m256i max = _mm256_set1_epi32(INT_MAX);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i correct;
+        __m256i p = produitAVX2(va, vb, &correct);
+        // Le signe du vrai produit est celui de a ^ b
+        __m256i borne = _mm256_xor_si256(_mm256_srai_epi32(_mm256_xor_si256(va, vb), 31), max);
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_blendv_epi8(borne, p, correct));
+    }
+    multiplicationSatureeScalaire(a + i, b + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static long multiplicationVerifieeAVX2(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + i));
+        __m256i correct;
+        _mm256_storeu_si256((__m256i *)(out + i), produitAVX2(va, vb, &correct));
+        unsigned masque = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(correct)) & 0xFFu;
+        if (masque != 0) {
+            return finirApresDepassement(multiplicationAVX2, a, b, out, n, i + 8, i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    long reste = multiplicationVerifieeScalaire(a + i, b + i, out + i, n - i);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+static const NoyauxCalcul noyauxAVX2 = {
+    "avx2",
+    sommeAVX2, sommeSatureeAVX2, sommeVerifieeAVX2,
+    comparaisonAVX2,
+    multiplicationAVX2, multiplicationSatureeAVX2, multiplicationVerifieeAVX2
+};
+
+#endif
+
+#ifdef CALCUL_NEON
+
+// NEON a l'addition saturée (vqaddq) et la réduction saturée 64 -> 32 bits (vqmovn) :
+// un dépassement se voit à la différence entre le résultat saturé et le résultat modulo 2^32.
+// Le masque des différences est réduit comme dans rechercherNEON : 16 bits par élément.
+static unsigned premierDifferentNEON(int32x4_t x, int32x4_t y) {
+    uint32x4_t diff = vmvnq_u32(vceqq_s32(x, y));
+    uint64_t masque = vget_lane_u64(vreinterpret_u64_u16(vshrn_n_u32(diff, 16)), 0);
+    return masque == 0 ? 4u : (unsigned)(__builtin_ctzll(masque) / 16);
+}
+
+static void sommeNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, vaddq_s32(vld1q_s32(a + i), vld1q_s32(b + i)));
+    }
+    sommeScalaire(a + i, b + i, out + i, n - i);
+}
+
+static void sommeSatureeNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, vqaddq_s32(vld1q_s32(a + i), vld1q_s32(b + i)));
+    }
+    sommeSatureeScalaire(a + i, b + i, out + i, n - i);
+}
+
+static long sommeVerifieeNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        int32x4_t s = vaddq_s32(va, vb);
+        vst1q_s32(out + i, s);
+        unsigned k = premierDifferentNEON(s, vqaddq_s32(va, vb));
+        if (k < 4) {
+            return finirApresDepassement(sommeNEON, a, b, out, n, i + 4, i + k);
+        }
+    }
+    long reste = sommeVerifieeScalaire(a + i, b + i, out + i, n - i);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+static void comparaisonNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        int32x4_t r = vsubq_s32(vreinterpretq_s32_u32(vcltq_s32(va, vb)),
+                                vreinterpretq_s32_u32(vcgtq_s32(va, vb)));
+        vst1q_s32(out + i, r);
+    }
+    comparaisonScalaire(a + i, b + i, out + i, n - i);
+}
+
+static void multiplicationNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, vmulq_s32(vld1q_s32(a + i), vld1q_s32(b + i)));
+    }
+    multiplicationScalaire(a + i, b + i, out + i, n - i);
+}
+
+// Produits 64 bits des deux moitiés, réduits en 32 bits avec saturation
+static int32x4_t produitSatureNEON(int32x4_t va, int32x4_t vb) {
+    int64x2_t bas = vmull_s32(vget_low_s32(va), vget_low_s32(vb));
+    int64x2_t haut = vmull_s32(vget_high_s32(va), vget_high_s32(vb));
+    return vcombine_s32(vqmovn_s64(bas), vqmovn_s64(haut));
+}
+
+static void multiplicationSatureeNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_s32(out + i, produitSatureNEON(vld1q_s32(a + i), vld1q_s32(b + i)));
+    }
+    multiplicationSatureeScalaire(a + i, b + i, out + i, n - i);
+}
+
+static long multiplicationVerifieeNEON(const int *a, const int *b, int *out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int32x4_t va = vld1q_s32(a + i);
+        int32x4_t vb = vld1q_s32(b + i);
+        int32x4_t p = vmulq_s32(va, vb);
+        vst1q_s32(out + i, p);
+        unsigned k = premierDifferentNEON(p, produitSatureNEON(va, vb));
+        if (k < 4) {
+            return finirApresDepassement(multiplicationNEON, a, b, out, n, i + 4, i + k);
+        }
+    }
+    long reste = multiplicationVerifieeScalaire(a + i, b + i, out + i, n - i);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+static const NoyauxCalcul noyauxNEON = {
+    "neon",
+    sommeNEON, sommeSatureeNEON, sommeVerifieeNEON,
+    comparaisonNEON,
+    multiplicationNEON, multiplicationSatureeNEON, multiplicationVerifieeNEON
+};
+
+#endif
+
+// Choix des noyaux selon les instructions disponibles sur la machine
+static const NoyauxCalcul *noyaux = NULL;
+
+static void choisirNoyaux(void) {
+    const NoyauxCalcul *choix = &noyauxScalaires;
+#ifdef CALCUL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        choix = &noyauxAVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        choix = &noyauxSSE2;
+    }
+#elif defined(CALCUL_NEON)
+#if defined(__linux__) && !defined(__aarch64__)
+    if (getauxval(AT_HWCAP) & HWCAP_NEON)
+#endif
+    {
+        choix = &noyauxNEON;
+    }
+#endif
+    noyaux = choix;
+}
+
+static const NoyauxCalcul *noyauxCourants(void) {
+    if (noyaux == NULL) {
+        choisirNoyaux();
+    }
+    return noyaux;
+}
+
+void somme_n(const int *a, const int *b, int *out, size_t n) {
+    noyauxCourants()->somme(a, b, out, n);
+}
+
+void somme_n_saturee(const int *a, const int *b, int *out, size_t n) {
+    noyauxCourants()->sommeSaturee(a, b, out, n);
+}
+
+long somme_n_verifiee(const int *a, const int *b, int *out, size_t n) {
+    return noyauxCourants()->sommeVerifiee(a, b, out, n);
+}
+
+void comparaison_n(const int *a, const int *b, int *out, size_t n) {
+    noyauxCourants()->comparaison(a, b, out, n);
+}
+
+void multiplication_n(const int *a, const int *b, int *out, size_t n) {
+    noyauxCourants()->multiplication(a, b, out, n);
+}
+
+void multiplication_n_saturee(const int *a, const int *b, int *out, size_t n) {
+    noyauxCourants()->multiplicationSaturee(a, b, out, n);
+}
+
+long multiplication_n_verifiee(const int *a, const int *b, int *out, size_t n) {
+    return noyauxCourants()->multiplicationVerifiee(a, b, out, n);
+}
+
+const char *calculImplementation(void) {
+    return noyauxCourants()->nom;
+}
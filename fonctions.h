@@ -1,14 +1,56 @@
-// le indef permet d'eviter toute repeition dans le fichier
-// Il evite alors les conflits
-
-#ifndef FONCTIONS_H
-#define FONCTIONS_H
-
-// Déclarations de vos fonctions
-int somme(int a, int b);
-int comparaison(int a, int b);
-int multiplication(int a, int b);
-
-
-#endif
-
+// le indef permet d'eviter toute repeition dans le fichier
+// Il evite alors les conflits
+
+#ifndef FONCTIONS_H
+#define FONCTIONS_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Déclarations de vos fonctions
+// Les versions scalaires sont en ligne : l'appel ne coûte rien, même
+// depuis un autre fichier comme main.c
+static inline int somme(int a, int b) {
+    return a + b;
+}
+
+// -1, 0 ou 1 sans branchement
+static inline int comparaison(int a, int b) {
+    return (a > b) - (a < b);
+}
+
+static inline int multiplication(int a, int b) {
+    return a * b;
+}
+
+// Versions sur des tableaux : out[i] = a[i] op b[i] pour i < n.
+// Noyau SSE2 / AVX2 / NEON choisi à l'exécution, comme pour rechercher().
+// Trois modes pour la somme et la multiplication :
+//   - somme_n, multiplication_n : résultat modulo 2^32 (pas de comportement
+//     indéfini en cas de dépassement) ;
+//   - *_saturee : résultat borné à INT_MIN / INT_MAX ;
+//   - *_verifiee : résultat modulo 2^32, et retour de l'indice du premier
+//     élément qui a débordé, -1 s'il n'y en a aucun.
+// out peut être a ou b (calcul en place).
+void somme_n(const int *a, const int *b, int *out, size_t n);
+void somme_n_saturee(const int *a, const int *b, int *out, size_t n);
+long somme_n_verifiee(const int *a, const int *b, int *out, size_t n);
+
+// out[i] = comparaison(a[i], b[i])
+void comparaison_n(const int *a, const int *b, int *out, size_t n);
+
+void multiplication_n(const int *a, const int *b, int *out, size_t n);
+void multiplication_n_saturee(const int *a, const int *b, int *out, size_t n);
+long multiplication_n_verifiee(const int *a, const int *b, int *out, size_t n);
+
+// Nom du noyau utilisé : "avx2", "sse2", "neon" ou "scalaire"
+const char *calculImplementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
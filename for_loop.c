@@ -1,22 +1,22 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            Affichage for loop
-            
------------------------------------*/
-#include <stdio.h>
-
-int main() {
-    int i;
-
-    printf("Values of the variable (1 to 100):\n");
-    
-    for (i = 1; i <= 100; i++) {
-        printf("%d ", i);
-    }
-    
-    printf("\n");
-
-    return 0;
-}
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            Affichage for loop
+            
+-----------------------------------*/
+#include <stdio.h>
+
+int main() {
+    int i;
+
+    printf("Values of the variable (1 to 100):\n");
+    
+    for (i = 1; i <= 100; i++) {
+        printf("%d ", i);
+    }
+    
+    printf("\n");
+
+    return 0;
+}
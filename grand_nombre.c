@@ -0,0 +1,281 @@
+#include <stdlib.h>
+#include <string.h>
+#include "grand_nombre.h"
+
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__)
+#include <immintrin.h>
+#define GRAND_NOMBRE_MULX 1
+#endif
+
+#if GRAND_NOMBRE_SEUIL_KARATSUBA < 4
+#error "GRAND_NOMBRE_SEUIL_KARATSUBA doit valoir au moins 4"
+#endif
+
+// r[0..n-1] += a[0..n-1] * m, retourne le mot de retenue (r[n] de la ligne)
+typedef uint64_t (*NoyauLigne)(uint64_t *r, const uint64_t *a, size_t n, uint64_t m);
+
+// Version portable. La retenue ne déborde jamais :
+// (2^64 - 1)^2 + 2 (2^64 - 1) = 2^128 - 1.
+static uint64_t ajouterProduitPortable(uint64_t *r, const uint64_t *a, size_t n, uint64_t m) {
+    uint64_t retenue = 0;
+    for (size_t i = 0; i < n; i++) {
+#if defined(__SIZEOF_INT128__)
+        unsigned __int128 t = (unsigned __int128)a[i] * m + r[i] + retenue;
+        r[i] = (uint64_t)t;
+        retenue = (uint64_t)(t >> 64);
+#else
+        Produit128 p = multiplier64(a[i], m);
+        uint64_t s = p.bas + retenue;
+        p.haut += s < retenue;
+        r[i] += s;
+        p.haut += r[i] < s;
+        retenue = p.haut;
+#endif
+    }
+    return retenue;
+}
+
+#ifdef GRAND_NOMBRE_MULX
+
+// mulx ne touche pas aux drapeaux, adcx et adox ont chacun leur retenue (CF et OF) :
+// les deux chaînes d'additions (mot haut précédent + mot bas, puis ajout à r) avancent
+// en parallèle. La retenue finale tient sur un mot, car la ligne entière tient sur n + 1 mots.
+__attribute__((target("bmi2,adx")))
+static uint64_t ajouterProduitMulx(uint64_t *r, const uint64_t *a, size_t n, uint64_t m) {
+    unsigned char c1 = 0, c2 = 0;
+    unsigned long long precedent = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long haut, bas, s;
+        bas = _mulx_u64(a[i], m, &haut);
+        c1 = _addcarryx_u64(c1, bas, precedent, &bas);
+        c2 = _addcarryx_u64(c2, r[i], bas, &s);
+        r[i] = s;
+        precedent = haut;
+    }
+    return precedent + c1 + c2;
+}
+
+#endif
+
+// Choix de la boucle interne selon les instructions disponibles sur la machine
+static NoyauLigne noyau = NULL;
+static const char *nomNoyau = "portable";
+
+static void choisirNoyau(void) {
+    NoyauLigne choix = ajouterProduitPortable;
+#ifdef GRAND_NOMBRE_MULX
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx")) {
+        choix = ajouterProduitMulx;
+        nomNoyau = "mulx";
+    }
+#endif
+    noyau = choix;
+}
+
+static NoyauLigne noyauCourant(void) {
+    if (noyau == NULL) {
+        choisirNoyau();
+    }
+    return noyau;
+}
+
+// r[0..n-1] += x[0..m-1] avec m <= n, retourne la retenue sortante
+static uint64_t ajouterMots(uint64_t *r, size_t n, const uint64_t *x, size_t m) {
+    uint64_t retenue = 0;
+    size_t i = 0;
+    for (; i < m; i++) {
+        uint64_t s = r[i] + retenue;
+        retenue = s < retenue;
+        r[i] = s + x[i];
+        retenue += r[i] < s;
+    }
+    for (; retenue != 0 && i < n; i++) {
+        retenue = ++r[i] == 0;
+    }
+    return retenue;
+}
+
+// r[0..n-1] -= x[0..m-1] avec m <= n, retourne l'emprunt sortant
+static uint64_t soustraireMots(uint64_t *r, size_t n, const uint64_t *x, size_t m) {
+    uint64_t emprunt = 0;
+    size_t i = 0;
+    for (; i < m; i++) {
+        uint64_t d = r[i] - x[i];
+        uint64_t e = r[i] < x[i];
+        r[i] = d - emprunt;
+        emprunt = e + (d < emprunt);
+    }
+    for (; emprunt != 0 && i < n; i++) {
+        emprunt = r[i]-- == 0;
+    }
+    return emprunt;
+}
+
+// Une ligne par mot de b : na * nb produits 64 x 64
+static void scolaire(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *r,
+                     NoyauLigne ligne) {
+    memset(r, 0, na * sizeof(uint64_t));
+    for (size_t j = 0; j < nb; j++) {
+        r[j + na] = ligne(r + j, a, na, b[j]);
+    }
+}
+
+void multiplierMotsScolaire(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *resultat) {
+    scolaire(a, na, b, nb, resultat, noyauCourant());
+}
+
+// Mots de travail demandés par karatsuba() pour deux opérandes de n mots :
+// (a0 + a1), (b0 + b1) et leur produit, puis la récursion sur ce produit
+static size_t tailleTravail(size_t n) {
+    size_t total = 0;
+    while (n >= GRAND_NOMBRE_SEUIL_KARATSUBA) {
+        size_t k = n - n / 2;
+        total += 4 * (k + 1);
+        n = k + 1;
+    }
+    return total;
+}
+
+// r[0..2n-1] = a * b, deux opérandes de n mots.
+// Avec a = a1 B^m + a0 et b = b1 B^m + b0 :
+//   a b = z2 B^2m + (z1 - z2 - z0) B^m + z0
+// où z0 = a0 b0, z2 = a1 b1 et z1 = (a0 + a1)(b0 + b1) : trois produits au lieu de quatre.
+static void karatsuba(const uint64_t *a, const uint64_t *b, size_t n, uint64_t *r,
+                      uint64_t *travail, NoyauLigne ligne) {
+    if (n < GRAND_NOMBRE_SEUIL_KARATSUBA) {
+        scolaire(a, n, b, n, r, ligne);
+        return;
+    }
+
+    const size_t m = n / 2, k = n - m;
+    uint64_t *sa = travail;
+    uint64_t *sb = sa + (k + 1);
+    uint64_t *z1 = sb + (k + 1);
+    uint64_t *suite = z1 + 2 * (k + 1);
+
+    // z0 et z2 directement à leur place dans r
+    karatsuba(a, b, m, r, travail, ligne);
+    karatsuba(a + m, b + m, k, r + 2 * m, travail, ligne);
+
+    memcpy(sa, a + m, k * sizeof(uint64_t));
+    sa[k] = ajouterMots(sa, k, a, m);
+    memcpy(sb, b + m, k * sizeof(uint64_t));
+    sb[k] = ajouterMots(sb, k, b, m);
+    karatsuba(sa, sb, k + 1, z1, suite, ligne);
+
+    // z1 - z0 - z2 est positif et tient sur 2k + 2 mots
+    soustraireMots(z1, 2 * (k + 1), r, 2 * m);
+    soustraireMots(z1, 2 * (k + 1), r + 2 * m, 2 * k);
+    ajouterMots(r + m, 2 * n - m, z1, 2 * (k + 1));
+}
+
+int multiplierMots(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *resultat) {
+    NoyauLigne ligne = noyauCourant();
+
+    // a est le plus long des deux
+    if (na < nb) {
+        const uint64_t *t = a; a = b; b = t;
+        size_t tn = na; na = nb; nb = tn;
+    }
+    if (nb < GRAND_NOMBRE_SEUIL_KARATSUBA) {
+        scolaire(a, na, b, nb, resultat, ligne);
+        return 0;
+    }
+
+    if (na == nb) {
+        uint64_t *travail = malloc(tailleTravail(nb) * sizeof(uint64_t));
+        if (travail == NULL) {
+            return -1;
+        }
+        karatsuba(a, b, nb, resultat, travail, ligne);
+        free(travail);
+        return 0;
+    }
+
+    // Opérandes déséquilibrés : a est découpé en tranches de nb mots, chacune multipliée
+    // par b avec Karatsuba puis ajoutée à sa place. La dernière tranche est complétée
+    // par des zéros.
+    uint64_t *partiel = malloc((3 * nb + tailleTravail(nb)) * sizeof(uint64_t));
+    if (partiel == NULL) {
+        return -1;
+    }
+    uint64_t *tranche = partiel + 2 * nb;
+    uint64_t *travail = tranche + nb;
+
+    memset(resultat, 0, (na + nb) * sizeof(uint64_t));
+    for (size_t i = 0; i < na; i += nb) {
+        const size_t t = na - i < nb ? na - i : nb;
+        const uint64_t *source = a + i;
+        if (t < nb) {
+            memcpy(tranche, a + i, t * sizeof(uint64_t));
+            memset(tranche + t, 0, (nb - t) * sizeof(uint64_t));
+            source = tranche;
+        }
+        karatsuba(source, b, nb, partiel, travail, ligne);
+        ajouterMots(resultat + i, na + nb - i, partiel, t + nb);
+    }
+    free(partiel);
+    return 0;
+}
+
+// Divisions successives par 10^9 : chaque mot est divisé en deux moitiés de 32 bits,
+// le reste (< 10^9 < 2^30) suivi d'une moitié tient sur 64 bits.
+size_t grandNombreVersTexte(uint64_t *x, size_t n, char *texte, size_t taille) {
+    const uint64_t milliard = 1000000000u;
+    size_t longueur = 0;
+
+    while (n > 0 && x[n - 1] == 0) n--;
+    do {
+        uint64_t reste = 0;
+        for (size_t i = n; i-- > 0;) {
+            uint64_t haut = (reste << 32) | (x[i] >> 32);
+            uint64_t qh = haut / milliard;
+            reste = haut % milliard;
+            uint64_t bas = (reste << 32) | (uint32_t)x[i];
+            x[i] = (qh << 32) | (bas / milliard);
+            reste = bas % milliard;
+        }
+        while (n > 0 && x[n - 1] == 0) n--;
+
+        // Neuf chiffres par paquet, sans les zéros de tête pour le dernier
+        int chiffres = 0;
+        do {
+            if (longueur + 1 >= taille) {
+                return 0;
+            }
+            texte[longueur++] = (char)('0' + reste % 10);
+            reste /= 10;
+            chiffres++;
+        } while (n > 0 ? chiffres < 9 : reste != 0);
+    } while (n > 0);
+
+    texte[longueur] = '\0';
+    for (size_t i = 0, j = longueur - 1; i < j; i++, j--) {
+        char c = texte[i]; texte[i] = texte[j]; texte[j] = c;
+    }
+    return longueur;
+}
+
+size_t produit128VersTexte(Produit128 p, int signe, char *texte, size_t taille) {
+    uint64_t x[2] = {p.bas, p.haut};
+    size_t debut = 0;
+
+    if (signe && (int64_t)p.haut < 0) {
+        if (taille < 2) {
+            return 0;
+        }
+        // Valeur absolue en complément à deux
+        x[0] = ~x[0] + 1;
+        x[1] = ~x[1] + (x[0] == 0);
+        texte[0] = '-';
+        debut = 1;
+    }
+    size_t longueur = grandNombreVersTexte(x, 2, texte + debut, taille - debut);
+    return longueur == 0 ? 0 : longueur + debut;
+}
+
+const char *grandNombreImplementation(void) {
+    noyauCourant();
+    return nomNoyau;
+}
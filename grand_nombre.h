@@ -0,0 +1,78 @@
+// Multiplication de grands nombres
+// Un grand nombre est un tableau de mots de 64 bits, poids faible en premier.
+// Produit 64 x 64 -> 128 bits en ligne (__int128 quand le compilateur l'a),
+// multiplication scolaire au-dessous de GRAND_NOMBRE_SEUIL_KARATSUBA mots,
+// Karatsuba au-dessus. La boucle interne utilise mulx / adcx / adox
+// si le processeur les a (BMI2 + ADX), choisie à l'exécution.
+
+#ifndef GRAND_NOMBRE_H
+#define GRAND_NOMBRE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Nombre de mots à partir duquel multiplierMots passe à Karatsuba
+// (mesuré avec bench_grand_nombre)
+#ifndef GRAND_NOMBRE_SEUIL_KARATSUBA
+#define GRAND_NOMBRE_SEUIL_KARATSUBA 32
+#endif
+
+// Produit sur 128 bits, en complément à deux pour multiplier64Signe
+typedef struct {
+    uint64_t bas;
+    uint64_t haut;
+} Produit128;
+
+static inline Produit128 multiplier64(uint64_t a, uint64_t b) {
+    Produit128 p;
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 t = (unsigned __int128)a * b;
+    p.bas = (uint64_t)t;
+    p.haut = (uint64_t)(t >> 64);
+#else
+    // Sans __int128 : quatre produits 32 x 32 -> 64 bits
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32;
+    uint64_t b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t milieu = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    p.bas = (milieu << 32) | (uint32_t)p00;
+    p.haut = p11 + (p01 >> 32) + (p10 >> 32) + (milieu >> 32);
+#endif
+    return p;
+}
+
+// Produit signé : le produit non signé, corrigé de b (resp. a) si a (resp. b) est négatif
+static inline Produit128 multiplier64Signe(int64_t a, int64_t b) {
+    Produit128 p = multiplier64((uint64_t)a, (uint64_t)b);
+    p.haut -= (a < 0 ? (uint64_t)b : 0) + (b < 0 ? (uint64_t)a : 0);
+    return p;
+}
+
+// resultat[0..na+nb-1] = a[0..na-1] * b[0..nb-1].
+// resultat ne doit recouvrir ni a ni b.
+// Au-dessus du seuil, la mémoire de travail de Karatsuba est allouée avec malloc :
+// retourne 0, ou -1 si l'allocation échoue (resultat n'est alors pas écrit).
+int multiplierMots(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *resultat);
+
+// Même résultat par la méthode scolaire seule (référence pour les benchmarks)
+void multiplierMotsScolaire(const uint64_t *a, size_t na, const uint64_t *b, size_t nb, uint64_t *resultat);
+
+// Écriture décimale de x[0..n-1] dans texte (taille octets, zéro final compris).
+// x est détruit (divisé jusqu'à zéro). Retourne la longueur, 0 si texte est trop petit.
+size_t grandNombreVersTexte(uint64_t *x, size_t n, char *texte, size_t taille);
+
+// Écriture décimale d'un produit 128 bits, signé si signe != 0
+size_t produit128VersTexte(Produit128 p, int signe, char *texte, size_t taille);
+
+// Nom de la boucle interne utilisée : "mulx" ou "portable"
+const char *grandNombreImplementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,6 @@
-#include <stdio.h>
-
-int main() {
-    printf("Hello Girls!\n");
-    return 0;
-}
+#include <stdio.h>
+
+int main() {
+    printf("Hello Girls!\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <string.h>
+#include "index_hachage.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define INDEX_SSE2 1
+#endif
+
+// Requêtes d'avance dont indexRechercheLot précharge le groupe
+#define INDEX_DISTANCE_PRECHARGEMENT 8
+
+// Hachage de Fibonacci : les bits de poids fort choisissent le groupe, les
+// 7 bits juste en dessous vont dans l'octet de contrôle
+static inline uint64_t hacher(int valeur) {
+    return (uint64_t)(uint32_t)valeur * 0x9E3779B97F4A7C15ull;
+}
+
+static inline uint8_t empreinte(const IndexHachage *index, uint64_t h) {
+    return (uint8_t)((h >> (index->decalage - 7)) & 0x7F);
+}
+
+// Bit i du résultat : l'octet de contrôle i du groupe vaut h2 ; *vides : les cases libres
+static inline unsigned comparerGroupe(const uint8_t *groupe, uint8_t h2, unsigned *vides) {
+#ifdef INDEX_SSE2
+    __m128i controle = _mm_load_si128((const __m128i *)groupe);
+    // Seul INDEX_VIDE a le bit de poids fort
+    *vides = (unsigned)_mm_movemask_epi8(controle);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(controle, _mm_set1_epi8((char)h2)));
+#else
+    unsigned egaux = 0, libres = 0;
+    for (unsigned i = 0; i < INDEX_GROUPE; i++) {
+        egaux |= (unsigned)(groupe[i] == h2) << i;
+        libres |= (unsigned)(groupe[i] == INDEX_VIDE) << i;
+    }
+    *vides = libres;
+    return egaux;
+#endif
+}
+
+static inline long chercherDansTable(const IndexHachage *index, int valeur) {
+    uint64_t h = hacher(valeur);
+    uint8_t h2 = empreinte(index, h);
+    size_t g = (size_t)(h >> index->decalage);
+
+    // Sondage triangulaire sur les groupes : les visite tous, et il reste
+    // toujours une case libre (remplissage <= 7/8)
+    for (size_t pas = 1;; pas++) {
+        unsigned vides;
+        unsigned candidats = comparerGroupe(index->controle + g * INDEX_GROUPE, h2, &vides);
+        while (candidats != 0) {
+            const CaseIndex *c = &index->cases[g * INDEX_GROUPE + (size_t)__builtin_ctz(candidats)];
+            if (c->cle == valeur) {
+                return (long)c->position;
+            }
+            candidats &= candidats - 1;
+        }
+        if (vides != 0) {
+            return -1;
+        }
+        g = (g + pas) & index->masqueGroupes;
+    }
+}
+
+// 0 si valeur est hors de l'ensemble de bits (quand il existe)
+static inline int peutContenir(const IndexHachage *index, int valeur) {
+    if (index->bits == NULL) {
+        return 1;
+    }
+    uint32_t d = (uint32_t)valeur - (uint32_t)index->minimum;
+    return d < index->etendue && ((index->bits[d >> 6] >> (d & 63)) & 1);
+}
+
+// Ajoute valeur si elle n'y est pas encore : la première position est gardée
+static void inserer(IndexHachage *index, int valeur, uint32_t position) {
+    uint64_t h = hacher(valeur);
+    uint8_t h2 = empreinte(index, h);
+    size_t g = (size_t)(h >> index->decalage);
+
+    for (size_t pas = 1;; pas++) {
+        uint8_t *groupe = index->controle + g * INDEX_GROUPE;
+        unsigned vides;
+        unsigned candidats = comparerGroupe(groupe, h2, &vides);
+        while (candidats != 0) {
+            if (index->cases[g * INDEX_GROUPE + (size_t)__builtin_ctz(candidats)].cle == valeur) {
+                return;
+            }
+            candidats &= candidats - 1;
+        }
+        // Sans suppression, la première case libre du sondage est la bonne
+        if (vides != 0) {
+            unsigned i = (unsigned)__builtin_ctz(vides);
+            groupe[i] = h2;
+            index->cases[g * INDEX_GROUPE + i].cle = valeur;
+            index->cases[g * INDEX_GROUPE + i].position = position;
+            index->nbValeurs++;
+            return;
+        }
+        g = (g + pas) & index->masqueGroupes;
+    }
+}
+
+int indexCreer(IndexHachage *index, const int *tab, size_t n) {
+    memset(index, 0, sizeof(*index));
+    if (n > UINT32_MAX) {
+        return -1;
+    }
+
+    // Au moins 8/7 case par élément, au moins 2 groupes
+    size_t nbGroupes = 2;
+    int log2Groupes = 1;
+    while (nbGroupes * INDEX_GROUPE * 7 / 8 < n) {
+        nbGroupes *= 2;
+        log2Groupes++;
+    }
+    index->masqueGroupes = nbGroupes - 1;
+    index->decalage = 64 - log2Groupes;
+    index->controle = aligned_alloc(INDEX_GROUPE, nbGroupes * INDEX_GROUPE);
+    index->cases = malloc(nbGroupes * INDEX_GROUPE * sizeof(CaseIndex));
+    if (index->controle == NULL || index->cases == NULL) {
+        indexLiberer(index);
+        return -1;
+    }
+    memset(index->controle, INDEX_VIDE, nbGroupes * INDEX_GROUPE);
+
+    for (size_t i = 0; i < n; i++) {
+        inserer(index, tab[i], (uint32_t)i);
+    }
+
+    // Intervalle dense : un bit par valeur possible
+    if (n > 0) {
+        int minimum = tab[0], maximum = tab[0];
+        for (size_t i = 1; i < n; i++) {
+            minimum = tab[i] < minimum ? tab[i] : minimum;
+            maximum = tab[i] > maximum ? tab[i] : maximum;
+        }
+        uint64_t etendue = (uint64_t)((int64_t)maximum - minimum) + 1;
+        if (etendue <= INDEX_ETENDUE_MAX && etendue <= (uint64_t)INDEX_BITS_PAR_VALEUR * n) {
+            index->bits = calloc((size_t)(etendue + 63) / 64, sizeof(uint64_t));
+            if (index->bits != NULL) {
+                index->minimum = minimum;
+                index->etendue = (uint32_t)etendue;
+                for (size_t i = 0; i < n; i++) {
+                    uint32_t d = (uint32_t)tab[i] - (uint32_t)minimum;
+                    index->bits[d >> 6] |= 1ull << (d & 63);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+void indexLiberer(IndexHachage *index) {
+    free(index->controle);
+    free(index->cases);
+    free(index->bits);
+    memset(index, 0, sizeof(*index));
+}
+
+long indexRechercher(const IndexHachage *index, int valeur) {
+    if (!peutContenir(index, valeur)) {
+        return -1;
+    }
+    return chercherDansTable(index, valeur);
+}
+
+int indexContient(const IndexHachage *index, int valeur) {
+    if (index->bits != NULL) {
+        return peutContenir(index, valeur);
+    }
+    return chercherDansTable(index, valeur) >= 0;
+}
+
+void indexRechercheLot(const IndexHachage *index, const int *cles, size_t nbCles, long *resultats) {
+    for (size_t k = 0; k < nbCles; k++) {
+        if (k + INDEX_DISTANCE_PRECHARGEMENT < nbCles) {
+            uint64_t h = hacher(cles[k + INDEX_DISTANCE_PRECHARGEMENT]);
+            size_t g = (size_t)(h >> index->decalage);
+            __builtin_prefetch(index->controle + g * INDEX_GROUPE);
+            __builtin_prefetch(index->cases + g * INDEX_GROUPE);
+        }
+        resultats[k] = indexRechercher(index, cles[k]);
+    }
+}
+
+const char *indexImplementation(void) {
+#ifdef INDEX_SSE2
+    return "sse2";
+#else
+    return "scalaire";
+#endif
+}
@@ -0,0 +1,82 @@
+// Index par hachage d'un tableau non trié : valeur -> première position
+// Pour répondre à beaucoup de requêtes sur une même table, au lieu d'un
+// parcours complet (rechercher) par requête. Table à adressage ouvert à la
+// manière des « Swiss tables » :
+// - les cases sont rangées par groupes de 16, avec un octet de contrôle par
+//   case (7 bits du hachage, ou INDEX_VIDE) ;
+// - une requête compare les 16 octets de contrôle d'un groupe en une
+//   instruction (SSE2) et ne lit que les cases dont l'octet correspond, en
+//   moyenne à peine plus d'une ; un groupe qui a une case vide arrête la
+//   recherche ;
+// - taux de remplissage d'au plus 7/8 : O(1) en moyenne, presque toujours
+//   un seul groupe lu.
+// Si les valeurs tiennent dans un intervalle assez petit et assez rempli,
+// un ensemble de bits (un bit par valeur de l'intervalle) est construit en
+// plus : les valeurs absentes y sont écartées sans lire la table.
+// L'index ne suit pas les modifications du tableau : le reconstruire.
+
+#ifndef INDEX_HACHAGE_H
+#define INDEX_HACHAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INDEX_GROUPE 16                 // cases par groupe (un registre SSE2)
+#define INDEX_VIDE   0x80u              // octet de contrôle d'une case libre
+
+// Ensemble de bits construit si l'intervalle des valeurs a au plus
+// INDEX_BITS_PAR_VALEUR fois plus de valeurs possibles que le tableau n'a
+// d'éléments, et au plus INDEX_ETENDUE_MAX valeurs (32 Mio de bits)
+#define INDEX_BITS_PAR_VALEUR 32
+#define INDEX_ETENDUE_MAX     (1u << 28)
+
+// Construire l'index coûte autant que 250 à 500 parcours, quel que soit n
+// (mesuré avec bench_index.c) : on répond par des parcours aux premières
+// requêtes, et l'index n'est construit qu'à partir de celle-ci. Une requête
+// isolée ne paie jamais la construction, une longue série paie au plus deux
+// fois le coût optimal.
+#define INDEX_SEUIL_REQUETES 256
+
+typedef struct {
+    int cle;
+    uint32_t position;
+} CaseIndex;
+
+typedef struct {
+    uint8_t *controle;                  // nbGroupes * INDEX_GROUPE octets, aligné sur 16
+    CaseIndex *cases;
+    size_t masqueGroupes;               // nbGroupes - 1 (nbGroupes : une puissance de 2)
+    int decalage;                       // 64 - log2(nbGroupes)
+    size_t nbValeurs;                   // valeurs distinctes
+    uint64_t *bits;                     // NULL si l'intervalle n'est pas dense
+    int minimum;
+    uint32_t etendue;                   // bits[] couvre minimum .. minimum + etendue - 1
+} IndexHachage;
+
+// Construit l'index de tab[0..n-1]. Retourne 0, ou -1 si la mémoire manque
+// ou si n dépasse UINT32_MAX.
+int indexCreer(IndexHachage *index, const int *tab, size_t n);
+void indexLiberer(IndexHachage *index);
+
+// Même résultat que rechercher(tab, n, valeur) : première position, -1 si absente
+long indexRechercher(const IndexHachage *index, int valeur);
+
+// 1 si valeur est dans le tableau, 0 sinon
+int indexContient(const IndexHachage *index, int valeur);
+
+// resultats[k] = indexRechercher(index, cles[k]) pour k < nbCles, les
+// groupes des requêtes suivantes étant préchargés
+void indexRechercheLot(const IndexHachage *index, const int *cles, size_t nbCles, long *resultats);
+
+// Nom de la comparaison des octets de contrôle : "sse2" ou "scalaire"
+const char *indexImplementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
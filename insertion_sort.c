@@ -1,51 +1,84 @@
-#include <stdio.h>
-
-// Fonction pour effectuer le tri par insertion
-void triInsertion(int tableau[], int taille) {
-    int i, j, cle;
-    for (i = 1; i < taille; i++) {
-        cle = tableau[i];
-        j = i - 1;
-
-        // Déplacer les éléments du tableau qui sont plus grands que la clé
-        // vers la droite d'une position
-        while (j >= 0 && tableau[j] > cle) {
-            tableau[j + 1] = tableau[j];
-            j = j - 1;
-        }
-        tableau[j + 1] = cle; // Insérer la clé à sa position correcte
-    }
-}
-
-int main() {
-    int taille;
-
-    // Demander à l'utilisateur de saisir la taille du tableau
-    printf("Entrez la taille du tableau : ");
-    scanf("%d", &taille);
-
-    int tableau[taille];
-
-    // Demander à l'utilisateur de saisir les éléments du tableau
-    printf("Entrez les %d éléments du tableau :\n", taille);
-    for (int i = 0; i < taille; i++) {
-        printf("Element %d : ", i + 1);
-        scanf("%d", &tableau[i]);
-    }
-
-    printf("Tableau avant le tri par insertion :\n");
-    for (int i = 0; i < taille; i++) {
-        printf("%d ", tableau[i]);
-    }
-    printf("\n");
-
-    triInsertion(tableau, taille);
-
-    printf("Tableau après le tri par insertion :\n");
-    for (int i = 0; i < taille; i++) {
-        printf("%d ", tableau[i]);
-    }
-    printf("\n");
-
-    return 0;
-}
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "arene.h"
+#include "flux.h"
+#include "tri.h"
+#include "tri_parallele.h"
+
+static EcrivainEntiers sortie;
+
+// Mode non interactif : insertion_sort fichier (ou - pour l'entrée standard)
+// Trie tous les entiers du fichier et les écrit triés, un par ligne.
+static int trierFichier(const char *chemin) {
+    size_t n;
+
+    int *tableau = lireFichierEntiers(chemin, &n);
+    if (tableau == NULL) {
+        return 1;
+    }
+    if (n > INT_MAX) {
+        fprintf(stderr, "%s : trop d'éléments\n", chemin);
+        free(tableau);
+        return 1;
+    }
+
+    // Gros fichiers : un fil par processeur ; sans mémoire pour le tampon,
+    // tri sur un seul fil
+    if (triParallele(tableau, n, 0) != 0) {
+        triInsertion(tableau, (int)n);
+    }
+
+    ecrivainInit(&sortie, stdout);
+    ecrireEntiers(&sortie, tableau, n);
+    free(tableau);
+    return ecrivainVider(&sortie) == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int taille;
+    Arene arene;
+
+    if (argc > 1) {
+        return trierFichier(argv[1]);
+    }
+
+    // Demander à l'utilisateur de saisir la taille du tableau
+    printf("Entrez la taille du tableau : ");
+    if (scanf("%d", &taille) != 1 || taille <= 0) {
+        printf("Taille invalide\n");
+        return 1;
+    }
+
+    // Le tableau vient d'une arène et non plus de la pile :
+    // sa taille n'est limitée que par la mémoire
+    if (areneCreer(&arene, (size_t)taille * sizeof(int) + ARENE_ALIGNEMENT_SIMD) != 0) {
+        printf("Mémoire insuffisante pour %d éléments\n", taille);
+        return 1;
+    }
+    int *tableau = areneTableau(&arene, int, (size_t)taille);
+
+    // Demander à l'utilisateur de saisir les éléments du tableau
+    printf("Entrez les %d éléments du tableau :\n", taille);
+    for (int i = 0; i < taille; i++) {
+        printf("Element %d : ", i + 1);
+        scanf("%d", &tableau[i]);
+    }
+
+    printf("Tableau avant le tri par insertion :\n");
+    for (int i = 0; i < taille; i++) {
+        printf("%d ", tableau[i]);
+    }
+    printf("\n");
+
+    triInsertion(tableau, taille);
+
+    printf("Tableau après le tri par insertion :\n");
+    for (int i = 0; i < taille; i++) {
+        printf("%d ", tableau[i]);
+    }
+    printf("\n");
+
+    areneDetruire(&arene);
+    return 0;
+}
@@ -1,19 +1,62 @@
-#include <stdio.h>
-#include "fonctions.h"
-
-int main() {
-    int a, b;
-
-    // Demander à l'utilisateur d'entrer les deux nombres
-    printf("Entrez le premier nombre : ");
-    scanf("%d", &a);
-
-    printf("Entrez le deuxième nombre : ");
-    scanf("%d", &b);
-
-    printf("Somme : %d\n", somme(a, b));
-    printf("Comparaison : %d\n", comparaison(a, b));
-    printf("Multiplication : %d\n", multiplication(a, b));
-
-    return 0;
-}
+#include <stdio.h>
+#include "flux.h"
+#include "fonctions.h"
+
+// Couples lus et calculés par blocs de cette taille
+#define COUPLES_PAR_BLOC 4096
+
+static EcrivainEntiers sortie;
+
+// Un bloc de couples a b : une ligne "somme comparaison multiplication" par couple
+static int calculerBloc(const int *valeurs, size_t nb, void *contexte) {
+    static int a[COUPLES_PAR_BLOC], b[COUPLES_PAR_BLOC];
+    static int sommes[COUPLES_PAR_BLOC], comparaisons[COUPLES_PAR_BLOC], produits[COUPLES_PAR_BLOC];
+    size_t couples = nb / 2;
+
+    (void)contexte;
+    for (size_t i = 0; i < couples; i++) {
+        a[i] = valeurs[2 * i];
+        b[i] = valeurs[2 * i + 1];
+    }
+    somme_n(a, b, sommes, couples);
+    comparaison_n(a, b, comparaisons, couples);
+    multiplication_n(a, b, produits, couples);
+    for (size_t i = 0; i < couples; i++) {
+        ecrireEntier(&sortie, sommes[i], ' ');
+        ecrireEntier(&sortie, comparaisons[i], ' ');
+        ecrireEntier(&sortie, produits[i], '\n');
+    }
+    return 0;
+}
+
+// Mode non interactif : main fichier (ou - pour l'entrée standard)
+// Le fichier contient des couples a b ; pour chacun, écrit une ligne
+// "somme comparaison multiplication" (somme et produit modulo 2^32).
+static int calculerFichier(const char *chemin) {
+    static int valeurs[2 * COUPLES_PAR_BLOC];
+
+    ecrivainInit(&sortie, stdout);
+    int statut = traiterFichierParBlocs(chemin, valeurs, 2 * COUPLES_PAR_BLOC, 2, calculerBloc, NULL);
+    return ecrivainVider(&sortie) == 0 && statut == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int a, b;
+
+    if (argc > 1) {
+        return calculerFichier(argv[1]);
+    }
+
+    // Demander à l'utilisateur d'entrer les deux nombres
+    printf("Entrez le premier nombre : ");
+    scanf("%d", &a);
+
+    printf("Entrez le deuxième nombre : ");
+    scanf("%d", &b);
+
+    printf("Somme : %d\n", somme(a, b));
+    printf("Comparaison : %d\n", comparaison(a, b));
+    printf("Multiplication : %d\n", multiplication(a, b));
+
+    return 0;
+}
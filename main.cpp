@@ -1,21 +1,21 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            Seance 2
-            exercice 1
------------------------------------*/
-
-#include <iostream>
-#include <string>
-
-using namespace std;
-
-        
-
-int main() {
-    int x= 10;
-    printf("hello world %d, %d",x,x);
-    return 0;
-    }
-    
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            Seance 2
+            exercice 1
+-----------------------------------*/
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+        
+
+int main() {
+    int x= 10;
+    printf("hello world %d, %d",x,x);
+    return 0;
+    }
+    
@@ -1,30 +1,103 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-           Recherche
-            
------------------------------------*/
-#include <stdio.h>
-
-int main() {
-    int i, b;
-    int tab[10] = {2, 7, 5, 9, 6, 4, 0, 1, 3, 8};
-
-    printf("Nombre recherché : ");
-    scanf("%d", &b);
-
-    // Parcourir le tableau pour rechercher le nombre
-    for (i = 0; i < 10; i++) {
-        if (b == tab[i]) {
-            printf("Le nombre %d est dans la liste.\n", b);
-            printf("Il est à la position : %d\n", i);
-            return 0; // Quittez le programme si le nombre est trouvé
-        }
-    }
-
-    // Si le nombre n'a pas été trouvé, afficher un message approprié
-    printf("Le nombre %d n'est pas dans la liste.\n", b);
-
-    return 0;
-}
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+           Recherche
+            
+-----------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "flux.h"
+#include "index_hachage.h"
+#include "recherche.h"
+
+// Requêtes lues et traitées par blocs de cette taille
+#define REQUETES_PAR_BLOC 4096
+
+static EcrivainEntiers sortie;
+
+// La table, et son index une fois que les requêtes ont dépassé le seuil
+typedef struct {
+    const int *tab;
+    size_t n;
+    size_t nbRequetes;
+    IndexHachage index;
+    int indexe;
+} Recherche;
+
+static int rechercherBloc(const int *cles, size_t nb, void *contexte) {
+    Recherche *recherche = contexte;
+    long resultats[REQUETES_PAR_BLOC];
+    size_t k = 0;
+
+    for (; k < nb && !recherche->indexe; k++, recherche->nbRequetes++) {
+        // Sans mémoire pour l'index, on continue par parcours
+        if (recherche->nbRequetes == INDEX_SEUIL_REQUETES &&
+            indexCreer(&recherche->index, recherche->tab, recherche->n) == 0) {
+            recherche->indexe = 1;
+            break;
+        }
+        ecrireEntier(&sortie, rechercher(recherche->tab, recherche->n, cles[k]), '\n');
+    }
+    if (recherche->indexe) {
+        indexRechercheLot(&recherche->index, cles + k, nb - k, resultats);
+        for (size_t r = 0; r < nb - k; r++) {
+            ecrireEntier(&sortie, resultats[r], '\n');
+        }
+    }
+    return 0;
+}
+
+// Mode non interactif : recherche requetes [table]
+// (requetes ou table valent - pour l'entrée standard)
+// Écrit pour chaque nombre de requetes sa position dans la table, -1 s'il
+// n'y est pas, un résultat par ligne. Sans fichier table, la table est tab.
+// Les INDEX_SEUIL_REQUETES premières requêtes parcourent la table ; s'il y
+// en a plus, la table est indexée par hachage et les suivantes sont en O(1).
+static int rechercherFichier(const char *cheminRequetes, const char *cheminTable,
+                             const int *tabDefaut, size_t nDefaut) {
+    int *table = NULL;
+    int cles[REQUETES_PAR_BLOC];
+    Recherche recherche = {tabDefaut, nDefaut, 0, {0}, 0};
+
+    if (cheminTable != NULL) {
+        table = lireFichierEntiers(cheminTable, &recherche.n);
+        if (table == NULL) {
+            return 1;
+        }
+        recherche.tab = table;
+    }
+
+    ecrivainInit(&sortie, stdout);
+    int statut = traiterFichierParBlocs(cheminRequetes, cles, REQUETES_PAR_BLOC, 1, rechercherBloc, &recherche);
+    if (recherche.indexe) {
+        indexLiberer(&recherche.index);
+    }
+    free(table);
+    return ecrivainVider(&sortie) == 0 && statut == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+    int b;
+    int tab[10] = {2, 7, 5, 9, 6, 4, 0, 1, 3, 8};
+
+    if (argc > 1) {
+        return rechercherFichier(argv[1], argc > 2 ? argv[2] : NULL, tab, sizeof(tab) / sizeof(tab[0]));
+    }
+
+    printf("Nombre recherché : ");
+    scanf("%d", &b);
+
+    // Parcourir le tableau pour rechercher le nombre
+    long position = rechercher(tab, sizeof(tab) / sizeof(tab[0]), b);
+    if (position >= 0) {
+        printf("Le nombre %d est dans la liste.\n", b);
+        printf("Il est à la position : %ld\n", position);
+        return 0; // Quittez le programme si le nombre est trouvé
+    }
+
+    // Si le nombre n'a pas été trouvé, afficher un message approprié
+    printf("Le nombre %d n'est pas dans la liste.\n", b);
+
+    return 0;
+}
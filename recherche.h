@@ -0,0 +1,27 @@
+// Recherche linéaire dans un tableau non trié
+// Version vectorisée (SSE2 / AVX2 / NEON) choisie à l'exécution,
+// avec repli sur la version scalaire si le processeur ne les a pas.
+
+#ifndef RECHERCHE_H
+#define RECHERCHE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Position de la première occurrence de valeur dans tab[0..n-1], -1 si absente
+long rechercher(const int *tab, size_t n, int valeur);
+
+// Même résultat, un élément à la fois (référence pour les benchmarks)
+long rechercherScalaire(const int *tab, size_t n, int valeur);
+
+// Nom du noyau utilisé par rechercher : "avx2", "sse2", "neon" ou "scalaire"
+const char *rechercherImplementation(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
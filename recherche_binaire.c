@@ -0,0 +1,158 @@
+#include <stdlib.h>
+#include "recherche_binaire.h"
+
+// Nombre de clés traitées ensemble par les recherches en lot : assez pour
+// masquer la latence mémoire, assez peu pour rester dans les registres / L1
+#define TAILLE_LOT 16
+
+// Recherche binaire sans branchement : la comparaison devient un déplacement
+// conditionnel (cmov), le nombre de tours ne dépend que de n
+size_t borneInferieure(const int *tab, size_t n, int valeur) {
+    if (n == 0) {
+        return 0;
+    }
+    const int *base = tab;
+    while (n > 1) {
+        size_t moitie = n / 2;
+        base = (base[moitie] < valeur) ? base + moitie : base;
+        n -= moitie;
+    }
+    return (size_t)(base - tab) + (*base < valeur);
+}
+
+long rechercheBinaire(const int *tab, size_t n, int valeur) {
+    size_t i = borneInferieure(tab, n, valeur);
+    return (i < n && tab[i] == valeur) ? (long)i : -1;
+}
+
+void rechercheLot(const int *tab, size_t n, const int *cles, size_t nbCles, long *resultats) {
+    const int *base[TAILLE_LOT];
+
+    if (n == 0) {
+        for (size_t k = 0; k < nbCles; k++) resultats[k] = -1;
+        return;
+    }
+
+    for (size_t debut = 0; debut < nbCles; debut += TAILLE_LOT) {
+        size_t nb = nbCles - debut < TAILLE_LOT ? nbCles - debut : TAILLE_LOT;
+        const int *c = cles + debut;
+
+        for (size_t j = 0; j < nb; j++) {
+            base[j] = tab;
+        }
+
+        // Toutes les clés avancent d'un niveau à chaque tour : leurs lectures
+        // sont indépendantes et le processeur peut les lancer en parallèle
+        size_t longueur = n;
+        while (longueur > 1) {
+            size_t moitie = longueur / 2;
+            size_t suivante = (longueur - moitie) / 2;
+            for (size_t j = 0; j < nb; j++) {
+                base[j] = (base[j][moitie] < c[j]) ? base[j] + moitie : base[j];
+                __builtin_prefetch(base[j] + suivante);
+            }
+            longueur -= moitie;
+        }
+
+        for (size_t j = 0; j < nb; j++) {
+            size_t i = (size_t)(base[j] - tab) + (*base[j] < c[j]);
+            resultats[debut + j] = (i < n && tab[i] == c[j]) ? (long)i : -1;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+// Disposition d'Eytzinger : le fils gauche de k est 2k, le fils droit 2k + 1.
+// Les premiers niveaux tiennent dans quelques lignes de cache, et les
+// 16 descendants de k à quatre niveaux (16k .. 16k + 15) sont contigus :
+// on les précharge pendant que les niveaux intermédiaires sont comparés.
+
+// Remplissage par parcours infixe : le i-ème élément trié va au i-ème nœud visité
+static size_t remplir(TableEytzinger *table, const int *trie, size_t i, size_t k) {
+    if (k <= table->n) {
+        i = remplir(table, trie, i, 2 * k);
+        table->cles[k] = trie[i];
+        table->rangs[k] = (unsigned)i;
+        i = remplir(table, trie, i + 1, 2 * k + 1);
+    }
+    return i;
+}
+
+int eytzingerCreer(TableEytzinger *table, const int *trie, size_t n) {
+    // Alignée sur 64 octets pour que cles[16k .. 16k + 15] soit une seule ligne
+    size_t octets = ((n + 1) * sizeof(int) + 63) / 64 * 64;
+    table->cles = aligned_alloc(64, octets);
+    table->rangs = malloc((n + 1) * sizeof(unsigned));
+    table->n = n;
+    if (table->cles == NULL || table->rangs == NULL) {
+        eytzingerLiberer(table);
+        return -1;
+    }
+    table->cles[0] = 0;
+    table->rangs[0] = (unsigned)n;  // nœud 0 : aucune clé >= valeur
+    remplir(table, trie, 0, 1);
+    return 0;
+}
+
+void eytzingerLiberer(TableEytzinger *table) {
+    free(table->cles);
+    free(table->rangs);
+    table->cles = NULL;
+    table->rangs = NULL;
+    table->n = 0;
+}
+
+// Nœud de la borne inférieure (0 si toutes les clés sont < valeur)
+static size_t eytzingerNoeud(const TableEytzinger *table, int valeur) {
+    const int *cles = table->cles;
+    size_t k = 1;
+    while (k <= table->n) {
+        __builtin_prefetch(cles + 16 * k);
+        k = 2 * k + (cles[k] < valeur);
+    }
+    // On remonte tant qu'on est descendu à droite, puis d'un cran de plus :
+    // on arrive sur le dernier ancêtre où l'on est parti à gauche
+    return k >> __builtin_ffsll(~(long long)k);
+}
+
+size_t eytzingerBorneInferieure(const TableEytzinger *table, int valeur) {
+    return table->rangs[eytzingerNoeud(table, valeur)];
+}
+
+long eytzingerRechercher(const TableEytzinger *table, int valeur) {
+    size_t k = eytzingerNoeud(table, valeur);
+    return (k != 0 && table->cles[k] == valeur) ? (long)table->rangs[k] : -1;
+}
+
+void eytzingerRechercheLot(const TableEytzinger *table, const int *cles, size_t nbCles, long *resultats) {
+    const int *arbre = table->cles;
+    const size_t n = table->n;
+    size_t k[TAILLE_LOT];
+
+    for (size_t debut = 0; debut < nbCles; debut += TAILLE_LOT) {
+        size_t nb = nbCles - debut < TAILLE_LOT ? nbCles - debut : TAILLE_LOT;
+        const int *c = cles + debut;
+        int actives = (int)nb;
+
+        for (size_t j = 0; j < nb; j++) {
+            k[j] = 1;
+        }
+        // Les chemins ne diffèrent en longueur que d'un niveau au plus :
+        // le test k <= n est presque toujours vrai et bien prédit
+        while (actives > 0) {
+            actives = 0;
+            for (size_t j = 0; j < nb; j++) {
+                if (k[j] <= n) {
+                    __builtin_prefetch(arbre + 16 * k[j]);
+                    k[j] = 2 * k[j] + (arbre[k[j]] < c[j]);
+                    actives++;
+                }
+            }
+        }
+
+        for (size_t j = 0; j < nb; j++) {
+            size_t noeud = k[j] >> __builtin_ffsll(~(long long)k[j]);
+            resultats[debut + j] = (noeud != 0 && arbre[noeud] == c[j]) ? (long)table->rangs[noeud] : -1;
+        }
+    }
+}
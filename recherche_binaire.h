@@ -0,0 +1,46 @@
+// Recherche dans un tableau trié
+// - borneInferieure : recherche binaire sans branchement
+// - TableEytzinger : même table rangée en ordre de parcours en largeur,
+//   plus favorable au cache, avec préchargement des niveaux suivants
+// - rechercheLot / eytzingerRechercheLot : beaucoup de clés à la fois,
+//   les accès mémoire des différentes clés se recouvrent
+
+#ifndef RECHERCHE_BINAIRE_H
+#define RECHERCHE_BINAIRE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Premier indice i tel que tab[i] >= valeur (n si aucun)
+size_t borneInferieure(const int *tab, size_t n, int valeur);
+
+// Position de valeur dans tab trié, -1 si absente
+long rechercheBinaire(const int *tab, size_t n, int valeur);
+
+// resultats[k] = rechercheBinaire(tab, n, cles[k]) pour k < nbCles
+void rechercheLot(const int *tab, size_t n, const int *cles, size_t nbCles, long *resultats);
+
+// Table en disposition d'Eytzinger (tas implicite, indices à partir de 1)
+typedef struct {
+    int *cles;          // cles[1..n] en ordre de parcours en largeur
+    unsigned *rangs;    // rangs[k] = position de cles[k] dans le tableau trié
+    size_t n;
+} TableEytzinger;
+
+// Construit la table à partir d'un tableau trié ; 0 si succès, -1 si plus de mémoire
+int eytzingerCreer(TableEytzinger *table, const int *trie, size_t n);
+void eytzingerLiberer(TableEytzinger *table);
+
+// Mêmes résultats que borneInferieure / rechercheBinaire sur le tableau trié d'origine
+size_t eytzingerBorneInferieure(const TableEytzinger *table, int valeur);
+long eytzingerRechercher(const TableEytzinger *table, int valeur);
+void eytzingerRechercheLot(const TableEytzinger *table, const int *cles, size_t nbCles, long *resultats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
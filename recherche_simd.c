@@ -0,0 +1,174 @@
+#include "recherche.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RECHERCHE_X86 1
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#include <arm_neon.h>
+#define RECHERCHE_NEON 1
+#if defined(__linux__) && !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+typedef long (*NoyauRecherche)(const int *tab, size_t n, int valeur);
+
+// Version scalaire : une comparaison par élément
+long rechercherScalaire(const int *tab, size_t n, int valeur) {
+    for (size_t i = 0; i < n; i++) {
+        if (tab[i] == valeur) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+#ifdef RECHERCHE_X86
+
+// SSE2 : 4 entiers par comparaison, 16 par tour de boucle.
+// Les quatre masques sont combinés pour n'avoir qu'un seul branchement par tour,
+// la position exacte n'est cherchée qu'une fois la correspondance trouvée.
+__attribute__((target("sse2")))
+static long rechercherSSE2(const int *tab, size_t n, int valeur) {
+    const __m128i cle = _mm_set1_epi32(valeur);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(tab + i)), cle);
+        __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(tab + i + 4)), cle);
+        __m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(tab + i + 8)), cle);
+        __m128i c3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(tab + i + 12)), cle);
+        __m128i tout = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+        if (_mm_movemask_epi8(tout) != 0) {
+            // Un bit par élément, dans l'ordre du tableau
+            unsigned masque = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c0))
+                            | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c1)) << 4
+                            | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c2)) << 8
+                            | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c3)) << 12;
+            return (long)(i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        __m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(tab + i)), cle);
+        unsigned masque = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c));
+        if (masque != 0) {
+            return (long)(i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    long reste = rechercherScalaire(tab + i, n - i, valeur);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+// AVX2 : 8 entiers par comparaison, 32 par tour de boucle
+__attribute__((target("avx2")))
+static long rechercherAVX2(const int *tab, size_t n, int valeur) {
+    const __m256i cle = _mm256_set1_epi32(valeur);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        __m256i c0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(tab + i)), cle);
+        __m256i c1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(tab + i + 8)), cle);
+        __m256i c2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(tab + i + 16)), cle);
+        __m256i c3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(tab + i + 24)), cle);
+        __m256i tout = _mm256_or_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c2, c3));
+        if (!_mm256_testz_si256(tout, tout)) {
+            unsigned masque = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c0))
+                            | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c1)) << 8
+                            | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c2)) << 16
+                            | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c3)) << 24;
+            return (long)(i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(tab + i)), cle);
+        unsigned masque = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c));
+        if (masque != 0) {
+            return (long)(i + (size_t)__builtin_ctz(masque));
+        }
+    }
+    long reste = rechercherScalaire(tab + i, n - i, valeur);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+#endif
+
+#ifdef RECHERCHE_NEON
+
+// NEON : il n'y a pas de movemask, on réduit le masque 4 x 32 bits
+// en 4 x 16 bits (vshrn) puis on lit les 64 bits comme un entier :
+// chaque élément occupe 16 bits, la position vient du ctz / 16.
+static long rechercherNEON(const int *tab, size_t n, int valeur) {
+    const int32x4_t cle = vdupq_n_s32(valeur);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        uint32x4_t c0 = vceqq_s32(vld1q_s32(tab + i), cle);
+        uint32x4_t c1 = vceqq_s32(vld1q_s32(tab + i + 4), cle);
+        uint32x4_t c2 = vceqq_s32(vld1q_s32(tab + i + 8), cle);
+        uint32x4_t c3 = vceqq_s32(vld1q_s32(tab + i + 12), cle);
+        uint32x4_t tout = vorrq_u32(vorrq_u32(c0, c1), vorrq_u32(c2, c3));
+        uint64x2_t t64 = vreinterpretq_u64_u32(tout);
+        if ((vgetq_lane_u64(t64, 0) | vgetq_lane_u64(t64, 1)) != 0) {
+            uint32x4_t blocs[4] = {c0, c1, c2, c3};
+            for (int b = 0; b < 4; b++) {
+                uint64_t masque = vget_lane_u64(vreinterpret_u64_u16(vshrn_n_u32(blocs[b], 16)), 0);
+                if (masque != 0) {
+                    return (long)(i + 4 * (size_t)b + (size_t)(__builtin_ctzll(masque) / 16));
+                }
+            }
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t c = vceqq_s32(vld1q_s32(tab + i), cle);
+        uint64_t masque = vget_lane_u64(vreinterpret_u64_u16(vshrn_n_u32(c, 16)), 0);
+        if (masque != 0) {
+            return (long)(i + (size_t)(__builtin_ctzll(masque) / 16));
+        }
+    }
+    long reste = rechercherScalaire(tab + i, n - i, valeur);
+    return reste < 0 ? -1 : (long)i + reste;
+}
+
+#endif
+
+// Choix du noyau selon les instructions disponibles sur la machine
+static NoyauRecherche noyau = NULL;
+static const char *nomNoyau = "scalaire";
+
+static void choisirNoyau(void) {
+    NoyauRecherche choix = rechercherScalaire;
+#ifdef RECHERCHE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        choix = rechercherAVX2;
+        nomNoyau = "avx2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        choix = rechercherSSE2;
+        nomNoyau = "sse2";
+    }
+#elif defined(RECHERCHE_NEON)
+#if defined(__linux__) && !defined(__aarch64__)
+    if (getauxval(AT_HWCAP) & HWCAP_NEON)
+#endif
+    {
+        choix = rechercherNEON;
+        nomNoyau = "neon";
+    }
+#endif
+    noyau = choix;
+}
+
+long rechercher(const int *tab, size_t n, int valeur) {
+    if (noyau == NULL) {
+        choisirNoyau();
+    }
+    return noyau(tab, n, valeur);
+}
+
+const char *rechercherImplementation(void) {
+    if (noyau == NULL) {
+        choisirNoyau();
+    }
+    return nomNoyau;
+}
@@ -0,0 +1,221 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "table_triee.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define TABLE_MMAP 1
+#endif
+
+_Static_assert(sizeof(EnteteTable) == TABLE_ALIGNEMENT, "l'en-tête occupe exactement 64 octets");
+
+static size_t arrondir(size_t octets) {
+    return (octets + TABLE_ALIGNEMENT - 1) / TABLE_ALIGNEMENT * TABLE_ALIGNEMENT;
+}
+
+size_t tableTailleImage(size_t n, uint32_t options) {
+    // Rangs sur 32 bits, et pas de débordement des tailles ci-dessous
+    if (n >= UINT32_MAX || n > (SIZE_MAX - 4 * TABLE_ALIGNEMENT) / (3 * sizeof(int))) {
+        return 0;
+    }
+    size_t taille = sizeof(EnteteTable) + arrondir(n * sizeof(int));
+    if (options & TABLE_EYTZINGER) {
+        taille += arrondir((n + 1) * sizeof(int)) + arrondir((n + 1) * sizeof(unsigned));
+    }
+    return taille;
+}
+
+int tableConstruireImage(void *image, size_t taille, const int *valeurs, size_t n, uint32_t options) {
+    size_t besoin = tableTailleImage(n, options);
+    if (besoin == 0 || taille < besoin) {
+        return -1;
+    }
+
+    int triee = 1;
+    for (size_t i = 1; i < n && triee; i++) {
+        triee = valeurs[i - 1] <= valeurs[i];
+    }
+    if ((options & TABLE_EYTZINGER) && !triee) {
+        return -1;
+    }
+
+    unsigned char *octets = image;
+    EnteteTable *entete = image;
+    memset(image, 0, besoin);
+    entete->magique = TABLE_MAGIQUE;
+    entete->version = TABLE_VERSION;
+    entete->largeur = sizeof(int);
+    entete->drapeaux = (triee ? TABLE_TRIEE : 0) | (options & TABLE_EYTZINGER);
+    entete->nombre = n;
+    entete->decalageValeurs = sizeof(EnteteTable);
+    entete->taille = besoin;
+    if (n > 0) {
+        memcpy(octets + entete->decalageValeurs, valeurs, n * sizeof(int));
+    }
+
+    if (options & TABLE_EYTZINGER) {
+        TableEytzinger eytzinger;
+        if (eytzingerCreer(&eytzinger, valeurs, n) != 0) {
+            return -1;
+        }
+        entete->decalageEytzinger = entete->decalageValeurs + arrondir(n * sizeof(int));
+        entete->decalageRangs = entete->decalageEytzinger + arrondir((n + 1) * sizeof(int));
+        memcpy(octets + entete->decalageEytzinger, eytzinger.cles, (n + 1) * sizeof(int));
+        memcpy(octets + entete->decalageRangs, eytzinger.rangs, (n + 1) * sizeof(unsigned));
+        eytzingerLiberer(&eytzinger);
+    }
+    return 0;
+}
+
+int tableEcrire(const char *chemin, const int *valeurs, size_t n, uint32_t options) {
+    size_t taille = tableTailleImage(n, options);
+    void *image = taille != 0 ? malloc(taille) : NULL;
+    if (image == NULL || tableConstruireImage(image, taille, valeurs, n, options) != 0) {
+        free(image);
+        return -1;
+    }
+
+    FILE *fichier = fopen(chemin, "wb");
+    int statut = -1;
+    if (fichier != NULL) {
+        statut = fwrite(image, 1, taille, fichier) == taille ? 0 : -1;
+        if (fclose(fichier) != 0) {
+            statut = -1;
+        }
+    }
+    free(image);
+    return statut;
+}
+
+// nb éléments de 4 octets à decalage, entièrement dans l'image et après l'en-tête
+static int sectionValide(const EnteteTable *entete, uint64_t decalage, uint64_t nb) {
+    return decalage >= sizeof(EnteteTable) && decalage % sizeof(int) == 0 &&
+           decalage <= entete->taille && nb <= (entete->taille - decalage) / sizeof(int);
+}
+
+int tableDepuisMemoire(TableTriee *table, const void *image, size_t taille) {
+    const EnteteTable *entete = image;
+    memset(table, 0, sizeof(*table));
+
+    if (image == NULL || taille < sizeof(entete->magique) || entete->magique != TABLE_MAGIQUE) {
+        return -2;
+    }
+    if (taille < sizeof(EnteteTable) || (uintptr_t)image % sizeof(uint64_t) != 0 ||
+        entete->version != TABLE_VERSION || entete->largeur != sizeof(int) || entete->taille > taille ||
+        !sectionValide(entete, entete->decalageValeurs, entete->nombre)) {
+        return -3;
+    }
+    if ((entete->drapeaux & TABLE_EYTZINGER) &&
+        (!(entete->drapeaux & TABLE_TRIEE) || entete->nombre >= UINT32_MAX ||
+         !sectionValide(entete, entete->decalageEytzinger, entete->nombre + 1) ||
+         !sectionValide(entete, entete->decalageRangs, entete->nombre + 1))) {
+        return -3;
+    }
+
+    const unsigned char *octets = image;
+    table->valeurs = (const int *)(octets + entete->decalageValeurs);
+    table->n = (size_t)entete->nombre;
+    table->drapeaux = entete->drapeaux;
+    if (entete->drapeaux & TABLE_EYTZINGER) {
+        // L'image est en lecture seule : les fonctions eytzinger* ne font que lire la table
+        table->eytzinger.cles = (int *)(octets + entete->decalageEytzinger);
+        table->eytzinger.rangs = (unsigned *)(octets + entete->decalageRangs);
+        table->eytzinger.n = table->n;
+    }
+    return 0;
+}
+
+int tableOuvrir(TableTriee *table, const char *chemin) {
+    memset(table, 0, sizeof(*table));
+    FILE *fichier = fopen(chemin, "rb");
+    if (fichier == NULL) {
+        return -1;
+    }
+
+#ifdef TABLE_MMAP
+    struct stat etat;
+    if (fstat(fileno(fichier), &etat) != 0) {
+        fclose(fichier);
+        return -1;
+    }
+    // Un tube ou un terminal ne contient pas de table
+    if (!S_ISREG(etat.st_mode)) {
+        fclose(fichier);
+        return -2;
+    }
+    if (etat.st_size == 0 || (uintmax_t)etat.st_size > SIZE_MAX) {
+        fclose(fichier);
+        return -2;
+    }
+    size_t taille = (size_t)etat.st_size;
+    void *projection = mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fileno(fichier), 0);
+    fclose(fichier);                       // la projection reste valide
+    if (projection == MAP_FAILED) {
+        return -1;
+    }
+    // Accès de recherche : une page à la fois, sans lecture anticipée
+    posix_madvise(projection, taille, POSIX_MADV_RANDOM);
+#else
+    // Sans mmap, le fichier est lu en entier
+    long fin = fseek(fichier, 0, SEEK_END) == 0 ? ftell(fichier) : -1;
+    if (fin < 0 || fseek(fichier, 0, SEEK_SET) != 0) {
+        fclose(fichier);
+        return -1;
+    }
+    size_t taille = (size_t)fin;
+    void *projection = malloc(taille > 0 ? taille : 1);
+    if (projection == NULL || fread(projection, 1, taille, fichier) != taille) {
+        free(projection);
+        fclose(fichier);
+        return -1;
+    }
+    fclose(fichier);
+#endif
+
+    int statut = tableDepuisMemoire(table, projection, taille);
+    if (statut != 0) {
+#ifdef TABLE_MMAP
+        munmap(projection, taille);
+#else
+        free(projection);
+#endif
+        return statut;
+    }
+    table->projection = projection;
+    table->tailleProjection = taille;
+    return 0;
+}
+
+void tableFermer(TableTriee *table) {
+    if (table->projection != NULL) {
+#ifdef TABLE_MMAP
+        munmap(table->projection, table->tailleProjection);
+#else
+        free(table->projection);
+#endif
+    }
+    memset(table, 0, sizeof(*table));
+}
+
+long tableRechercher(const TableTriee *table, int valeur) {
+    if (!(table->drapeaux & TABLE_TRIEE)) {
+        return -1;
+    }
+    if (table->drapeaux & TABLE_EYTZINGER) {
+        return eytzingerRechercher(&table->eytzinger, valeur);
+    }
+    return rechercheBinaire(table->valeurs, table->n, valeur);
+}
+
+void tableRechercheLot(const TableTriee *table, const int *cles, size_t nbCles, long *resultats) {
+    if (!(table->drapeaux & TABLE_TRIEE)) {
+        for (size_t k = 0; k < nbCles; k++) resultats[k] = -1;
+    } else if (table->drapeaux & TABLE_EYTZINGER) {
+        eytzingerRechercheLot(&table->eytzinger, cles, nbCles, resultats);
+    } else {
+        rechercheLot(table->valeurs, table->n, cles, nbCles, resultats);
+    }
+}
@@ -0,0 +1,89 @@
+// Tables triées sur disque, chargées sans copie
+// Un fichier table commence par un en-tête de 64 octets (EnteteTable), suivi
+// des valeurs triées et, en option, de la même table en disposition
+// d'Eytzinger (clés puis rangs, comme TableEytzinger). Chaque section est
+// alignée sur 64 octets. tableOuvrir projette le fichier en mémoire (mmap) :
+// les recherches lisent directement les pages du fichier, chargées à la
+// demande au premier accès, sans analyse ni tri au démarrage.
+// Les champs sont dans le boutisme de la machine qui écrit la table
+// (petit-boutiste sur x86 et ARM) ; un fichier de l'autre boutisme est
+// refusé (nombre magique inversé).
+//
+// Les valeurs ne sont pas relues à l'ouverture : le drapeau TABLE_TRIEE est
+// posé par tableEcrire après vérification, et fait foi ensuite.
+
+#ifndef TABLE_TRIEE_H
+#define TABLE_TRIEE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "recherche_binaire.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TABLE_MAGIQUE    0x49525454u    // "TTRI"
+#define TABLE_VERSION    1
+#define TABLE_ALIGNEMENT 64
+
+// Drapeaux de l'en-tête (et options de tableEcrire / tableConstruireImage)
+#define TABLE_TRIEE      0x1u           // valeurs dans l'ordre croissant
+#define TABLE_EYTZINGER  0x2u           // section Eytzinger présente
+
+typedef struct {
+    uint32_t magique;                   // TABLE_MAGIQUE
+    uint16_t version;                   // TABLE_VERSION
+    uint16_t largeur;                   // octets par élément : 4 (int32)
+    uint32_t drapeaux;
+    uint32_t reserve;
+    uint64_t nombre;                    // nombre d'éléments n
+    uint64_t decalageValeurs;           // valeurs[0..n-1]
+    uint64_t decalageEytzinger;         // cles[0..n], 0 sans TABLE_EYTZINGER
+    uint64_t decalageRangs;             // rangs[0..n], 0 sans TABLE_EYTZINGER
+    uint64_t taille;                    // taille totale de l'image
+    uint8_t remplissage[8];
+} EnteteTable;
+
+typedef struct {
+    const int *valeurs;
+    size_t n;
+    uint32_t drapeaux;
+    TableEytzinger eytzinger;           // vue sur l'image (ne pas passer à eytzingerLiberer)
+    void *projection;                   // zone mmap (ou bloc malloc) de tableOuvrir,
+    size_t tailleProjection;            // NULL pour tableDepuisMemoire
+} TableTriee;
+
+// Taille de l'image d'une table de n valeurs (0 si n est trop grand)
+size_t tableTailleImage(size_t n, uint32_t options);
+
+// Écrit dans image (tableTailleImage octets, alignée sur 8 au moins) la table de
+// valeurs[0..n-1]. options : 0 ou TABLE_EYTZINGER. Les valeurs doivent être
+// triées pour TABLE_EYTZINGER ; sinon la table est écrite sans TABLE_TRIEE.
+// Retourne 0, ou -1 (taille, ordre ou mémoire).
+int tableConstruireImage(void *image, size_t taille, const int *valeurs, size_t n, uint32_t options);
+
+// Même chose dans un fichier ; retourne 0, ou -1
+int tableEcrire(const char *chemin, const int *valeurs, size_t n, uint32_t options);
+
+// Table sur une image déjà en mémoire (fichier lu, tableau constant en flash...) :
+// l'image n'est pas copiée et doit vivre aussi longtemps que la table.
+// Retourne 0, -2 si ce n'est pas une table (pas de nombre magique), -3 si la
+// table est invalide (tronquée, version ou largeur inconnue...).
+int tableDepuisMemoire(TableTriee *table, const void *image, size_t taille);
+
+// Projette le fichier chemin. Retourne 0, -1 si le fichier ne s'ouvre pas
+// (ou si la mémoire manque), -2 ou -3 comme tableDepuisMemoire.
+int tableOuvrir(TableTriee *table, const char *chemin);
+void tableFermer(TableTriee *table);
+
+// Position de valeur dans la table triée, -1 si absente (ou si la table
+// n'est pas triée). Disposition d'Eytzinger si le fichier l'a.
+long tableRechercher(const TableTriee *table, int valeur);
+void tableRechercheLot(const TableTriee *table, const int *cles, size_t nbCles, long *resultats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
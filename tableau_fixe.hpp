@@ -0,0 +1,171 @@
+// Tri et recherche pour les tableaux de taille connue à la compilation (C++17)
+// Pour les petites tables de taille fixe (int tab[10], la liste de 50 de
+// Task4...), tout est déroulé à la compilation : pas de boucle, pas de
+// branchement dépendant des données, donc pas d'erreur de prédiction.
+//
+// - triFixe(t) : réseau de tri de Batcher (fusion pair-impair), généré à la
+//   compilation pour N <= TRI_FIXE_MAX ; chaque comparateur est un min/max
+//   (cmov), en ligne droite.
+// - rechercheFixe(t, v) : recherche binaire sans branchement de profondeur
+//   fixe ceil(log2(N)) sur un tableau trié.
+// - IndexFixe<N> : table connue à la compilation, triée et indexée à la
+//   compilation (constexpr) ; donne la position dans la table d'origine.
+//
+//     int tab[8] = {...};
+//     triFixe(tab);
+//     long i = rechercheFixe(tab, 42);
+//
+//     constexpr int valeurs[10] = {2, 7, 5, 9, 6, 4, 0, 1, 3, 8};
+//     static constexpr IndexFixe<10> index(valeurs);
+//     static_assert(index.rechercher(9) == 3, "");
+
+#ifndef TABLEAU_FIXE_HPP
+#define TABLEAU_FIXE_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+// Au-delà, le code déroulé (543 comparateurs à 64, soit quelques Kio par
+// taille de tableau) coûte plus en cache d'instructions qu'il ne fait
+// gagner : utiliser triInsertion
+#define TRI_FIXE_MAX 64
+
+// Range a <= b sans branchement
+constexpr void ordonnerPaire(int& a, int& b) {
+    int x = a, y = b;
+    a = x < y ? x : y;
+    b = x < y ? y : x;
+}
+
+// Réseau de tri de Batcher pour N éléments : celui de la puissance de 2
+// supérieure, sans les comparateurs qui touchent un indice >= N (ces cases
+// vaudraient +infini et ne bougeraient jamais)
+template <std::size_t N>
+class ReseauTri {
+    struct Comparateur {
+        std::size_t a, b;
+    };
+
+    template <typename Action>
+    static constexpr void parcourir(Action action) {
+        std::size_t puissance = 1;
+        while (puissance < N) puissance *= 2;
+        for (std::size_t p = 1; p < puissance; p *= 2) {
+            for (std::size_t k = p; k >= 1; k /= 2) {
+                for (std::size_t j = k % p; j + k < puissance; j += 2 * k) {
+                    for (std::size_t i = 0; i < k && i + j + k < puissance; i++) {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < N) {
+                            action(i + j, i + j + k);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static constexpr std::size_t compter() {
+        std::size_t nb = 0;
+        parcourir([&nb](std::size_t, std::size_t) { nb++; });
+        return nb;
+    }
+
+public:
+    static constexpr std::size_t taille = compter();
+
+    static constexpr std::array<Comparateur, taille> generer() {
+        std::array<Comparateur, taille> reseau{};
+        std::size_t nb = 0;
+        parcourir([&reseau, &nb](std::size_t a, std::size_t b) { reseau[nb++] = Comparateur{a, b}; });
+        return reseau;
+    }
+
+    static constexpr std::array<Comparateur, taille> comparateurs = generer();
+
+    template <std::size_t... I>
+    static constexpr void appliquer(int* t, std::index_sequence<I...>) {
+        static_cast<void>(t);           // N = 1 : aucun comparateur
+        (ordonnerPaire(t[comparateurs[I].a], t[comparateurs[I].b]), ...);
+    }
+};
+
+template <std::size_t N>
+constexpr void triFixe(int (&t)[N]) {
+    static_assert(N <= TRI_FIXE_MAX, "tableau trop grand pour un réseau de tri : triInsertion");
+    ReseauTri<N>::appliquer(t, std::make_index_sequence<ReseauTri<N>::taille>{});
+}
+
+template <std::size_t N>
+constexpr void triFixe(std::array<int, N>& t) {
+    static_assert(N <= TRI_FIXE_MAX, "tableau trop grand pour un réseau de tri : triInsertion");
+    ReseauTri<N>::appliquer(t.data(), std::make_index_sequence<ReseauTri<N>::taille>{});
+}
+
+// Une étape par moitié : N est connu, la profondeur aussi, et le compilateur
+// ne garde qu'une suite de comparaisons et de cmov
+template <std::size_t N, typename T>
+constexpr const T* descendreFixe(const T* base, int valeur) {
+    if constexpr (N > 1) {
+        constexpr std::size_t moitie = N / 2;
+        base += base[moitie - 1] < valeur ? moitie : 0;
+        return descendreFixe<N - moitie>(base, valeur);
+    } else {
+        return base;
+    }
+}
+
+// Premier indice i tel que t[i] >= valeur (N si aucun), t trié
+template <std::size_t N>
+constexpr std::size_t borneInferieureFixe(const int (&t)[N], int valeur) {
+    if constexpr (N == 0) {
+        return 0;
+    } else {
+        const int* base = descendreFixe<N>(t, valeur);
+        return static_cast<std::size_t>(base - t) + (*base < valeur);
+    }
+}
+
+// Position de valeur dans t trié, -1 si absente
+template <std::size_t N>
+constexpr long rechercheFixe(const int (&t)[N], int valeur) {
+    std::size_t i = borneInferieureFixe(t, valeur);
+    return i < N && t[i] == valeur ? static_cast<long>(i) : -1;
+}
+
+// Table de N valeurs connues à la compilation, dans un ordre quelconque et
+// avec d'éventuels doublons : rechercher donne la première position de la
+// valeur dans la table d'origine, comme rechercher() de recherche.h, en
+// ceil(log2(N)) étapes sans branchement
+template <std::size_t N>
+class IndexFixe {
+    static_assert(N > 0, "table vide");
+    int cles[N] = {};
+    long positions[N] = {};
+
+public:
+    // Tri par insertion stable des couples (valeur, position), fait à la
+    // compilation : les doublons gardent leur première position en tête
+    constexpr explicit IndexFixe(const int (&valeurs)[N]) {
+        for (std::size_t i = 0; i < N; i++) {
+            std::size_t j = i;
+            while (j > 0 && cles[j - 1] > valeurs[i]) {
+                cles[j] = cles[j - 1];
+                positions[j] = positions[j - 1];
+                j--;
+            }
+            cles[j] = valeurs[i];
+            positions[j] = static_cast<long>(i);
+        }
+    }
+
+    constexpr long rechercher(int valeur) const {
+        std::size_t i = borneInferieureFixe(cles, valeur);
+        return i < N && cles[i] == valeur ? positions[i] : -1;
+    }
+
+    constexpr bool contient(int valeur) const {
+        return rechercher(valeur) >= 0;
+    }
+};
+
+#endif
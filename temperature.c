@@ -0,0 +1,27 @@
+#include <stdio.h>
+#include "temperature.h"
+
+void convertirFahrenheitQ16(const int32_t *fahrenheit, int32_t *celsius, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        celsius[i] = celsiusDepuisFahrenheitQ16(fahrenheit[i]);
+    }
+}
+
+void convertirFahrenheitEntiers(const int16_t *fahrenheit, int32_t *celsius, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        celsius[i] = celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(fahrenheit[i]));
+    }
+}
+
+size_t temperatureVersTexte(int32_t q16, char *texte, size_t taille) {
+    // Centièmes arrondis à la demi-unité la plus éloignée de zéro,
+    // le signe à part pour que -0.50 ne s'écrive pas 0.50
+    int64_t centiemes = ((int64_t)q16 * 100 + (q16 < 0 ? -32768 : 32768)) / TEMPERATURE_UN_Q16;
+    const char *signe = centiemes < 0 ? "-" : "";
+    if (centiemes < 0) {
+        centiemes = -centiemes;
+    }
+    int longueur = snprintf(texte, taille, "%s%ld.%02d", signe,
+                            (long)(centiemes / 100), (int)(centiemes % 100));
+    return (longueur < 0 || (size_t)longueur >= taille) ? 0 : (size_t)longueur;
+}
@@ -0,0 +1,60 @@
+// Conversion Fahrenheit -> Celsius en virgule fixe Q16.16
+// Sans flottant : une multiplication 32 x 32 -> 64 bits et un décalage,
+// le même nombre de cycles quelle que soit la valeur.
+// Pour les capteurs qui donnent des degrés entiers, temperature_table.hpp
+// construit à la compilation (constexpr) une table de la même formule.
+//
+// Erreur : au plus 5/9 d'unité Q16.16 (0,556 unité, 8,5e-6 °C) par rapport au calcul
+// exact sur tout le domaine. Le résultat exact est un multiple de 1/9 d'unité et l'erreur
+// de 5/9 en Q0.31 le décale de moins de 1/9 (0,004 unité à 1000 °F) : l'arrondi tombe au
+// plus loin à 5/9, et à 4/9 (0,444 unité) tant que |F - 32| < 16384 °F.
+// La version float (fahrenheit - 32) * 5.0f / 9.0f se trompe de quelques ulp, qui
+// grandissent avec la valeur (1,2e-4 °C vers 1000 °C) : les deux versions diffèrent
+// de moins de 2,5e-5 °C de -40 °C à 125 °C (mesuré par bench_temperature).
+
+#ifndef TEMPERATURE_H
+#define TEMPERATURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+#define TEMPERATURE_CONSTEXPR constexpr
+extern "C" {
+#else
+#define TEMPERATURE_CONSTEXPR
+#endif
+
+// Une unité Q16.16 vaut 1/65536 de degré
+#define TEMPERATURE_UN_Q16 65536
+
+// 5/9 en Q0.31, arrondi : 5/9 * 2^31 = 1193046471,1
+#define TEMPERATURE_CINQ_NEUVIEMES_Q31 1193046471
+
+// Degrés entiers -> Q16.16
+static TEMPERATURE_CONSTEXPR inline int32_t temperatureDepuisEntier(int32_t degres) {
+    return (int32_t)((uint32_t)degres << 16);
+}
+
+// Celsius = (Fahrenheit - 32) * 5 / 9, arrondi au plus proche.
+// Domaine : fahrenheitQ16 >= -32736 °F (pour que fahrenheit - 32 tienne sur 32 bits).
+static TEMPERATURE_CONSTEXPR inline int32_t celsiusDepuisFahrenheitQ16(int32_t fahrenheitQ16) {
+    return (int32_t)(((int64_t)(fahrenheitQ16 - 32 * TEMPERATURE_UN_Q16) * TEMPERATURE_CINQ_NEUVIEMES_Q31
+                      + ((int64_t)1 << 30)) >> 31);
+}
+
+// Tableau d'échantillons Q16.16 -> Celsius Q16.16 (celsius peut être fahrenheit)
+void convertirFahrenheitQ16(const int32_t *fahrenheit, int32_t *celsius, size_t n);
+
+// Tableau d'échantillons en degrés entiers -> Celsius Q16.16
+void convertirFahrenheitEntiers(const int16_t *fahrenheit, int32_t *celsius, size_t n);
+
+// Écriture d'une valeur Q16.16 avec deux décimales arrondies ("37.78", "-0.50").
+// Retourne la longueur, 0 si texte est trop petit.
+size_t temperatureVersTexte(int32_t q16, char *texte, size_t taille);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
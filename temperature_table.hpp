@@ -0,0 +1,51 @@
+// Table Fahrenheit -> Celsius construite à la compilation (C++17)
+// Pour un capteur qui donne des degrés entiers dans [Min, Max], la table contient
+// celsiusDepuisFahrenheitQ16 de chaque valeur : même résultat que le calcul Q16.16,
+// une lecture mémoire par échantillon. Les valeurs hors de l'intervalle sont
+// ramenées à ses bornes, le nombre de cycles reste constant.
+//
+//     using Sonde = TableCelsius<-40, 257>;
+//     static_assert(Sonde::celsiusQ16(212) == 100 * TEMPERATURE_UN_Q16, "");
+//     int32_t c = Sonde::celsiusQ16(mesure);
+//
+// La table occupe 4 * (Max - Min + 1) octets en mémoire morte (.rodata).
+
+#ifndef TEMPERATURE_TABLE_HPP
+#define TEMPERATURE_TABLE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "temperature.h"
+
+template <int Min, int Max>
+class TableCelsius {
+    static_assert(Min <= Max, "intervalle vide");
+    static_assert(Min >= -32736 && Max <= 32767, "hors du domaine de celsiusDepuisFahrenheitQ16");
+
+public:
+    static constexpr std::size_t taille = static_cast<std::size_t>(Max - Min + 1);
+
+    static constexpr std::array<std::int32_t, taille> generer() {
+        std::array<std::int32_t, taille> valeurs{};
+        for (std::size_t i = 0; i < taille; i++) {
+            valeurs[i] = celsiusDepuisFahrenheitQ16(temperatureDepuisEntier(Min + static_cast<int>(i)));
+        }
+        return valeurs;
+    }
+
+    static constexpr std::array<std::int32_t, taille> valeurs = generer();
+
+    static constexpr std::int32_t celsiusQ16(int fahrenheit) {
+        return valeurs[static_cast<std::size_t>((fahrenheit < Min ? Min : fahrenheit > Max ? Max : fahrenheit) - Min)];
+    }
+
+    static void convertir(const std::int16_t* fahrenheit, std::int32_t* celsius, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            celsius[i] = celsiusQ16(fahrenheit[i]);
+        }
+    }
+};
+
+#endif
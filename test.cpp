@@ -1,20 +1,20 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            Seance 2
-            exercice 1
------------------------------------*/
-
-#include <iostream>
-#include <string>
-
-using namespace std;
-
-        
-
-int main() {
-    cout << "Hello world*!" << endl;
-    return 0;
-    }
-    
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            Seance 2
+            exercice 1
+-----------------------------------*/
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+        
+
+int main() {
+    cout << "Hello world*!" << endl;
+    return 0;
+    }
+    
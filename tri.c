@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri.h"
+
+// Échanger deux éléments du tableau
+static void echanger(int *a, int *b) {
+    int tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// Tri par insertion d'origine (quadratique)
+void triInsertionSimple(int tableau[], int taille) {
+    int i, j, cle;
+    for (i = 1; i < taille; i++) {
+        cle = tableau[i];
+        j = i - 1;
+
+        // Déplacer les éléments du tableau qui sont plus grands que la clé
+        // vers la droite d'une position
+        while (j >= 0 && tableau[j] > cle) {
+            tableau[j + 1] = tableau[j];
+            j = j - 1;
+        }
+        tableau[j + 1] = cle; // Insérer la clé à sa position correcte
+    }
+}
+
+// Faire descendre l'élément i dans le tas max de taille n
+static void tamiser(int t[], int i, int n) {
+    int valeur = t[i];
+    int fils;
+    while ((fils = 2 * i + 1) < n) {
+        if (fils + 1 < n && t[fils] < t[fils + 1]) {
+            fils++;
+        }
+        if (t[fils] <= valeur) {
+            break;
+        }
+        t[i] = t[fils];
+        i = fils;
+    }
+    t[i] = valeur;
+}
+
+// Tri par tas : utilisé quand l'introsort dégénère
+static void triTas(int t[], int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        tamiser(t, i, n);
+    }
+    for (int fin = n - 1; fin > 0; fin--) {
+        echanger(&t[0], &t[fin]);
+        tamiser(t, 0, fin);
+    }
+}
+
+// Ranger t[a], t[b], t[c] dans l'ordre croissant
+static void trier3(int t[], int a, int b, int c) {
+    if (t[b] < t[a]) echanger(&t[a], &t[b]);
+    if (t[c] < t[b]) echanger(&t[b], &t[c]);
+    if (t[b] < t[a]) echanger(&t[a], &t[b]);
+}
+
+// Introsort : tri rapide avec médiane de trois, bascule sur le tri par tas
+// si la profondeur devient trop grande, et sur l'insertion pour les petits morceaux
+static void introsort(int t[], int n, int profondeur) {
+    while (n > TRI_SEUIL_INSERTION) {
+        if (profondeur == 0) {
+            triTas(t, n);
+            return;
+        }
+        profondeur--;
+
+        // Médiane de trois : t[0] <= pivot <= t[n - 1] servent de sentinelles
+        int milieu = (n - 1) / 2;
+        trier3(t, 0, milieu, n - 1);
+        int pivot = t[milieu];
+
+        // Partition de Hoare : s'arrête sur les égaux, donc équilibrée
+        // même quand il y a beaucoup de doublons
+        int i = -1;
+        int j = n;
+        while (1) {
+            do { i++; } while (t[i] < pivot);
+            do { j--; } while (t[j] > pivot);
+            if (i >= j) break;
+            echanger(&t[i], &t[j]);
+        }
+
+        // Récursion sur la plus petite partie, boucle sur la plus grande
+        int gauche = j + 1;
+        int droite = n - gauche;
+        if (gauche < droite) {
+            introsort(t, gauche, profondeur);
+            t += gauche;
+            n = droite;
+        } else {
+            introsort(t + gauche, droite, profondeur);
+            n = gauche;
+        }
+    }
+    triInsertionSimple(t, n);
+}
+
+#define TRI_RADIX_SEAUX (1u << TRI_RADIX_BITS)
+#define TRI_RADIX_PASSES ((32 + TRI_RADIX_BITS - 1) / TRI_RADIX_BITS)
+
+// Clé non signée dans le même ordre que l'int : bit de signe inversé
+static inline uint32_t cleRadix(int valeur) {
+    return (uint32_t)valeur ^ 0x80000000u;
+}
+
+// Tri par base (LSD) : une lecture du tableau remplit les histogrammes de
+// tous les chiffres, puis une passe stable par chiffre, du poids faible au
+// poids fort, entre tableau et tampon. Un chiffre identique pour tous les
+// éléments ne change pas l'ordre : sa passe est sautée.
+void triRadix(int tableau[], int taille, int tampon[]) {
+    if (taille < 2) {
+        return;
+    }
+    uint32_t comptes[TRI_RADIX_PASSES][TRI_RADIX_SEAUX];
+    memset(comptes, 0, sizeof(comptes));
+    for (int i = 0; i < taille; i++) {
+        uint32_t cle = cleRadix(tableau[i]);
+        for (int p = 0; p < TRI_RADIX_PASSES; p++) {
+            comptes[p][(cle >> (p * TRI_RADIX_BITS)) & (TRI_RADIX_SEAUX - 1)]++;
+        }
+    }
+
+    int *source = tableau, *destination = tampon;
+    for (int p = 0; p < TRI_RADIX_PASSES; p++) {
+        uint32_t *compte = comptes[p];
+        int decalage = p * TRI_RADIX_BITS;
+        if (compte[(cleRadix(source[0]) >> decalage) & (TRI_RADIX_SEAUX - 1)] == (uint32_t)taille) {
+            continue;
+        }
+
+        // Histogramme -> position de départ de chaque seau
+        uint32_t position = 0;
+        for (uint32_t c = 0; c < TRI_RADIX_SEAUX; c++) {
+            uint32_t nb = compte[c];
+            compte[c] = position;
+            position += nb;
+        }
+        for (int i = 0; i < taille; i++) {
+            int valeur = source[i];
+            destination[compte[(cleRadix(valeur) >> decalage) & (TRI_RADIX_SEAUX - 1)]++] = valeur;
+        }
+        int *echange = source;
+        source = destination;
+        destination = echange;
+    }
+    if (source != tableau) {
+        memcpy(tableau, source, (size_t)taille * sizeof(int));
+    }
+}
+
+int triSiMonotone(int tableau[], size_t taille) {
+    // Tableau déjà trié : rien à faire
+    size_t i = 1;
+    while (i < taille && tableau[i - 1] <= tableau[i]) i++;
+    if (i >= taille) {
+        return 1;
+    }
+
+    // Tableau trié à l'envers : il suffit de le retourner
+    i = 1;
+    while (i < taille && tableau[i - 1] >= tableau[i]) i++;
+    if (i == taille) {
+        for (size_t a = 0, b = taille - 1; a < b; a++, b--) {
+            echanger(&tableau[a], &tableau[b]);
+        }
+        return 1;
+    }
+    return 0;
+}
+
+// Fonction pour effectuer le tri (hybride)
+void triInsertion(int tableau[], int taille) {
+    if (taille <= TRI_SEUIL_INSERTION) {
+        triInsertionSimple(tableau, taille);
+        return;
+    }
+
+    if (triSiMonotone(tableau, (size_t)taille)) {
+        return;
+    }
+
+    // Grands tableaux : tri par base, sans comparaison. Sans mémoire pour
+    // le tampon, on garde l'introsort.
+    if (taille >= TRI_SEUIL_RADIX) {
+        int *tampon = malloc((size_t)taille * sizeof(int));
+        if (tampon != NULL) {
+            triRadix(tableau, taille, tampon);
+            free(tampon);
+            return;
+        }
+    }
+
+    // Profondeur maximale : 2 * log2(taille)
+    int profondeur = 0;
+    for (int n = taille; n > 1; n >>= 1) {
+        profondeur += 2;
+    }
+    introsort(tableau, taille, profondeur);
+}
@@ -0,0 +1,48 @@
+// Moteur de tri pour les tableaux d'entiers
+// triInsertion garde sa signature d'origine mais choisit l'algorithme
+// selon la taille : insertion en dessous du seuil, introsort au-dessus,
+// tri par base (radix) pour les grands tableaux.
+
+#ifndef TRI_H
+#define TRI_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// En dessous de ce nombre d'elements, le tri par insertion est le plus rapide
+// (valeur mesuree avec bench_tri.c)
+#define TRI_SEUIL_INSERTION 24
+
+// A partir de ce nombre d'elements, triInsertion passe au tri par base
+// (valeur mesuree avec bench_tri.c)
+#define TRI_SEUIL_RADIX 1024
+
+// Chiffres du tri par base : 11 bits, 3 passes (2 pour des cles sur 16 bits),
+// 24 Kio d'histogrammes ; plus rapide que 8 bits (4 passes) partout au-dessus du seuil
+#define TRI_RADIX_BITS 11
+
+// Tri hybride (insertion + introsort), O(n log n) dans le pire des cas
+void triInsertion(int tableau[], int taille);
+
+// Tri par base LSD des int, stable, O(n) par chiffre ; tampon : taille
+// elements de travail. Appele par triInsertion au-dessus de TRI_SEUIL_RADIX.
+void triRadix(int tableau[], int taille, int tampon[]);
+
+// Cas rapides de triInsertion, en O(n) : retourne 1 si le tableau etait deja
+// trie ou trie a l'envers (il est alors retourne), 0 sinon. Sur des donnees
+// quelconques, le parcours s'arrete a la premiere rupture. Pour les appelants
+// qui trient par base avec leur propre tampon (tri parallele).
+int triSiMonotone(int tableau[], size_t taille);
+
+// Tri par insertion d'origine, O(n^2) : garde pour les petits morceaux
+// et comme reference dans les benchmarks
+void triInsertionSimple(int tableau[], int taille);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
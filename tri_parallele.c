@@ -0,0 +1,255 @@
+#define _POSIX_C_SOURCE 200809L
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tri.h"
+#include "tri_parallele.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define TRI_FILS 1
+#endif
+
+typedef struct {
+    int *tableau;
+    int *tampon;                                // morceaux triés
+    size_t n;
+    int nbMorceaux;
+    size_t bornes[TRI_PARALLELE_FILS_MAX + 1];  // morceau i : tampon[bornes[i]..bornes[i + 1]-1]
+} TriParallele;
+
+typedef struct {
+    TriParallele *tri;
+    int indice;
+} Travail;
+
+// Tête d'un morceau pendant la fusion
+typedef struct {
+    int valeur;
+    int morceau;
+} Tete;
+
+int triNombreProcesseurs(void) {
+#ifdef TRI_FILS
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)(n < INT_MAX ? n : INT_MAX) : 1;
+#else
+    return 1;
+#endif
+}
+
+// Premier indice i tel que t[i] >= valeur (strict : t[i] > valeur)
+static size_t borne(const int *t, size_t n, long long valeur, int strict) {
+    size_t debut = 0;
+    while (n > 0) {
+        size_t moitie = n / 2;
+        long long v = t[debut + moitie];
+        if (v < valeur || (strict && v == valeur)) {
+            debut += moitie + 1;
+            n -= moitie + 1;
+        } else {
+            n = moitie;
+        }
+    }
+    return debut;
+}
+
+// Coupe chaque morceau trié : ses positions[i] premiers éléments, pour tous
+// les morceaux, sont les rang plus petits éléments de l'ensemble. Les égaux
+// sont pris dans l'ordre des morceaux : pour deux rangs a <= b, les positions
+// de a sont toutes <= celles de b, et les parts ne se recouvrent pas.
+static void selectionner(const TriParallele *tri, size_t rang, size_t positions[]) {
+    int m = tri->nbMorceaux;
+    if (rang >= tri->n) {
+        for (int i = 0; i < m; i++) positions[i] = tri->bornes[i + 1] - tri->bornes[i];
+        return;
+    }
+
+    // Plus petite valeur v telle que plus de rang éléments soient <= v :
+    // c'est l'élément de rang rang
+    long long bas = INT_MIN, haut = INT_MAX;
+    while (bas < haut) {
+        long long v = bas + (haut - bas) / 2;
+        size_t compte = 0;
+        for (int i = 0; i < m; i++) {
+            compte += borne(tri->tampon + tri->bornes[i], tri->bornes[i + 1] - tri->bornes[i], v, 1);
+        }
+        if (compte > rang) {
+            haut = v;
+        } else {
+            bas = v + 1;
+        }
+    }
+
+    // Tout ce qui est < v, puis les égaux à v qu'il manque, morceau par morceau
+    size_t pris = 0;
+    for (int i = 0; i < m; i++) {
+        positions[i] = borne(tri->tampon + tri->bornes[i], tri->bornes[i + 1] - tri->bornes[i], bas, 0);
+        pris += positions[i];
+    }
+    size_t reste = rang - pris;
+    for (int i = 0; i < m && reste > 0; i++) {
+        size_t egaux = borne(tri->tampon + tri->bornes[i], tri->bornes[i + 1] - tri->bornes[i], bas, 1) -
+                       positions[i];
+        size_t k = egaux < reste ? egaux : reste;
+        positions[i] += k;
+        reste -= k;
+    }
+}
+
+// Faire descendre la tête i dans le tas min de taille n
+static void tamiserTetes(Tete tas[], int i, int n) {
+    Tete tete = tas[i];
+    int fils;
+    while ((fils = 2 * i + 1) < n) {
+        if (fils + 1 < n && tas[fils + 1].valeur < tas[fils].valeur) {
+            fils++;
+        }
+        if (tete.valeur <= tas[fils].valeur) {
+            break;
+        }
+        tas[i] = tas[fils];
+        i = fils;
+    }
+    tas[i] = tete;
+}
+
+// Phase 1 : recopier le morceau dans le tampon et l'y trier comme
+// triInsertion le ferait à cette taille (au moins TRI_PARALLELE_SEUIL, donc
+// au-dessus de TRI_SEUIL_RADIX) : morceau trié ou à l'envers en O(n), sinon
+// tri par base. Le morceau d'origine, déjà copié et réécrit en phase 2, sert
+// de tampon au tri : pas d'allocation par morceau.
+static void *trierMorceau(void *argument) {
+    const Travail *travail = argument;
+    TriParallele *tri = travail->tri;
+    size_t debut = tri->bornes[travail->indice];
+    size_t taille = tri->bornes[travail->indice + 1] - debut;
+
+    memcpy(tri->tampon + debut, tri->tableau + debut, taille * sizeof(int));
+    if (!triSiMonotone(tri->tampon + debut, taille)) {
+        triRadix(tri->tampon + debut, (int)taille, tri->tableau + debut);
+    }
+    return NULL;
+}
+
+// Phase 2 : fusionner la part indice du résultat
+static void *fusionnerPart(void *argument) {
+    const Travail *travail = argument;
+    TriParallele *tri = travail->tri;
+    int m = tri->nbMorceaux;
+    // Les parts du résultat ont les mêmes bornes que les morceaux
+    size_t premier = tri->bornes[travail->indice];
+    size_t dernier = tri->bornes[travail->indice + 1];
+    size_t debuts[TRI_PARALLELE_FILS_MAX], fins[TRI_PARALLELE_FILS_MAX];
+    const int *lecture[TRI_PARALLELE_FILS_MAX];
+    Tete tas[TRI_PARALLELE_FILS_MAX];
+    int nbTas = 0;
+
+    selectionner(tri, premier, debuts);
+    selectionner(tri, dernier, fins);
+    for (int i = 0; i < m; i++) {
+        lecture[i] = tri->tampon + tri->bornes[i];
+        if (debuts[i] < fins[i]) {
+            tas[nbTas].valeur = lecture[i][debuts[i]];
+            tas[nbTas].morceau = i;
+            nbTas++;
+        }
+    }
+    for (int i = nbTas / 2 - 1; i >= 0; i--) {
+        tamiserTetes(tas, i, nbTas);
+    }
+
+    int *sortie = tri->tableau + premier;
+    while (nbTas > 1) {
+        int i = tas[0].morceau;
+        *sortie++ = tas[0].valeur;
+        if (++debuts[i] < fins[i]) {
+            tas[0].valeur = lecture[i][debuts[i]];
+        } else {
+            tas[0] = tas[--nbTas];
+        }
+        tamiserTetes(tas, 0, nbTas);
+    }
+    // Le dernier morceau restant se recopie d'un bloc
+    if (nbTas == 1) {
+        int i = tas[0].morceau;
+        memcpy(sortie, lecture[i] + debuts[i], (fins[i] - debuts[i]) * sizeof(int));
+    }
+    return NULL;
+}
+
+// Exécute fonction sur chaque travail, un fil par travail ; le fil appelant
+// prend le premier. Si un fil ne peut être créé, son travail est fait ici.
+static void lancer(void *(*fonction)(void *), Travail travaux[], int nb) {
+#ifdef TRI_FILS
+    pthread_t fils[TRI_PARALLELE_FILS_MAX];
+    int cree[TRI_PARALLELE_FILS_MAX];
+    for (int i = 1; i < nb; i++) {
+        cree[i] = pthread_create(&fils[i], NULL, fonction, &travaux[i]) == 0;
+    }
+    fonction(&travaux[0]);
+    for (int i = 1; i < nb; i++) {
+        if (cree[i]) {
+            pthread_join(fils[i], NULL);
+        } else {
+            fonction(&travaux[i]);
+        }
+    }
+#else
+    for (int i = 0; i < nb; i++) {
+        fonction(&travaux[i]);
+    }
+#endif
+}
+
+int triParallele(int tableau[], size_t taille, int nbFils) {
+    // Plus de fils que de processeurs ne ferait que payer la fusion
+    if (nbFils <= 0 || nbFils > triNombreProcesseurs()) {
+        nbFils = triNombreProcesseurs();
+    }
+    if (nbFils > TRI_PARALLELE_FILS_MAX) {
+        nbFils = TRI_PARALLELE_FILS_MAX;
+    }
+    if ((size_t)nbFils > taille / TRI_PARALLELE_SEUIL) {
+        nbFils = (int)(taille / TRI_PARALLELE_SEUIL);
+    }
+    if (nbFils <= 1) {
+        if (taille > INT_MAX) {
+            return -1;
+        }
+        triInsertion(tableau, (int)taille);
+        return 0;
+    }
+    if (taille / (size_t)nbFils >= INT_MAX) {
+        return -1;
+    }
+
+    // Tableau déjà trié ou trié à l'envers : ni tampon ni fusion
+    if (triSiMonotone(tableau, taille)) {
+        return 0;
+    }
+
+    TriParallele tri;
+    tri.tableau = tableau;
+    tri.n = taille;
+    tri.nbMorceaux = nbFils;
+    tri.tampon = malloc(taille * sizeof(int));
+    if (tri.tampon == NULL) {
+        return -1;
+    }
+    Travail travaux[TRI_PARALLELE_FILS_MAX];
+    for (int k = 0; k <= nbFils; k++) {
+        tri.bornes[k] = taille / (size_t)nbFils * (size_t)k + taille % (size_t)nbFils * (size_t)k / (size_t)nbFils;
+    }
+    for (int k = 0; k < nbFils; k++) {
+        travaux[k].tri = &tri;
+        travaux[k].indice = k;
+    }
+
+    lancer(trierMorceau, travaux, nbFils);
+    lancer(fusionnerPart, travaux, nbFils);
+
+    free(tri.tampon);
+    return 0;
+}
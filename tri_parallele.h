@@ -0,0 +1,45 @@
+// Tri parallèle des très grands tableaux d'entiers
+// Le tableau est coupé en un morceau par fil ; chaque fil recopie son morceau
+// dans un tampon de n entiers et le trie comme triInsertion : cas trié ou
+// trié à l'envers en O(n), sinon tri par base (triRadix).
+// Puis chaque fil produit une part égale du résultat : il cherche, dans chacun
+// des morceaux triés, où commence et où finit sa part (sélection sur les
+// valeurs, par recherche binaire), puis fusionne ces sous-suites (fusion à k
+// voies par tas) directement à sa place dans le tableau.
+// Les deux phases sont réparties également entre les fils, sans verrou ni
+// synchronisation autre que l'attente de fin de phase : le temps décroît
+// presque linéairement avec le nombre de cœurs tant que la mémoire suit.
+// Un seul tampon de n entiers est alloué.
+// Sans fils POSIX (cible embarquée), les parts sont traitées l'une après l'autre.
+
+#ifndef TRI_PARALLELE_H
+#define TRI_PARALLELE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Nombre maximal de fils (et de morceaux)
+#define TRI_PARALLELE_FILS_MAX 64
+
+// En dessous de ce nombre d'éléments par fil, on utilise moins de fils :
+// créer un fil et fusionner coûte plus que ce qu'il fait gagner
+// (les tableaux plus petits que ce seuil sont triés par triInsertion)
+#define TRI_PARALLELE_SEUIL 65536
+
+// Nombre de processeurs en ligne (1 si inconnu)
+int triNombreProcesseurs(void);
+
+// Trie tableau[0..taille-1] avec nbFils fils (0 : un par processeur ; jamais
+// plus de fils que de processeurs).
+// Retourne 0, ou -1 si le tampon ne peut être alloué ou si un morceau dépasse
+// INT_MAX éléments (le tableau n'est alors pas modifié).
+int triParallele(int tableau[], size_t taille, int nbFils);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,23 +1,23 @@
-/*-----------------------------------
-            DEMBELE
-            Assimi
-
-            while loop
-            
------------------------------------*/
-#include <stdio.h>
-
-int main() {
-    int i = 1;
-
-    printf("Values of the variable (1 to 100):\n");
-
-    while (i <= 100) {
-        printf("%d ", i);
-        i++;
-    }
-    
-    printf("\n");
-
-    return 0;
-}
+/*-----------------------------------
+            DEMBELE
+            Assimi
+
+            while loop
+            
+-----------------------------------*/
+#include <stdio.h>
+
+int main() {
+    int i = 1;
+
+    printf("Values of the variable (1 to 100):\n");
+
+    while (i <= 100) {
+        printf("%d ", i);
+        i++;
+    }
+    
+    printf("\n");
+
+    return 0;
+}